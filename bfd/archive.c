@@ -158,6 +158,10 @@ struct ar_cache {
 #define ar_maxnamelen(abfd) ((abfd)->xvec->ar_max_namelen)
 
 #define arch_eltdata(bfd) ((struct areltdata *) ((bfd)->arelt_data))
+
+/* The size of the blocks in which member contents are copied when an
+   archive is written.  */
+#define ARCHIVE_COPY_BUFFERSIZE (1024 * 1024)
 #define arch_hdr(bfd) ((struct ar_hdr *) arch_eltdata (bfd)->arch_header)
 
 void
@@ -1921,6 +1925,7 @@ _bfd_write_archive_contents (bfd *arch)
   bfd_size_type wrote;
   int tries;
   char *armag;
+  char *buffer = NULL;
 
   /* Verify the viability of all entries; if any of them live in the
      filesystem (as opposed to living in an archive open for input)
@@ -1998,18 +2003,26 @@ _bfd_write_archive_contents (bfd *arch)
 	}
     }
 
+  /* Copy the members in large blocks; this is where most of the time
+     in rewriting a big archive goes.  */
+  if (! bfd_is_thin_archive (arch))
+    {
+      buffer = (char *) bfd_malloc (ARCHIVE_COPY_BUFFERSIZE);
+      if (buffer == NULL)
+	return FALSE;
+    }
+
   for (current = arch->archive_head;
        current != NULL;
        current = current->archive_next)
     {
-      char buffer[DEFAULT_BUFFERSIZE];
       unsigned int remaining = arelt_size (current);
       struct ar_hdr *hdr = arch_hdr (current);
 
       /* Write ar header.  */
       if (bfd_bwrite (hdr, sizeof (*hdr), arch)
 	  != sizeof (*hdr))
-	return FALSE;
+	goto output_err;
       if (bfd_is_thin_archive (arch))
         continue;
       if (bfd_seek (current, (file_ptr) 0, SEEK_SET) != 0)
@@ -2017,7 +2030,7 @@ _bfd_write_archive_contents (bfd *arch)
 
       while (remaining)
 	{
-	  unsigned int amt = DEFAULT_BUFFERSIZE;
+	  unsigned int amt = ARCHIVE_COPY_BUFFERSIZE;
 
 	  if (amt > remaining)
 	    amt = remaining;
@@ -2029,17 +2042,19 @@ _bfd_write_archive_contents (bfd *arch)
 	      goto input_err;
 	    }
 	  if (bfd_bwrite (buffer, amt, arch) != amt)
-	    return FALSE;
+	    goto output_err;
 	  remaining -= amt;
 	}
 
       if ((arelt_size (current) % 2) == 1)
 	{
 	  if (bfd_bwrite (&ARFMAG[1], 1, arch) != 1)
-	    return FALSE;
+	    goto output_err;
 	}
     }
 
+  free (buffer);
+
   if (makemap && hasobjects)
     {
       /* Verify the timestamp in the archive file.  If it would not be
@@ -2063,10 +2078,115 @@ _bfd_write_archive_contents (bfd *arch)
 
  input_err:
   bfd_set_error (bfd_error_on_input, current, bfd_get_error ());
+ output_err:
+  free (buffer);
   return FALSE;
 }
 
-/* Note that the namidx for the first symbol is 0.  */
+/* An entry of the symbol table of an input archive, and the element
+   it belongs to.  */
+
+struct old_armap_entry
+{
+  file_ptr origin;
+  symindex index;
+};
+
+/* The symbol table of an input archive, sorted by element.  */
+
+struct old_armap
+{
+  bfd *archive;
+  struct old_armap_entry *entries;
+  symindex count;
+};
+
+static int
+old_armap_entry_compare (const void *a, const void *b)
+{
+  const struct old_armap_entry *ea = (const struct old_armap_entry *) a;
+  const struct old_armap_entry *eb = (const struct old_armap_entry *) b;
+
+  if (ea->origin != eb->origin)
+    return ea->origin < eb->origin ? -1 : 1;
+  if (ea->index != eb->index)
+    return ea->index < eb->index ? -1 : 1;
+  return 0;
+}
+
+/* Set up OLD to find the entries of the symbol table of ARCHIVE by
+   element.  Symbols of elements that have not been opened cannot be
+   wanted, and are left out.  */
+
+static bfd_boolean
+read_old_armap (struct old_armap *old, bfd *archive)
+{
+  struct artdata *ardata = bfd_ardata (archive);
+  symindex i;
+
+  free (old->entries);
+  old->archive = archive;
+  old->count = 0;
+  old->entries = (struct old_armap_entry *)
+    bfd_malloc (ardata->symdef_count * sizeof (struct old_armap_entry) + 1);
+  if (old->entries == NULL)
+    return FALSE;
+
+  for (i = 0; i < ardata->symdef_count; i++)
+    {
+      bfd *elt;
+
+      elt = _bfd_look_for_bfd_in_cache (archive,
+					ardata->symdefs[i].file_offset);
+      if (elt != NULL)
+	{
+	  old->entries[old->count].origin = elt->proxy_origin;
+	  old->entries[old->count].index = i;
+	  old->count++;
+	}
+    }
+
+  qsort (old->entries, old->count, sizeof (struct old_armap_entry),
+	 old_armap_entry_compare);
+  return TRUE;
+}
+
+/* Return the first entry of OLD for element ELT, and set *COUNT to
+   the number of them.  */
+
+static struct old_armap_entry *
+find_old_armap_entries (struct old_armap *old, bfd *elt, symindex *count)
+{
+  symindex lo = 0;
+  symindex hi = old->count;
+  symindex end;
+
+  while (lo < hi)
+    {
+      symindex mid = lo + (hi - lo) / 2;
+
+      if (old->entries[mid].origin < (file_ptr) elt->proxy_origin)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+
+  for (end = lo;
+       end < old->count
+	 && old->entries[end].origin == (file_ptr) elt->proxy_origin;
+       end++)
+    ;
+
+  *count = end - lo;
+  return old->entries + lo;
+}
+
+/* Note that the namidx for the first symbol is 0.
+
+   If BFD_ARCHIVE_REUSE_ARMAP is set, the symbols of an element that
+   is copied unchanged from an input archive are taken from the
+   symbol table of that archive, when it has any there.  Other
+   elements have their symbols read.  */
 
 bfd_boolean
 _bfd_compute_and_write_armap (bfd *arch, unsigned int elength)
@@ -2082,6 +2202,11 @@ _bfd_compute_and_write_armap (bfd *arch, unsigned int elength)
   long syms_max = 0;
   bfd_boolean ret;
   bfd_size_type amt;
+  struct old_armap old;
+
+  old.archive = NULL;
+  old.entries = NULL;
+  old.count = 0;
 
   /* Dunno if this is the best place for this info...  */
   if (elength != 0)
@@ -2109,6 +2234,56 @@ _bfd_compute_and_write_armap (bfd *arch, unsigned int elength)
        current != NULL;
        current = current->archive_next, elt_no++)
     {
+      if ((arch->flags & BFD_ARCHIVE_REUSE_ARMAP) != 0
+	  && current->my_archive != NULL
+	  && ! bfd_is_thin_archive (current->my_archive)
+	  && bfd_has_map (current->my_archive))
+	{
+	  struct old_armap_entry *entry;
+	  symindex count;
+
+	  if (old.archive != current->my_archive
+	      && ! read_old_armap (&old, current->my_archive))
+	    goto error_return;
+
+	  entry = find_old_armap_entries (&old, current, &count);
+	  if (count != 0)
+	    {
+	      carsym *symdefs = bfd_ardata (old.archive)->symdefs;
+
+	      if (orl_count + count > orl_max)
+		{
+		  struct orl *new_map;
+
+		  while (orl_count + count > orl_max)
+		    orl_max *= 2;
+		  amt = orl_max * sizeof (struct orl);
+		  new_map = (struct orl *) bfd_realloc (map, amt);
+		  if (new_map == NULL)
+		    goto error_return;
+
+		  map = new_map;
+		}
+
+	      /* The names live on the input archive, which outlives
+		 the writing of this one.  */
+	      for (; count != 0; count--, entry++)
+		{
+		  amt = sizeof (char *);
+		  map[orl_count].name = (char **) bfd_alloc (arch, amt);
+		  if (map[orl_count].name == NULL)
+		    goto error_return;
+		  *(map[orl_count].name) = symdefs[entry->index].name;
+		  map[orl_count].u.abfd = current;
+		  map[orl_count].namidx = stridx;
+
+		  stridx += strlen (symdefs[entry->index].name) + 1;
+		  ++orl_count;
+		}
+	      continue;
+	    }
+	}
+
       if (bfd_check_format (current, bfd_object)
 	  && (bfd_get_file_flags (current) & HAS_SYMS) != 0)
 	{
@@ -2197,6 +2372,7 @@ _bfd_compute_and_write_armap (bfd *arch, unsigned int elength)
     free (syms);
   if (map != NULL)
     free (map);
+  free (old.entries);
   if (first_name != NULL)
     bfd_release (arch, first_name);
 
@@ -2205,6 +2381,7 @@ _bfd_compute_and_write_armap (bfd *arch, unsigned int elength)
  error_return:
   if (syms_max > 0)
     free (syms);
+  free (old.entries);
   if (map != NULL)
     free (map);
   if (first_name != NULL)
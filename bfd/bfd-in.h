@@ -518,6 +518,43 @@ extern bfd_boolean bfd_cache_close
 
 extern bfd_boolean bfd_cache_close_all (void);
 
+/* Counts of file cache activity, for reporting by applications.  */
+
+struct bfd_cache_stats
+{
+  /* The most files the cache keeps open at once.  */
+  int max_open;
+  /* Lookups that found the file open, and ones that had to reopen it.  */
+  unsigned long hits;
+  unsigned long misses;
+  /* Files closed to make room for another.  */
+  unsigned long evictions;
+  /* Files mapped for reading, and reads served from the mappings.  */
+  unsigned long mapped_files;
+  unsigned long mapped_reads;
+};
+
+extern void bfd_cache_get_stats (struct bfd_cache_stats *);
+
+/* Counts of the work done to recognize the format of files whose
+   target was not given, for reporting by applications.  */
+
+struct bfd_format_stats
+{
+  /* Files whose format was looked for among all the targets.  */
+  unsigned long searches;
+  /* Targets asked whether they recognize a file.  */
+  unsigned long probes;
+  /* Targets not asked because the first bytes of the file ruled
+     them out.  */
+  unsigned long skipped;
+  /* Files recognized by the target that recognized a similar file
+     before, without a search.  */
+  unsigned long cache_hits;
+};
+
+extern void bfd_format_get_stats (struct bfd_format_stats *);
+
 extern bfd_boolean bfd_record_phdr
   (bfd *, unsigned long, bfd_boolean, flagword, bfd_boolean, bfd_vma,
    bfd_boolean, bfd_boolean, unsigned int, struct bfd_section **);
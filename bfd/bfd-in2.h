@@ -525,6 +525,43 @@ extern bfd_boolean bfd_cache_close
 
 extern bfd_boolean bfd_cache_close_all (void);
 
+/* Counts of file cache activity, for reporting by applications.  */
+
+struct bfd_cache_stats
+{
+  /* The most files the cache keeps open at once.  */
+  int max_open;
+  /* Lookups that found the file open, and ones that had to reopen it.  */
+  unsigned long hits;
+  unsigned long misses;
+  /* Files closed to make room for another.  */
+  unsigned long evictions;
+  /* Files mapped for reading, and reads served from the mappings.  */
+  unsigned long mapped_files;
+  unsigned long mapped_reads;
+};
+
+extern void bfd_cache_get_stats (struct bfd_cache_stats *);
+
+/* Counts of the work done to recognize the format of files whose
+   target was not given, for reporting by applications.  */
+
+struct bfd_format_stats
+{
+  /* Files whose format was looked for among all the targets.  */
+  unsigned long searches;
+  /* Targets asked whether they recognize a file.  */
+  unsigned long probes;
+  /* Targets not asked because the first bytes of the file ruled
+     them out.  */
+  unsigned long skipped;
+  /* Files recognized by the target that recognized a similar file
+     before, without a search.  */
+  unsigned long cache_hits;
+};
+
+extern void bfd_format_get_stats (struct bfd_format_stats *);
+
 extern bfd_boolean bfd_record_phdr
   (bfd *, unsigned long, bfd_boolean, flagword, bfd_boolean, bfd_vma,
    bfd_boolean, bfd_boolean, unsigned int, struct bfd_section **);
@@ -1731,6 +1768,13 @@ bfd_boolean bfd_get_section_contents
 bfd_boolean bfd_malloc_and_get_section
    (bfd *abfd, asection *section, bfd_byte **buf);
 
+const bfd_byte *bfd_section_contents_view
+   (bfd *abfd, asection *section);
+
+bfd_boolean bfd_map_section_contents
+   (bfd *abfd, asection *section, const bfd_byte **view,
+    bfd_byte **buf);
+
 bfd_boolean bfd_copy_private_section_data
    (bfd *ibfd, asection *isec, bfd *obfd, asection *osec);
 
@@ -4822,6 +4866,10 @@ struct bfd
      state information on the file here...  */
   ufile_ptr where;
 
+  /* If the caching routines have mapped the file for reading, the
+     mapping and the current position in it.  */
+  struct bfd_cache_map *cache_map;
+
   /* File modified time, if mtime_set is TRUE.  */
   long mtime;
 
@@ -4906,6 +4954,12 @@ struct bfd
      will be consistent from run to run.  */
 #define BFD_DETERMINISTIC_OUTPUT 0x4000
 
+  /* This may be set before writing out an archive to allow the
+     archive symbol table entries for members copied unchanged from
+     an input archive to be taken from the symbol table of that
+     archive, instead of reading the symbols of the members again.  */
+#define BFD_ARCHIVE_REUSE_ARMAP 0x8000
+
   /* Currently my_archive is tested before adding origin to
      anything. I believe that this can become always an add of
      origin, with origin set to 0 for non archive files.  */
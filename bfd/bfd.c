@@ -67,6 +67,10 @@ CODE_FRAGMENT
 .     state information on the file here...  *}
 .  ufile_ptr where;
 .
+.  {* If the caching routines have mapped the file for reading, the
+.     mapping and the current position in it.  *}
+.  struct bfd_cache_map *cache_map;
+.
 .  {* File modified time, if mtime_set is TRUE.  *}
 .  long mtime;
 .
@@ -151,6 +155,12 @@ CODE_FRAGMENT
 .     will be consistent from run to run.  *}
 .#define BFD_DETERMINISTIC_OUTPUT 0x4000
 .
+.  {* This may be set before writing out an archive to allow the
+.     archive symbol table entries for members copied unchanged from
+.     an input archive to be taken from the symbol table of that
+.     archive, instead of reading the symbols of the members again.  *}
+.#define BFD_ARCHIVE_REUSE_ARMAP 0x8000
+.
 .  {* Currently my_archive is tested before adding origin to
 .     anything. I believe that this can become always an add of
 .     origin, with origin set to 0 for non archive files.  *}
@@ -30,12 +30,18 @@ SECTION
 	the application to open as many BFDs as it wants without
 	regard to the underlying operating system's file descriptor
 	limit (often as low as 20 open files).  The module in
-	<<cache.c>> maintains a least recently used list of
-	<<BFD_CACHE_MAX_OPEN>> files, and exports the name
-	<<bfd_cache_lookup>>, which runs around and makes sure that
-	the required BFD is open. If not, then it chooses a file to
-	close, closes it and opens the one wanted, returning its file
-	handle.
+	<<cache.c>> maintains a least recently used list of open
+	files, and exports the name <<bfd_cache_lookup>>, which runs
+	around and makes sure that the required BFD is open. If not,
+	then it chooses a file to close, closes it and opens the one
+	wanted, returning its file handle.  The number of files kept
+	open is an eighth of the process's file descriptor limit, but
+	at least ten.
+
+	Where <<mmap>> is available, a file opened only for reading
+	is mapped into memory on its first read, and further reads
+	are copied from the mapping.  A mapped file stays readable
+	when the cache closes its file descriptor.
 
 SUBSECTION
 	Caching functions
@@ -50,6 +56,10 @@ SUBSECTION
 #include <sys/mman.h>
 #endif
 
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
+
 /* In some cases we can optimize cache operation when reopening files.
    For instance, a flush is entirely unnecessary if the file is already
    closed, so a flush would use CACHE_NO_OPEN.  Similarly, a seek using
@@ -66,14 +76,54 @@ enum cache_flag {
 };
 
 /* The maximum number of files which the cache will keep open at
-   one time.  */
+   one time, or zero if not yet worked out.  */
 
-#define BFD_CACHE_MAX_OPEN 10
+static int max_open_files;
 
 /* The number of BFD files we have open.  */
 
 static int open_files;
 
+/* Counts of cache activity.  */
+
+static struct bfd_cache_stats cache_stats;
+
+/* A file mapped for reading.  BASE is NULL if it could not be.  */
+
+struct bfd_cache_map
+{
+  bfd_byte *base;
+  bfd_size_type size;
+  file_ptr pos;
+};
+
+/* Return the maximum number of files to keep open.  Leave most of
+   the process's file descriptors to the application.  */
+
+static int
+bfd_cache_max_open (void)
+{
+  if (max_open_files == 0)
+    {
+      int max = 0;
+
+#ifdef HAVE_GETRLIMIT
+      struct rlimit rlim;
+
+      if (getrlimit (RLIMIT_NOFILE, &rlim) == 0
+	  && rlim.rlim_cur != (rlim_t) RLIM_INFINITY)
+	max = rlim.rlim_cur / 8;
+#endif
+#if defined (HAVE_SYSCONF) && defined (_SC_OPEN_MAX)
+      if (max == 0)
+	max = sysconf (_SC_OPEN_MAX) / 8;
+#endif
+      max_open_files = max < 10 ? 10 : max;
+      cache_stats.max_open = max_open_files;
+    }
+  return max_open_files;
+}
+
 /* Zero, or a pointer to the topmost BFD on the chain.  This is
    used by the <<bfd_cache_lookup>> macro in @file{libbfd.h} to
    determine when it can avoid a function call.  */
@@ -168,7 +218,11 @@ close_one (void)
       return TRUE;
     }
 
-  kill->where = real_ftell ((FILE *) kill->iostream);
+  if (kill->cache_map != NULL && kill->cache_map->base != NULL)
+    kill->where = kill->cache_map->pos;
+  else
+    kill->where = real_ftell ((FILE *) kill->iostream);
+  cache_stats.evictions++;
 
   return bfd_cache_delete (kill);
 }
@@ -180,15 +234,16 @@ close_one (void)
 
 #define bfd_cache_lookup(x, flag) \
   ((x) == bfd_last_cache			\
-   ? (FILE *) (bfd_last_cache->iostream)	\
+   ? (cache_stats.hits++,			\
+      (FILE *) (bfd_last_cache->iostream))	\
    : bfd_cache_lookup_worker (x, flag))
 
 /* Called when the macro <<bfd_cache_lookup>> fails to find a
    quick answer.  Find a file descriptor for @var{abfd}.  If
-   necessary, it open it.  If there are already more than
-   <<BFD_CACHE_MAX_OPEN>> files open, it tries to close one first, to
-   avoid running out of file descriptors.  It will return NULL
-   if it is unable to (re)open the @var{abfd}.  */
+   necessary, it open it.  If there are already as many files open
+   as the cache allows, it tries to close one first, to avoid
+   running out of file descriptors.  It will return NULL if it is
+   unable to (re)open the @var{abfd}.  */
 
 static FILE *
 bfd_cache_lookup_worker (bfd *abfd, enum cache_flag flag)
@@ -208,12 +263,15 @@ bfd_cache_lookup_worker (bfd *abfd, enum cache_flag flag)
 	  snip (abfd);
 	  insert (abfd);
 	}
+      cache_stats.hits++;
       return (FILE *) abfd->iostream;
     }
 
   if (flag & CACHE_NO_OPEN)
     return NULL;
 
+  cache_stats.misses++;
+
   if (bfd_open_file (abfd) == NULL)
     ;
   else if (!(flag & CACHE_NO_SEEK)
@@ -228,10 +286,92 @@ bfd_cache_lookup_worker (bfd *abfd, enum cache_flag flag)
   return NULL;
 }
 
+/* Return the mapping through which ABFD is read, or NULL if it is
+   read through its stream.  If MAP_NOW, try to map a file that has
+   not been tried yet.  */
+
+static struct bfd_cache_map *
+bfd_cache_get_map (bfd *abfd, bfd_boolean map_now)
+{
+  struct bfd_cache_map *map;
+
+  if (abfd->my_archive)
+    abfd = abfd->my_archive;
+
+  map = abfd->cache_map;
+#ifdef HAVE_MMAP
+  if (map == NULL
+      && map_now
+      && abfd->cacheable
+      && abfd->direction == read_direction)
+    {
+      FILE *f;
+      struct stat buf;
+
+      f = bfd_cache_lookup (abfd, CACHE_NORMAL);
+      if (f == NULL)
+	return NULL;
+
+      map = (struct bfd_cache_map *) bfd_zmalloc (sizeof (*map));
+      if (map == NULL)
+	return NULL;
+      abfd->cache_map = map;
+
+      /* Don't use up the address space of a 32-bit host on one file.  */
+      if (fstat (fileno (f), &buf) == 0
+	  && S_ISREG (buf.st_mode)
+	  && buf.st_size > 0
+	  && (sizeof (void *) > 4 || buf.st_size <= 0x10000000))
+	{
+	  void *base = mmap (NULL, buf.st_size, PROT_READ, MAP_PRIVATE,
+			     fileno (f), 0);
+	  if (base != (void *) -1)
+	    {
+	      map->base = (bfd_byte *) base;
+	      map->size = buf.st_size;
+	      map->pos = real_ftell (f);
+	      cache_stats.mapped_files++;
+	    }
+	}
+    }
+#endif
+
+  if (map == NULL || map->base == NULL)
+    return NULL;
+  return map;
+}
+
+/* Unmap ABFD's file, if the cache mapped it.  */
+
+static void
+bfd_cache_unmap (bfd *abfd)
+{
+  struct bfd_cache_map *map = abfd->cache_map;
+
+  if (map == NULL)
+    return;
+
+#ifdef HAVE_MMAP
+  if (map->base != NULL)
+    {
+      abfd->where = map->pos;
+      munmap (map->base, map->size);
+    }
+#endif
+  free (map);
+  abfd->cache_map = NULL;
+}
+
 static file_ptr
 cache_btell (struct bfd *abfd)
 {
-  FILE *f = bfd_cache_lookup (abfd, CACHE_NO_OPEN);
+  struct bfd_cache_map *map = bfd_cache_get_map (abfd, FALSE);
+  FILE *f;
+
+  if (map != NULL)
+    return map->pos;
+
+  f = bfd_cache_lookup (abfd, CACHE_NO_OPEN);
   if (f == NULL)
     return abfd->where;
   return real_ftell (f);
@@ -240,7 +380,25 @@ cache_btell (struct bfd *abfd)
 static int
 cache_bseek (struct bfd *abfd, file_ptr offset, int whence)
 {
-  FILE *f = bfd_cache_lookup (abfd, whence != SEEK_CUR ? CACHE_NO_SEEK : CACHE_NORMAL);
+  struct bfd_cache_map *map = bfd_cache_get_map (abfd, FALSE);
+  FILE *f;
+
+  if (map != NULL)
+    {
+      if (whence == SEEK_CUR)
+	offset += map->pos;
+      else if (whence == SEEK_END)
+	offset += map->size;
+      if (offset < 0)
+	{
+	  errno = EINVAL;
+	  return -1;
+	}
+      map->pos = offset;
+      return 0;
+    }
+
+  f = bfd_cache_lookup (abfd, whence != SEEK_CUR ? CACHE_NO_SEEK : CACHE_NORMAL);
   if (f == NULL)
     return -1;
   return real_fseek (f, offset, whence);
@@ -308,6 +466,27 @@ static file_ptr
 cache_bread (struct bfd *abfd, void *buf, file_ptr nbytes)
 {
   file_ptr nread = 0;
+  struct bfd_cache_map *map;
+
+  if (nbytes == 0)
+    return 0;
+
+  map = bfd_cache_get_map (abfd, TRUE);
+  if (map != NULL)
+    {
+      if (map->pos >= (file_ptr) map->size)
+	nread = 0;
+      else if (nbytes > (file_ptr) map->size - map->pos)
+	nread = map->size - map->pos;
+      else
+	nread = nbytes;
+      memcpy (buf, map->base + map->pos, nread);
+      map->pos += nread;
+      cache_stats.mapped_reads++;
+      if (nread < nbytes)
+	bfd_set_error (bfd_error_file_truncated);
+      return nread;
+    }
 
   /* Some filesystems are unable to handle reads that are too large
      (for instance, NetApp shares with oplocks turned off).  To avoid
@@ -441,7 +620,7 @@ bfd_boolean
 bfd_cache_init (bfd *abfd)
 {
   BFD_ASSERT (abfd->iostream != NULL);
-  if (open_files >= BFD_CACHE_MAX_OPEN)
+  if (open_files >= bfd_cache_max_open ())
     {
       if (! close_one ())
 	return FALSE;
@@ -474,6 +653,8 @@ bfd_cache_close (bfd *abfd)
   if (abfd->iovec != &cache_iovec)
     return TRUE;
 
+  bfd_cache_unmap (abfd);
+
   if (abfd->iostream == NULL)
     /* Previously closed.  */
     return TRUE;
@@ -502,12 +683,108 @@ bfd_cache_close_all ()
 {
   bfd_boolean ret = TRUE;
 
+  /* Files mapped for reading stay mapped, as there may be views of
+     them in use.  */
   while (bfd_last_cache != NULL)
-    ret &= bfd_cache_close (bfd_last_cache);
+    ret &= bfd_cache_delete (bfd_last_cache);
 
   return ret;
 }
 
+/*
+FUNCTION
+	bfd_cache_get_stats
+
+SYNOPSIS
+	void bfd_cache_get_stats (struct bfd_cache_stats *stats);
+
+DESCRIPTION
+	Fill in @var{stats} with counts of the file cache's activity
+	so far.
+*/
+
+void
+bfd_cache_get_stats (struct bfd_cache_stats *stats)
+{
+  bfd_cache_max_open ();
+  *stats = cache_stats;
+}
+
+/*
+INTERNAL_FUNCTION
+	bfd_cache_map_view
+
+SYNOPSIS
+	const bfd_byte *bfd_cache_map_view
+	  (bfd *abfd, file_ptr offset, bfd_size_type size);
+
+DESCRIPTION
+	Return a pointer to the @var{size} bytes at @var{offset} in
+	@var{abfd}, or NULL if the file cache has not been able to map
+	its file.  The pointer stays valid until @var{abfd} is closed.
+*/
+
+const bfd_byte *
+bfd_cache_map_view (bfd *abfd, file_ptr offset, bfd_size_type size)
+{
+  struct bfd_cache_map *map;
+
+  if (abfd->iovec != &cache_iovec
+      || (abfd->flags & BFD_IN_MEMORY) != 0
+      || offset < 0)
+    return NULL;
+
+  /* Stay within an archive element.  */
+  if (abfd->arelt_data != NULL
+      && (size > arelt_size (abfd)
+	  || (bfd_size_type) offset > arelt_size (abfd) - size))
+    return NULL;
+  if (abfd->my_archive)
+    offset += abfd->origin;
+
+  map = bfd_cache_get_map (abfd, TRUE);
+  if (map == NULL
+      || size > map->size
+      || (bfd_size_type) offset > map->size - size)
+    return NULL;
+  return map->base + offset;
+}
+
+/*
+INTERNAL_FUNCTION
+	bfd_cache_shrink
+
+SYNOPSIS
+	bfd_boolean bfd_cache_shrink (void);
+
+DESCRIPTION
+	Called when opening a file has failed.  If that was for lack of
+	file descriptors, the application is using more of them than
+	the cache allowed for, so lower the limit to the number of files
+	the cache has open and close one of them.
+
+RETURNS
+	<<TRUE>> if a file was closed, so that the open may be retried.
+*/
+
+bfd_boolean
+bfd_cache_shrink (void)
+{
+#if defined (EMFILE) && defined (ENFILE)
+  int old_open_files = open_files;
+
+  if ((errno == EMFILE || errno == ENFILE)
+      && open_files > 1
+      && bfd_last_cache != NULL)
+    {
+      max_open_files = open_files - 1;
+      cache_stats.max_open = max_open_files;
+      return close_one () && open_files < old_open_files;
+    }
+#endif
+  return FALSE;
+}
+
 /*
 INTERNAL_FUNCTION
 	bfd_open_file
@@ -528,12 +805,13 @@ bfd_open_file (bfd *abfd)
 {
   abfd->cacheable = TRUE;	/* Allow it to be closed later.  */
 
-  if (open_files >= BFD_CACHE_MAX_OPEN)
+  if (open_files >= bfd_cache_max_open ())
     {
       if (! close_one ())
 	return NULL;
     }
 
+ retry:
   switch (abfd->direction)
     {
     case read_direction:
@@ -583,7 +861,11 @@ bfd_open_file (bfd *abfd)
     }
 
   if (abfd->iostream == NULL)
-    bfd_set_error (bfd_error_system_call);
+    {
+      if (bfd_cache_shrink ())
+	goto retry;
+      bfd_set_error (bfd_error_system_call);
+    }
   else
     {
       if (! bfd_cache_init (abfd))
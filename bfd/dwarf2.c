@@ -169,6 +169,31 @@ struct dwarf2_debug
 #define STASH_INFO_HASH_OFF        0
 #define STASH_INFO_HASH_ON         1
 #define STASH_INFO_HASH_DISABLED   2
+
+  /* Number of comp units read so far.  */
+  unsigned int unit_count;
+
+  /* The address ranges of the comp units read so far, sorted by low
+     address, so that find_line need not try every unit.  Built on
+     demand, and rebuilt once enough units are missing from it.  */
+  struct unit_arange *unit_ranges;
+  unsigned int unit_range_count;
+
+  /* Number of comp units described by unit_ranges.  */
+  unsigned int indexed_unit_count;
+
+  /* Comp units read, or whose ranges have grown, since unit_ranges was
+     built.  These are checked one by one.  */
+  struct comp_unit **unindexed_units;
+  unsigned int unindexed_unit_count;
+  unsigned int unindexed_unit_alloc;
+
+  /* Scratch array of comp units that may contain an address.  */
+  struct comp_unit **candidate_units;
+  unsigned int candidate_unit_alloc;
+
+  /* Set if unit_ranges could not be maintained.  */
+  bfd_boolean unit_index_failed;
 };
 
 struct arange
@@ -178,6 +203,17 @@ struct arange
   bfd_vma high;
 };
 
+/* An entry in the comp unit address index.  MAX_HIGH is the highest
+   HIGH of this and all earlier entries.  */
+
+struct unit_arange
+{
+  bfd_vma low;
+  bfd_vma high;
+  bfd_vma max_high;
+  struct comp_unit *unit;
+};
+
 /* A minimal decoding of DWARF2 compilation units.  We only decode
    what's needed to get to the line number information.  */
 
@@ -255,6 +291,19 @@ struct comp_unit
 
   /* TRUE if symbols are cached in hash table for faster lookup by name.  */
   bfd_boolean cached;
+
+  /* Position of this unit in reading order.  */
+  unsigned int read_order;
+
+  /* TRUE if the ranges of this unit are all in stash->unit_ranges.  */
+  bfd_boolean addr_indexed;
+
+  /* Function lookup table, built on first use.  FUNC_BEST[I] is the
+     function that lookup_address_in_function_table should find for
+     addresses from FUNC_BOUNDS[I] up to FUNC_BOUNDS[I + 1].  */
+  bfd_vma *func_bounds;
+  struct funcinfo **func_best;
+  unsigned int func_bound_count;
 };
 
 /* This data structure holds the information of an abbrev.  */
@@ -920,7 +969,15 @@ struct line_info_table
   char **dirs;
   struct fileinfo* files;
   struct line_info* last_line;  /* largest VMA */
-  struct line_info* lcl_head;   /* local head; used in 'add_line_info' */
+  /* Lines that arrived out of order, most recent first, waiting to
+     be merged into the last_line list by 'sort_line_info'.  */
+  struct line_info* unsorted_lines;
+  unsigned int num_unsorted_lines;
+  /* The lines in increasing VMA order, and their addresses, built on
+     first lookup.  */
+  struct line_info** sorted_lines;
+  bfd_vma* line_addrs;
+  unsigned int num_lines;
 };
 
 /* Remember some information about each function.  If the function is
@@ -970,10 +1027,11 @@ new_line_sorts_after (struct line_info *new_line, struct line_info *line)
 }
 
 
-/* Adds a new entry to the line_info list in the line_info_table, ensuring
-   that the list is sorted.  Note that the line_info list is sorted from
-   highest to lowest VMA (with possible duplicates); that is,
-   line_info->prev_line always accesses an equal or smaller VMA.  */
+/* Adds a new entry to the line_info list in the line_info_table.  Note
+   that the line_info list is sorted from highest to lowest VMA (with
+   possible duplicates); that is, line_info->prev_line always accesses
+   an equal or smaller VMA.  Entries that do not belong at the head of
+   the list are set aside until 'sort_line_info' is called.  */
 
 static void
 add_line_info (struct line_info_table *table,
@@ -1001,18 +1059,13 @@ add_line_info (struct line_info_table *table,
   else
     info->filename = NULL;
 
-  /* Find the correct location for 'info'.  Normally we will receive
-     new line_info data 1) in order and 2) with increasing VMAs.
-     However some compilers break the rules (cf. decode_line_info) and
-     so we include some heuristics for quickly finding the correct
-     location for 'info'. In particular, these heuristics optimize for
-     the common case in which the VMA sequence that we receive is a
-     list of locally sorted VMAs such as
-       p...z a...j  (where a < j < p < z)
-
-     Note: table->lcl_head is used to head an *actual* or *possible*
-     sequence within the list (such as a...j) that is not directly
-     headed by table->last_line
+  /* Normally we will receive new line_info data 1) in order and 2)
+     with increasing VMAs, and 'info' becomes the new head of the list.
+     However some compilers break the rules (cf. decode_line_info), and
+     object files built with -ffunction-sections have a sequence
+     starting at zero for every function.  Inserting those entries one
+     by one takes time quadratic in the size of the table, so they are
+     kept on a separate list and merged in once the table is complete.
 
      Note: we may receive duplicate entries from 'decode_line_info'.  */
 
@@ -1022,8 +1075,6 @@ add_line_info (struct line_info_table *table,
     {
       /* We only keep the last entry with the same address and end
 	 sequence.  See PR ld/4986.  */
-      if (table->lcl_head == table->last_line)
-	table->lcl_head = info;
       info->prev_line = table->last_line->prev_line;
       table->last_line = info;
     }
@@ -1033,39 +1084,98 @@ add_line_info (struct line_info_table *table,
       /* Normal case: add 'info' to the beginning of the list */
       info->prev_line = table->last_line;
       table->last_line = info;
-
-      /* lcl_head: initialize to head a *possible* sequence at the end.  */
-      if (!table->lcl_head)
-	table->lcl_head = info;
     }
-  else if (!new_line_sorts_after (info, table->lcl_head)
-	   && (!table->lcl_head->prev_line
-	       || new_line_sorts_after (info, table->lcl_head->prev_line)))
+  else
     {
-      /* Abnormal but easy: lcl_head is the head of 'info'.  */
-      info->prev_line = table->lcl_head->prev_line;
-      table->lcl_head->prev_line = info;
+      /* Abnormal: 'info' belongs somewhere below the head.  */
+      info->prev_line = table->unsorted_lines;
+      table->unsorted_lines = info;
+      table->num_unsorted_lines++;
     }
-  else
+}
+
+/* An out of order line, and its position on the unsorted_lines list.  */
+
+struct unsorted_line
+{
+  struct line_info *line;
+  unsigned int pos;
+};
+
+/* Sort unsorted_line entries by increasing VMA.  Entries that compare
+   equal keep their order on the unsorted_lines list.  */
+
+static int
+compare_unsorted_lines (const void *a, const void *b)
+{
+  const struct unsorted_line *la = (const struct unsorted_line *) a;
+  const struct unsorted_line *lb = (const struct unsorted_line *) b;
+
+  if (new_line_sorts_after (la->line, lb->line))
+    return 1;
+  if (new_line_sorts_after (lb->line, la->line))
+    return -1;
+  return la->pos < lb->pos ? -1 : la->pos > lb->pos;
+}
+
+/* Merge the lines set aside by 'add_line_info' into the last_line list
+   of TABLE.  The result is the list that inserting each of them in
+   turn would have built: an entry goes below any entries already there
+   that compare equal to it.  Returns FALSE if memory runs out.  */
+
+static bfd_boolean
+sort_line_info (struct line_info_table *table)
+{
+  struct unsorted_line *lines;
+  struct line_info *each_line;
+  struct line_info *sorted;
+  struct line_info **tail;
+  unsigned int count;
+
+  if (table->unsorted_lines == NULL)
+    return TRUE;
+
+  count = table->num_unsorted_lines;
+  lines = (struct unsorted_line *) bfd_malloc (count * sizeof (*lines));
+  if (lines == NULL)
+    return FALSE;
+
+  count = 0;
+  for (each_line = table->unsorted_lines;
+       each_line;
+       each_line = each_line->prev_line)
     {
-      /* Abnormal and hard: Neither 'last_line' nor 'lcl_head' are valid
-	 heads for 'info'.  Reset 'lcl_head'.  */
-      struct line_info* li2 = table->last_line; /* always non-NULL */
-      struct line_info* li1 = li2->prev_line;
+      lines[count].line = each_line;
+      lines[count].pos = count;
+      count++;
+    }
+  qsort (lines, count, sizeof (*lines), compare_unsorted_lines);
 
-      while (li1)
+  /* Walk both lists from the top.  The head entries were added before
+     any out of order entry equal to them, so they stay above those.  */
+  sorted = table->last_line;
+  tail = &table->last_line;
+  while (count != 0)
+    {
+      if (sorted != NULL
+	  && !new_line_sorts_after (lines[count - 1].line, sorted))
 	{
-	  if (!new_line_sorts_after (info, li2)
-	      && new_line_sorts_after (info, li1))
-	    break;
-
-	  li2 = li1; /* always non-NULL */
-	  li1 = li1->prev_line;
+	  *tail = sorted;
+	  tail = &sorted->prev_line;
+	  sorted = sorted->prev_line;
+	}
+      else
+	{
+	  *tail = lines[--count].line;
+	  tail = &(*tail)->prev_line;
 	}
-      table->lcl_head = li2;
-      info->prev_line = table->lcl_head->prev_line;
-      table->lcl_head->prev_line = info;
     }
+  *tail = sorted;
+
+  free (lines);
+  table->unsorted_lines = NULL;
+  table->num_unsorted_lines = 0;
+  return TRUE;
 }
 
 /* Extract a fully qualified filename from a line info table.
@@ -1172,6 +1282,35 @@ arange_add (bfd *abfd, struct arange *first_arange, bfd_vma low_pc, bfd_vma high
   first_arange->next = arange;
 }
 
+/* Note that the address ranges of UNIT are not all in the comp unit
+   address index of STASH.  */
+
+static void
+add_unindexed_unit (struct dwarf2_debug *stash, struct comp_unit *unit)
+{
+  unit->addr_indexed = FALSE;
+  if (stash->unit_index_failed)
+    return;
+
+  if (stash->unindexed_unit_count == stash->unindexed_unit_alloc)
+    {
+      struct comp_unit **tmp;
+      bfd_size_type amt;
+
+      amt = stash->unindexed_unit_alloc * 2 + 16;
+      tmp = (struct comp_unit **)
+	bfd_realloc (stash->unindexed_units, amt * sizeof (*tmp));
+      if (tmp == NULL)
+	{
+	  stash->unit_index_failed = TRUE;
+	  return;
+	}
+      stash->unindexed_units = tmp;
+      stash->unindexed_unit_alloc = amt;
+    }
+  stash->unindexed_units[stash->unindexed_unit_count++] = unit;
+}
+
 /* Decode the line number information for UNIT.  */
 
 static struct line_info_table*
@@ -1205,7 +1344,11 @@ decode_line_info (struct comp_unit *unit, struct dwarf2_debug *stash)
 
   table->files = NULL;
   table->last_line = NULL;
-  table->lcl_head = NULL;
+  table->unsorted_lines = NULL;
+  table->num_unsorted_lines = 0;
+  table->sorted_lines = NULL;
+  table->line_addrs = NULL;
+  table->num_lines = 0;
 
   line_ptr = stash->dwarf_line_buffer + unit->line_offset;
 
@@ -1488,6 +1631,17 @@ decode_line_info (struct comp_unit *unit, struct dwarf2_debug *stash)
 	free (filename);
     }
 
+  if (! sort_line_info (table))
+    {
+      free (table->files);
+      free (table->dirs);
+      return NULL;
+    }
+
+  /* The unit may now have more address ranges.  */
+  if (unit->addr_indexed)
+    add_unindexed_unit (stash, unit);
+
   return table;
 }
 
@@ -1504,11 +1658,59 @@ lookup_address_in_line_info_table (struct line_info_table *table,
   /* Note: table->last_line should be a descendingly sorted list. */
   struct line_info *each_line;
 
-  for (each_line = table->last_line;
-       each_line;
-       each_line = each_line->prev_line)
-    if (addr >= each_line->address)
-      break;
+  if (table->sorted_lines == NULL && table->last_line != NULL)
+    {
+      unsigned int count = 0;
+
+      for (each_line = table->last_line;
+	   each_line;
+	   each_line = each_line->prev_line)
+	count++;
+
+      table->line_addrs = (bfd_vma *)
+	bfd_alloc (table->abfd, count * sizeof (bfd_vma));
+      table->sorted_lines = (struct line_info **)
+	bfd_alloc (table->abfd, count * sizeof (struct line_info *));
+      if (table->sorted_lines != NULL && table->line_addrs != NULL)
+	{
+	  table->num_lines = count;
+	  for (each_line = table->last_line;
+	       each_line;
+	       each_line = each_line->prev_line)
+	    {
+	      --count;
+	      table->sorted_lines[count] = each_line;
+	      table->line_addrs[count] = each_line->address;
+	    }
+	}
+      else
+	table->sorted_lines = NULL;
+    }
+
+  if (table->sorted_lines != NULL)
+    {
+      /* Find the last line at or below ADDR.  This is the line the
+	 list walk below would stop at.  */
+      unsigned int lo = 0;
+      unsigned int hi = table->num_lines;
+
+      while (lo < hi)
+	{
+	  unsigned int mid = lo + (hi - lo) / 2;
+
+	  if (addr >= table->line_addrs[mid])
+	    lo = mid + 1;
+	  else
+	    hi = mid;
+	}
+      each_line = lo != 0 ? table->sorted_lines[lo - 1] : NULL;
+    }
+  else
+    for (each_line = table->last_line;
+	 each_line;
+	 each_line = each_line->prev_line)
+      if (addr >= each_line->address)
+	break;
 
   if (each_line
       && !(each_line->end_sequence || each_line == table->last_line))
@@ -1535,6 +1737,150 @@ read_debug_ranges (struct comp_unit *unit)
 
 /* Function table functions.  */
 
+/* A function address range, used when building the function lookup
+   table.  POS is the position of the range in a walk over the
+   function table.  */
+
+struct func_arange
+{
+  bfd_vma low;
+  bfd_vma high;
+  unsigned int pos;
+  struct funcinfo *func;
+};
+
+static int
+compare_func_arange_low (const void *a, const void *b)
+{
+  const struct func_arange *fa = (const struct func_arange *) a;
+  const struct func_arange *fb = (const struct func_arange *) b;
+
+  if (fa->low != fb->low)
+    return fa->low < fb->low ? -1 : 1;
+  return fa->pos < fb->pos ? -1 : fa->pos > fb->pos;
+}
+
+static int
+compare_vma (const void *a, const void *b)
+{
+  bfd_vma va = *(const bfd_vma *) a;
+  bfd_vma vb = *(const bfd_vma *) b;
+
+  return va < vb ? -1 : va > vb;
+}
+
+/* Build the function lookup table for UNIT.  The bounds of all the
+   function ranges split the address space into pieces, each covered
+   by the same set of ranges.  For each piece, find the function that
+   a walk over the function table would pick, considering the ranges
+   in walk order.  Return FALSE if out of memory.  */
+
+static bfd_boolean
+build_function_lookup_table (struct comp_unit *unit)
+{
+  struct funcinfo *each_func;
+  struct arange *arange;
+  struct func_arange *ranges, **active;
+  bfd_vma *bounds;
+  unsigned int num_ranges, num_bounds, num_active, next, i, j;
+
+  num_ranges = 0;
+  for (each_func = unit->function_table;
+       each_func;
+       each_func = each_func->prev_func)
+    for (arange = &each_func->arange; arange; arange = arange->next)
+      if (arange->low < arange->high)
+	num_ranges++;
+
+  if (num_ranges == 0)
+    return TRUE;
+
+  ranges = (struct func_arange *)
+    bfd_malloc (num_ranges * sizeof (struct func_arange));
+  active = (struct func_arange **)
+    bfd_malloc (num_ranges * sizeof (struct func_arange *));
+  bounds = (bfd_vma *) bfd_alloc (unit->abfd,
+				  2 * num_ranges * sizeof (bfd_vma));
+  if (ranges == NULL || active == NULL || bounds == NULL)
+    {
+      free (ranges);
+      free (active);
+      return FALSE;
+    }
+
+  i = 0;
+  for (each_func = unit->function_table;
+       each_func;
+       each_func = each_func->prev_func)
+    for (arange = &each_func->arange; arange; arange = arange->next)
+      if (arange->low < arange->high)
+	{
+	  ranges[i].low = arange->low;
+	  ranges[i].high = arange->high;
+	  ranges[i].pos = i;
+	  ranges[i].func = each_func;
+	  bounds[2 * i] = arange->low;
+	  bounds[2 * i + 1] = arange->high;
+	  i++;
+	}
+
+  qsort (ranges, num_ranges, sizeof (*ranges), compare_func_arange_low);
+  qsort (bounds, 2 * num_ranges, sizeof (*bounds), compare_vma);
+  num_bounds = 0;
+  for (i = 0; i < 2 * num_ranges; i++)
+    if (num_bounds == 0 || bounds[i] != bounds[num_bounds - 1])
+      bounds[num_bounds++] = bounds[i];
+
+  unit->func_best = (struct funcinfo **)
+    bfd_alloc (unit->abfd, num_bounds * sizeof (struct funcinfo *));
+  if (unit->func_best == NULL)
+    {
+      free (ranges);
+      free (active);
+      return FALSE;
+    }
+
+  /* Sweep over the pieces, keeping the ranges covering the current
+     piece in ACTIVE, in walk order.  */
+  num_active = 0;
+  next = 0;
+  for (i = 0; i < num_bounds; i++)
+    {
+      struct funcinfo *best_fit = NULL;
+      unsigned int k;
+
+      for (j = 0, k = 0; j < num_active; j++)
+	if (active[j]->high > bounds[i])
+	  active[k++] = active[j];
+      num_active = k;
+
+      for (; next < num_ranges && ranges[next].low <= bounds[i]; next++)
+	{
+	  k = num_active;
+	  while (k > 0 && active[k - 1]->pos > ranges[next].pos)
+	    {
+	      active[k] = active[k - 1];
+	      k--;
+	    }
+	  active[k] = &ranges[next];
+	  num_active++;
+	}
+
+      for (j = 0; j < num_active; j++)
+	if (!best_fit
+	    || ((active[j]->high - active[j]->low)
+		< (best_fit->arange.high - best_fit->arange.low)))
+	  best_fit = active[j]->func;
+      unit->func_best[i] = best_fit;
+    }
+
+  free (ranges);
+  free (active);
+  unit->func_bounds = bounds;
+  unit->func_bound_count = num_bounds;
+  return TRUE;
+}
+
 /* If ADDR is within TABLE, set FUNCTIONNAME_PTR, and return TRUE.
    Note that we need to find the function that has the smallest
    range that contains ADDR, to handle inlined functions without
@@ -1550,22 +1896,47 @@ lookup_address_in_function_table (struct comp_unit *unit,
   struct funcinfo* best_fit = NULL;
   struct arange *arange;
 
-  for (each_func = unit->function_table;
-       each_func;
-       each_func = each_func->prev_func)
+  if (unit->func_bounds == NULL
+      && unit->function_table != NULL
+      && build_function_lookup_table (unit)
+      && unit->func_bounds == NULL)
+    /* No function has a non-empty range.  */
+    return FALSE;
+
+  if (unit->func_bounds != NULL)
     {
-      for (arange = &each_func->arange;
-	   arange;
-	   arange = arange->next)
+      unsigned int lo = 0;
+      unsigned int hi = unit->func_bound_count;
+
+      while (lo < hi)
 	{
-	  if (addr >= arange->low && addr < arange->high)
-	    {
-	      if (!best_fit ||
-		  ((arange->high - arange->low) < (best_fit->arange.high - best_fit->arange.low)))
-		best_fit = each_func;
-	    }
+	  unsigned int mid = lo + (hi - lo) / 2;
+
+	  if (addr >= unit->func_bounds[mid])
+	    lo = mid + 1;
+	  else
+	    hi = mid;
 	}
+      if (lo != 0)
+	best_fit = unit->func_best[lo - 1];
     }
+  else
+    for (each_func = unit->function_table;
+	 each_func;
+	 each_func = each_func->prev_func)
+      {
+	for (arange = &each_func->arange;
+	     arange;
+	     arange = arange->next)
+	  {
+	    if (addr >= arange->low && addr < arange->high)
+	      {
+		if (!best_fit ||
+		    ((arange->high - arange->low) < (best_fit->arange.high - best_fit->arange.low)))
+		  best_fit = each_func;
+	      }
+	  }
+      }
 
   if (best_fit)
     {
@@ -2181,6 +2552,167 @@ comp_unit_contains_address (struct comp_unit *unit, bfd_vma addr)
   return FALSE;
 }
 
+static int
+compare_unit_arange_low (const void *a, const void *b)
+{
+  const struct unit_arange *ua = (const struct unit_arange *) a;
+  const struct unit_arange *ub = (const struct unit_arange *) b;
+
+  if (ua->low != ub->low)
+    return ua->low < ub->low ? -1 : 1;
+  return 0;
+}
+
+/* Build the address index of all the comp units read so far.  */
+
+static bfd_boolean
+build_unit_index (struct dwarf2_debug *stash)
+{
+  struct comp_unit *each;
+  struct arange *arange;
+  struct unit_arange *ranges;
+  unsigned int count, i;
+  bfd_vma max_high;
+
+  count = 0;
+  for (each = stash->all_comp_units; each; each = each->next_unit)
+    for (arange = &each->arange; arange; arange = arange->next)
+      if (arange->low < arange->high)
+	count++;
+
+  ranges = (struct unit_arange *)
+    bfd_realloc (stash->unit_ranges, (count + 1) * sizeof (*ranges));
+  if (ranges == NULL)
+    return FALSE;
+  stash->unit_ranges = ranges;
+
+  i = 0;
+  for (each = stash->all_comp_units; each; each = each->next_unit)
+    {
+      for (arange = &each->arange; arange; arange = arange->next)
+	if (arange->low < arange->high)
+	  {
+	    ranges[i].low = arange->low;
+	    ranges[i].high = arange->high;
+	    ranges[i].unit = each;
+	    i++;
+	  }
+      each->addr_indexed = TRUE;
+    }
+
+  qsort (ranges, count, sizeof (*ranges), compare_unit_arange_low);
+  max_high = 0;
+  for (i = 0; i < count; i++)
+    {
+      if (ranges[i].high > max_high)
+	max_high = ranges[i].high;
+      ranges[i].max_high = max_high;
+    }
+
+  stash->unit_range_count = count;
+  stash->indexed_unit_count = stash->unit_count;
+  stash->unindexed_unit_count = 0;
+  return TRUE;
+}
+
+/* Add UNIT to the candidate units in STASH, which are kept sorted in
+   the order of the all_comp_units list, latest read unit first.  */
+
+static bfd_boolean
+add_candidate_unit (struct dwarf2_debug *stash,
+		    struct comp_unit *unit,
+		    unsigned int *count)
+{
+  unsigned int i;
+
+  if (*count == stash->candidate_unit_alloc)
+    {
+      struct comp_unit **tmp;
+      bfd_size_type amt;
+
+      amt = stash->candidate_unit_alloc * 2 + 16;
+      tmp = (struct comp_unit **)
+	bfd_realloc (stash->candidate_units, amt * sizeof (*tmp));
+      if (tmp == NULL)
+	return FALSE;
+      stash->candidate_units = tmp;
+      stash->candidate_unit_alloc = amt;
+    }
+
+  for (i = *count; i > 0; i--)
+    {
+      struct comp_unit *prev = stash->candidate_units[i - 1];
+
+      if (prev == unit)
+	return TRUE;
+      if (prev->read_order > unit->read_order)
+	break;
+    }
+  memmove (stash->candidate_units + i + 1, stash->candidate_units + i,
+	   (*count - i) * sizeof (*stash->candidate_units));
+  stash->candidate_units[i] = unit;
+  ++*count;
+  return TRUE;
+}
+
+/* Find the comp units read so far that may contain ADDR, in the
+   order they appear on the all_comp_units list, and store them in
+   STASH->candidate_units.  Return the number of units found, or -1
+   if the address index can't be used.  */
+
+static int
+find_candidate_units (struct dwarf2_debug *stash, bfd_vma addr)
+{
+  unsigned int count = 0;
+  unsigned int lo, hi, i;
+
+  if (stash->unit_index_failed)
+    return -1;
+
+  /* Rebuild the index once a good number of units are missing from
+     it, so that looking through the missing units stays cheap.  */
+  if (stash->unit_ranges == NULL
+      || stash->unindexed_unit_count > 16 + stash->indexed_unit_count / 8)
+    {
+      if (!build_unit_index (stash))
+	{
+	  stash->unit_index_failed = TRUE;
+	  return -1;
+	}
+    }
+
+  /* Find the last range starting at or below ADDR.  Ranges before it
+     may still contain ADDR, as long as some range up to there ends
+     above ADDR.  */
+  lo = 0;
+  hi = stash->unit_range_count;
+  while (lo < hi)
+    {
+      unsigned int mid = lo + (hi - lo) / 2;
+
+      if (addr >= stash->unit_ranges[mid].low)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+  for (i = lo; i > 0 && stash->unit_ranges[i - 1].max_high > addr; i--)
+    {
+      struct unit_arange *range = &stash->unit_ranges[i - 1];
+
+      if (range->high > addr
+	  && range->unit->addr_indexed
+	  && !add_candidate_unit (stash, range->unit, &count))
+	return -1;
+    }
+
+  for (i = 0; i < stash->unindexed_unit_count; i++)
+    if (comp_unit_contains_address (stash->unindexed_units[i], addr)
+	&& !add_candidate_unit (stash, stash->unindexed_units[i], &count))
+      return -1;
+
+  return count;
+}
+
 /* If UNIT contains ADDR, set the output parameters to the values for
    the line containing ADDR.  The output parameters, FILENAME_PTR,
    FUNCTIONNAME_PTR, and LINENUMBER_PTR, are pointers to the objects
@@ -3051,17 +3583,40 @@ find_line (bfd *abfd,
     }
   else
     {
-      for (each = stash->all_comp_units; each; each = each->next_unit)
+      int count = -1;
+
+      if (stash->all_comp_units)
+	count = find_candidate_units (stash, addr);
+
+      if (count >= 0)
 	{
-	  found = (comp_unit_contains_address (each, addr)
-		   && comp_unit_find_nearest_line (each, addr,
-						   filename_ptr,
-						   functionname_ptr,
-						   linenumber_ptr,
-						   stash));
-	  if (found)
-	    goto done;
+	  int i;
+
+	  for (i = 0; i < count; i++)
+	    {
+	      each = stash->candidate_units[i];
+	      found = (comp_unit_contains_address (each, addr)
+		       && comp_unit_find_nearest_line (each, addr,
+						       filename_ptr,
+						       functionname_ptr,
+						       linenumber_ptr,
+						       stash));
+	      if (found)
+		goto done;
+	    }
 	}
+      else
+	for (each = stash->all_comp_units; each; each = each->next_unit)
+	  {
+	    found = (comp_unit_contains_address (each, addr)
+		     && comp_unit_find_nearest_line (each, addr,
+						     filename_ptr,
+						     functionname_ptr,
+						     linenumber_ptr,
+						     stash));
+	    if (found)
+	      goto done;
+	  }
     }
 
   /* The DWARF2 spec says that the initial length field, and the
@@ -3130,6 +3685,8 @@ find_line (bfd *abfd,
 	  
 	  each->next_unit = stash->all_comp_units;
 	  stash->all_comp_units = each;
+	  each->read_order = stash->unit_count++;
+	  add_unindexed_unit (stash, each);
 	  
 	  /* DW_AT_low_pc and DW_AT_high_pc are optional for
 	     compilation units.  If we don't have them (i.e.,
@@ -3311,4 +3868,10 @@ _bfd_dwarf2_cleanup_debug_info (bfd *abfd)
     free (stash->dwarf_ranges_buffer);
   if (stash->info_ptr_memory)
     free (stash->info_ptr_memory);
+  if (stash->unit_ranges)
+    free (stash->unit_ranges);
+  if (stash->unindexed_units)
+    free (stash->unindexed_units);
+  if (stash->candidate_units)
+    free (stash->candidate_units);
 }
@@ -895,6 +895,19 @@ struct elf_backend_data
      asection *input_section, bfd_byte *contents, Elf_Internal_Rela *relocs,
      Elf_Internal_Sym *local_syms, asection **local_sections);
 
+  /* The RELOCATE_SECTION_AHEAD function is called when the linker may
+     use threads, for an input section SEC with relocs RELOCS.  It
+     returns TRUE if RELOCATE_SECTION may relocate SEC on another
+     thread, before the sections linked ahead of SEC.  That is the
+     case when RELOCATE_SECTION writes to nothing but its CONTENTS and
+     RELOCS, reads nothing that linking other input files may change,
+     reads no file, and reports problems only through the link
+     callbacks and _bfd_error_handler.  If this function is NULL,
+     sections are only relocated in order.  */
+  bfd_boolean (*elf_backend_relocate_section_ahead)
+    (bfd *output_bfd, struct bfd_link_info *info, asection *sec,
+     Elf_Internal_Rela *relocs);
+
   /* The FINISH_DYNAMIC_SYMBOL function is called by the ELF backend
      linker just before it writes a symbol out to the .dynsym section.
      The processor backend may make any required adjustment to the
@@ -449,7 +449,8 @@ _bfd_elf_parse_eh_frame (bfd *abfd, struct bfd_link_info *info,
       goto free_no_table;				\
   while (0)
 
-  bfd_byte *ehbuf = NULL, *buf, *end;
+  bfd_byte *ehbuf = NULL, *ehalloc = NULL, *buf, *end;
+  const bfd_byte *ehview;
   bfd_byte *last_fde;
   struct eh_cie_fde *this_inf;
   unsigned int hdr_length, hdr_id;
@@ -481,16 +482,19 @@ _bfd_elf_parse_eh_frame (bfd *abfd, struct bfd_link_info *info,
       return;
     }
 
-  /* Read the frame unwind information from abfd.  */
+  /* Read the frame unwind information from abfd.  It is only read
+     here, so a view of the file will do.  */
 
-  REQUIRE (bfd_malloc_and_get_section (abfd, sec, &ehbuf));
+  REQUIRE (bfd_map_section_contents (abfd, sec, &ehview, &ehalloc));
+  ehbuf = (bfd_byte *) ehview;
 
   if (sec->size >= 4
       && bfd_get_32 (abfd, ehbuf) == 0
       && cookie->rel == cookie->relend)
     {
       /* Empty .eh_frame section.  */
-      free (ehbuf);
+      if (ehalloc)
+	free (ehalloc);
       return;
     }
 
@@ -888,8 +892,8 @@ _bfd_elf_parse_eh_frame (bfd *abfd, struct bfd_link_info *info,
   if (sec_info)
     free (sec_info);
  success:
-  if (ehbuf)
-    free (ehbuf);
+  if (ehalloc)
+    free (ehalloc);
   if (local_cies)
     free (local_cies);
 #undef REQUIRE
@@ -260,30 +260,6 @@ _bfd_elf_strtab_emit (register bfd *abfd, struct elf_strtab_hash *tab)
   return TRUE;
 }
 
-/* Compare two elf_strtab_hash_entry structures.  Called via qsort.  */
-
-static int
-strrevcmp (const void *a, const void *b)
-{
-  struct elf_strtab_hash_entry *A = *(struct elf_strtab_hash_entry **) a;
-  struct elf_strtab_hash_entry *B = *(struct elf_strtab_hash_entry **) b;
-  unsigned int lenA = A->len;
-  unsigned int lenB = B->len;
-  const unsigned char *s = (const unsigned char *) A->root.string + lenA - 1;
-  const unsigned char *t = (const unsigned char *) B->root.string + lenB - 1;
-  int l = lenA < lenB ? lenA : lenB;
-
-  while (l)
-    {
-      if (*s != *t)
-	return (int) *s - (int) *t;
-      s--;
-      t--;
-      l--;
-    }
-  return lenA - lenB;
-}
-
 static inline int
 is_suffix (const struct elf_strtab_hash_entry *A,
 	   const struct elf_strtab_hash_entry *B)
@@ -303,7 +279,8 @@ is_suffix (const struct elf_strtab_hash_entry *A,
 void
 _bfd_elf_strtab_finalize (struct elf_strtab_hash *tab)
 {
-  struct elf_strtab_hash_entry **array, **a, *e;
+  struct bfd_suffix_sort_key *array, *k;
+  struct elf_strtab_hash_entry *e;
   bfd_size_type size, amt;
 
   /* GCC 2.91.66 (egcs-1.1.2) on i386 miscompiles this function when i is
@@ -313,28 +290,31 @@ _bfd_elf_strtab_finalize (struct elf_strtab_hash *tab)
   size_t i;
 
   /* Sort the strings by suffix and length.  */
-  amt = tab->size * sizeof (struct elf_strtab_hash_entry *);
-  array = (struct elf_strtab_hash_entry **) bfd_malloc (amt);
+  amt = tab->size * sizeof (struct bfd_suffix_sort_key);
+  array = (struct bfd_suffix_sort_key *) bfd_malloc (amt);
   if (array == NULL)
     goto alloc_failure;
 
-  for (i = 1, a = array; i < tab->size; ++i)
+  for (i = 1, k = array; i < tab->size; ++i)
     {
       e = tab->array[i];
       if (e->refcount)
 	{
-	  *a++ = e;
 	  /* Adjust the length to not include the zero terminator.  */
 	  e->len -= 1;
+	  k->end = (const unsigned char *) e->root.string + e->len;
+	  k->len = e->len;
+	  k->entry = e;
+	  k++;
 	}
       else
 	e->len = 0;
     }
 
-  size = a - array;
+  size = k - array;
   if (size != 0)
     {
-      qsort (array, size, sizeof (struct elf_strtab_hash_entry *), strrevcmp);
+      _bfd_sort_string_suffixes (array, size);
 
       /* Loop over the sorted array and merge suffixes.  Start from the
 	 end because we want eg.
@@ -350,11 +330,11 @@ _bfd_elf_strtab_finalize (struct elf_strtab_hash *tab)
 	 s1 _______^
 
 	 ie. we don't want s1 pointing into the old s2.  */
-      e = *--a;
+      e = (--k)->entry;
       e->len += 1;
-      while (--a >= array)
+      while (--k >= array)
 	{
-	  struct elf_strtab_hash_entry *cmp = *a;
+	  struct elf_strtab_hash_entry *cmp = k->entry;
 
 	  cmp->len += 1;
 	  if (is_suffix (e, cmp))
@@ -20,6 +20,7 @@
 
 #include "sysdep.h"
 #include "libiberty.h"
+#include "hashtab.h"
 #include "bfd.h"
 #include "bfdlink.h"
 #include "libbfd.h"
@@ -338,6 +339,27 @@ struct spu_link_hash_table
   /* Pointer to the fixup section */
   asection *sfixup;
 
+  /* Call graph edges, hashed on caller and callee.  */
+  htab_t call_hash;
+
+  /* Incremented on each insert_callee.  */
+  unsigned int call_seq;
+
+  /* Call graph statistics, printed for --stats.  */
+  struct
+  {
+    unsigned int functions;
+    unsigned int calls;
+    unsigned int merged_calls;
+    unsigned int broken_cycles;
+    unsigned int recursive_groups;
+    long discover_time;
+    long build_time;
+    long cycle_time;
+    long stack_time;
+    long overlay_time;
+  } cg_stats;
+
   /* Set on error.  */
   unsigned int stub_err : 1;
 };
@@ -362,8 +384,13 @@ struct call_info
 {
   struct function_info *fun;
   struct call_info *next;
+  /* The function making the call.  Key for the call hash table,
+     along with FUN.  */
+  struct function_info *caller;
   unsigned int count;
   unsigned int max_depth;
+  /* When this call was last added by insert_callee.  */
+  unsigned int seq;
   unsigned int is_tail : 1;
   unsigned int is_pasted : 1;
   unsigned int broken_cycle : 1;
@@ -399,6 +426,10 @@ struct function_info
   /* Distance from root of call tree.  Tail and hot/cold branches
      count as one deeper.  We aren't counting stack frames here.  */
   unsigned int depth;
+  /* Visit order and lowest reachable visit order, used to find
+     strongly connected components in remove_cycles.  */
+  unsigned int dfs_num;
+  unsigned int dfs_low;
   /* Set if global symbol.  */
   unsigned int global : 1;
   /* Set if known to be start of function (as distinct from a hunk
@@ -408,7 +439,6 @@ struct function_info
   unsigned int non_root : 1;
   /* Flags used during call tree traversal.  It's cheaper to replicate
      the visit flags than have one which needs clearing after a traversal.  */
-  unsigned int visit1 : 1;
   unsigned int visit2 : 1;
   unsigned int marking : 1;
   unsigned int visit3 : 1;
@@ -416,6 +446,10 @@ struct function_info
   unsigned int visit5 : 1;
   unsigned int visit6 : 1;
   unsigned int visit7 : 1;
+  /* Set while on the remove_cycles component stack.  */
+  unsigned int on_scc_stack : 1;
+  /* Set if call_list is entered in the call hash table.  */
+  unsigned int calls_hashed : 1;
 };
 
 struct spu_elf_stack_info
@@ -459,6 +493,18 @@ spu_elf_link_hash_table_create (bfd *abfd)
   return &htab->elf.root;
 }
 
+/* Free an SPU ELF linker hash table.  */
+
+static void
+spu_elf_link_hash_table_free (struct bfd_link_hash_table *hash)
+{
+  struct spu_link_hash_table *htab = (struct spu_link_hash_table *) hash;
+
+  if (htab->call_hash != NULL)
+    htab_delete (htab->call_hash);
+  _bfd_generic_link_hash_table_free (hash);
+}
+
 void
 spu_elf_setup (struct bfd_link_info *info, struct spu_elf_params *params)
 {
@@ -2586,50 +2632,239 @@ find_function (asection *sec, bfd_vma offset, struct bfd_link_info *info)
   return NULL;
 }
 
-/* Add CALLEE to CALLER call list if not already present.  Return TRUE
-   if CALLEE was new.  If this function return FALSE, CALLEE should
-   be freed.  */
+/* Hash and compare calls by caller and callee.  */
+
+static hashval_t
+hash_call (const void *p)
+{
+  const struct call_info *call = p;
+
+  return ((hashval_t) ((size_t) call->caller >> 3) * 31
+	  + (hashval_t) ((size_t) call->fun >> 3));
+}
+
+static int
+eq_call (const void *p1, const void *p2)
+{
+  const struct call_info *c1 = p1;
+  const struct call_info *c2 = p2;
+
+  return c1->caller == c2->caller && c1->fun == c2->fun;
+}
+
+/* Call lists up to this length are searched, longer ones are entered
+   in the call hash table.  Short lists are faster to search than
+   hash lookups, which miss the cache on large programs.  */
+#define CALL_HASH_MIN 32
+
+/* Enter all of CALLER's calls in the call hash table.  */
 
 static bfd_boolean
-insert_callee (struct function_info *caller, struct call_info *callee)
+hash_call_list (htab_t call_hash, struct function_info *caller)
 {
-  struct call_info **pp, *p;
+  struct call_info *call;
 
-  for (pp = &caller->call_list; (p = *pp) != NULL; pp = &p->next)
-    if (p->fun == callee->fun)
-      {
-	/* Tail calls use less stack than normal calls.  Retain entry
-	   for normal call over one for tail call.  */
-	p->is_tail &= callee->is_tail;
-	if (!p->is_tail)
-	  {
-	    p->fun->start = NULL;
-	    p->fun->is_func = TRUE;
-	  }
-	p->count += callee->count;
-	/* Reorder list so most recent call is first.  */
-	*pp = p->next;
-	p->next = caller->call_list;
-	caller->call_list = p;
+  for (call = caller->call_list; call != NULL; call = call->next)
+    {
+      void **slot = htab_find_slot (call_hash, call, INSERT);
+
+      if (slot == NULL)
 	return FALSE;
-      }
+      *slot = call;
+    }
+  caller->calls_hashed = TRUE;
+  return TRUE;
+}
+
+/* Remove CALL from the call hash table, if there.  */
+
+static void
+unhash_call (htab_t call_hash, struct call_info *call)
+{
+  if (call->caller->calls_hashed)
+    htab_remove_elt (call_hash, call);
+}
+
+/* Return CALLER's call to FUN, or NULL if none.  */
+
+static struct call_info *
+find_callee (htab_t call_hash,
+	     struct function_info *caller,
+	     struct function_info *fun)
+{
+  struct call_info key, *p;
+
+  if (caller->calls_hashed)
+    {
+      key.caller = caller;
+      key.fun = fun;
+      return htab_find (call_hash, &key);
+    }
+
+  for (p = caller->call_list; p != NULL; p = p->next)
+    if (p->fun == fun)
+      break;
+  return p;
+}
+
+/* Add CALLEE to CALLER call list if not already present.  Return 1
+   if CALLEE was new, 0 if it was merged with an existing call, in
+   which case CALLEE should be freed, or -1 on error.
+
+   Call lists are kept with the most recently inserted call first.
+   For hashed lists we don't move an existing call to the front here
+   but update its sequence number instead.  sort_call_list restores
+   the order.  */
+
+static int
+insert_callee (struct bfd_link_info *info,
+	       struct function_info *caller,
+	       struct call_info *callee)
+{
+  struct spu_link_hash_table *htab = spu_hash_table (info);
+  struct call_info **pp, *p;
+  unsigned int count;
+  void **slot;
+
+  callee->caller = caller;
+  callee->seq = ++htab->call_seq;
+  if (!caller->calls_hashed)
+    {
+      count = 0;
+      for (pp = &caller->call_list; (p = *pp) != NULL; pp = &p->next)
+	{
+	  if (p->fun == callee->fun)
+	    {
+	      /* Reorder list so most recent call is first.  */
+	      *pp = p->next;
+	      p->next = caller->call_list;
+	      caller->call_list = p;
+	      break;
+	    }
+	  count += 1;
+	}
+      if (p == NULL
+	  && count + 1 >= CALL_HASH_MIN
+	  && !hash_call_list (htab->call_hash, caller))
+	return -1;
+    }
+  else
+    p = find_callee (htab->call_hash, caller, callee->fun);
+
+  if (p != NULL)
+    {
+      /* Tail calls use less stack than normal calls.  Retain entry
+	 for normal call over one for tail call.  */
+      p->is_tail &= callee->is_tail;
+      if (!p->is_tail)
+	{
+	  p->fun->start = NULL;
+	  p->fun->is_func = TRUE;
+	}
+      p->count += callee->count;
+      p->seq = callee->seq;
+      htab->cg_stats.merged_calls += 1;
+      return 0;
+    }
+
+  if (caller->calls_hashed)
+    {
+      slot = htab_find_slot (htab->call_hash, callee, INSERT);
+      if (slot == NULL)
+	return -1;
+      *slot = callee;
+    }
   callee->next = caller->call_list;
   caller->call_list = callee;
-  return TRUE;
+  return 1;
 }
 
 /* Copy CALL and insert the copy into CALLER.  */
 
 static bfd_boolean
-copy_callee (struct function_info *caller, const struct call_info *call)
+copy_callee (struct bfd_link_info *info,
+	     struct function_info *caller,
+	     const struct call_info *call)
 {
   struct call_info *callee;
+  int ret;
+
   callee = bfd_malloc (sizeof (*callee));
   if (callee == NULL)
     return FALSE;
   *callee = *call;
-  if (!insert_callee (caller, callee))
+  ret = insert_callee (info, caller, callee);
+  if (ret <= 0)
     free (callee);
+  return ret >= 0;
+}
+
+/* Free all calls made by FUN.  */
+
+static void
+free_call_list (struct bfd_link_info *info, struct function_info *fun)
+{
+  htab_t call_hash = spu_hash_table (info)->call_hash;
+  struct call_info *call;
+
+  while ((call = fun->call_list) != NULL)
+    {
+      fun->call_list = call->next;
+      unhash_call (call_hash, call);
+      free (call);
+    }
+  fun->calls_hashed = FALSE;
+}
+
+/* qsort predicate to sort calls by sequence number, latest first.  */
+
+static int
+sort_calls_by_seq (const void *a, const void *b)
+{
+  struct call_info *const *c1 = a;
+  struct call_info *const *c2 = b;
+
+  return (*c1)->seq < (*c2)->seq ? 1 : -1;
+}
+
+/* Put the calls made by FUN in order of most recent insert_callee.  */
+
+static bfd_boolean
+sort_call_list (struct function_info *fun,
+		struct bfd_link_info *info ATTRIBUTE_UNUSED,
+		void *param ATTRIBUTE_UNUSED)
+{
+  struct call_info *call, **calls;
+  unsigned int count;
+  bfd_boolean sorted;
+
+  sorted = TRUE;
+  for (count = 0, call = fun->call_list; call != NULL; call = call->next)
+    {
+      if (call->next != NULL && call->next->seq > call->seq)
+	sorted = FALSE;
+      count += 1;
+    }
+  if (sorted)
+    return TRUE;
+
+  calls = bfd_malloc (count * sizeof (*calls));
+  if (calls == NULL)
+    return FALSE;
+
+  for (count = 0, call = fun->call_list; call != NULL; call = call->next)
+    calls[count++] = call;
+
+  qsort (calls, count, sizeof (*calls), sort_calls_by_seq);
+
+  fun->call_list = NULL;
+  while (count != 0)
+    {
+      --count;
+      calls[count]->next = fun->call_list;
+      fun->call_list = calls[count];
+    }
+  free (calls);
   return TRUE;
 }
 
@@ -2659,6 +2894,7 @@ mark_functions_via_relocs (asection *sec,
   Elf_Internal_Rela *internal_relocs, *irelaend, *irela;
   Elf_Internal_Shdr *symtab_hdr;
   void *psyms;
+  bfd_byte *contents = NULL;
   unsigned int priority = 0;
   static bfd_boolean warned;
 
@@ -2686,13 +2922,14 @@ mark_functions_via_relocs (asection *sec,
       bfd_boolean nonbranch, is_call;
       struct function_info *caller;
       struct call_info *callee;
+      int ret;
 
       r_type = ELF32_R_TYPE (irela->r_info);
       nonbranch = r_type != R_SPU_REL16 && r_type != R_SPU_ADDR16;
 
       r_indx = ELF32_R_SYM (irela->r_info);
       if (!get_sym_h (&h, &sym, &sym_sec, psyms, r_indx, sec->owner))
-	return FALSE;
+	goto fail;
 
       if (sym_sec == NULL
 	  || sym_sec->output_section == bfd_abs_section_ptr)
@@ -2701,11 +2938,18 @@ mark_functions_via_relocs (asection *sec,
       is_call = FALSE;
       if (!nonbranch)
 	{
-	  unsigned char insn[4];
+	  unsigned char *insn;
 
-	  if (!bfd_get_section_contents (sec->owner, sec, insn,
-					 irela->r_offset, 4))
-	    return FALSE;
+	  /* Read the whole section once rather than each insn.  */
+	  if (contents == NULL
+	      && !bfd_malloc_and_get_section (sec->owner, sec, &contents))
+	    goto fail;
+	  if (irela->r_offset + 4 > sec->size)
+	    {
+	      bfd_set_error (bfd_error_bad_value);
+	      goto fail;
+	    }
+	  insn = contents + irela->r_offset;
 	  if (is_branch (insn))
 	    {
 	      is_call = (insn[0] & 0xfd) == 0x31;
@@ -2776,7 +3020,7 @@ mark_functions_via_relocs (asection *sec,
 	    {
 	      Elf_Internal_Sym *fake = bfd_zmalloc (sizeof (*fake));
 	      if (fake == NULL)
-		return FALSE;
+		goto fail;
 	      fake->st_value = val;
 	      fake->st_shndx
 		= _bfd_elf_section_from_bfd_section (sym_sec->owner, sym_sec);
@@ -2787,7 +3031,7 @@ mark_functions_via_relocs (asection *sec,
 	  else
 	    fun = maybe_insert_function (sym_sec, h, TRUE, is_call);
 	  if (fun == NULL)
-	    return FALSE;
+	    goto fail;
 	  if (irela->r_addend != 0
 	      && fun->u.sym != sym)
 	    free (sym);
@@ -2796,14 +3040,17 @@ mark_functions_via_relocs (asection *sec,
 
       caller = find_function (sec, irela->r_offset, info);
       if (caller == NULL)
-	return FALSE;
+	goto fail;
       callee = bfd_malloc (sizeof *callee);
       if (callee == NULL)
-	return FALSE;
+	goto fail;
 
       callee->fun = find_function (sym_sec, val, info);
       if (callee->fun == NULL)
-	return FALSE;
+	{
+	  free (callee);
+	  goto fail;
+	}
       callee->is_tail = !is_call;
       callee->is_pasted = FALSE;
       callee->broken_cycle = FALSE;
@@ -2814,7 +3061,13 @@ mark_functions_via_relocs (asection *sec,
 	  callee->fun->last_caller = sec;
 	  callee->fun->call_count += 1;
 	}
-      if (!insert_callee (caller, callee))
+      ret = insert_callee (info, caller, callee);
+      if (ret < 0)
+	{
+	  free (callee);
+	  goto fail;
+	}
+      if (ret == 0)
 	free (callee);
       else if (!is_call
 	       && !callee->fun->is_func
@@ -2858,14 +3111,21 @@ mark_functions_via_relocs (asection *sec,
 	}
     }
 
+  if (contents != NULL)
+    free (contents);
   return TRUE;
+
+ fail:
+  if (contents != NULL)
+    free (contents);
+  return FALSE;
 }
 
 /* Handle something like .init or .fini, which has a piece of a function.
    These sections are pasted together to form a single function.  */
 
 static bfd_boolean
-pasted_function (asection *sec)
+pasted_function (asection *sec, struct bfd_link_info *info)
 {
   struct bfd_link_order *l;
   struct _spu_elf_section_data *sec_data;
@@ -2893,6 +3153,8 @@ pasted_function (asection *sec)
 	  if (fun_start != NULL)
 	    {
 	      struct call_info *callee = bfd_malloc (sizeof *callee);
+	      int ret;
+
 	      if (callee == NULL)
 		return FALSE;
 
@@ -2903,9 +3165,10 @@ pasted_function (asection *sec)
 	      callee->broken_cycle = FALSE;
 	      callee->priority = 0;
 	      callee->count = 1;
-	      if (!insert_callee (fun_start, callee))
+	      ret = insert_callee (info, fun_start, callee);
+	      if (ret <= 0)
 		free (callee);
-	      return TRUE;
+	      return ret >= 0;
 	    }
 	  break;
 	}
@@ -2921,6 +3184,42 @@ pasted_function (asection *sec)
   return TRUE;
 }
 
+/* Free function info and call graph left by an earlier analysis.  */
+
+static void
+free_stack_info (struct bfd_link_info *info)
+{
+  struct spu_link_hash_table *htab = spu_hash_table (info);
+  bfd *ibfd;
+
+  for (ibfd = info->input_bfds; ibfd != NULL; ibfd = ibfd->link_next)
+    {
+      extern const bfd_target bfd_elf32_spu_vec;
+      asection *sec;
+
+      if (ibfd->xvec != &bfd_elf32_spu_vec)
+	continue;
+
+      for (sec = ibfd->sections; sec != NULL; sec = sec->next)
+	{
+	  struct _spu_elf_section_data *sec_data;
+	  struct spu_elf_stack_info *sinfo;
+
+	  if ((sec_data = spu_elf_section_data (sec)) != NULL
+	      && (sinfo = sec_data->u.i.stack_info) != NULL)
+	    {
+	      int i;
+	      for (i = 0; i < sinfo->num_fun; ++i)
+		free_call_list (info, &sinfo->fun[i]);
+	      free (sinfo);
+	      sec_data->u.i.stack_info = NULL;
+	    }
+	}
+    }
+  htab->call_seq = 0;
+  memset (&htab->cg_stats, 0, sizeof (htab->cg_stats));
+}
+
 /* Map address ranges in code sections to functions.  */
 
 static bfd_boolean
@@ -2931,6 +3230,18 @@ discover_functions (struct bfd_link_info *info)
   Elf_Internal_Sym ***psym_arr;
   asection ***sec_arr;
   bfd_boolean gaps = FALSE;
+  struct spu_link_hash_table *htab = spu_hash_table (info);
+  long start_time = get_run_time ();
+
+  /* --auto-overlay followed by --stack-analysis runs this twice.  */
+  if (htab->call_hash != NULL)
+    free_stack_info (info);
+  else
+    {
+      htab->call_hash = htab_try_create (1024, hash_call, eq_call, NULL);
+      if (htab->call_hash == NULL)
+	return FALSE;
+    }
 
   bfd_idx = 0;
   for (ibfd = info->input_bfds; ibfd != NULL; ibfd = ibfd->link_next)
@@ -3141,7 +3452,7 @@ discover_functions (struct bfd_link_info *info)
 		  }
 		/* No symbols in this section.  Must be .init or .fini
 		   or something similar.  */
-		else if (!pasted_function (sec))
+		else if (!pasted_function (sec, info))
 		  return FALSE;
 	      }
 	}
@@ -3161,6 +3472,7 @@ discover_functions (struct bfd_link_info *info)
   free (psym_arr);
   free (sec_arr);
 
+  htab->cg_stats.discover_time = get_run_time () - start_time;
   return TRUE;
 }
 
@@ -3210,24 +3522,31 @@ for_each_node (bfd_boolean (*doit) (struct function_info *,
 
 static bfd_boolean
 transfer_calls (struct function_info *fun,
-		struct bfd_link_info *info ATTRIBUTE_UNUSED,
+		struct bfd_link_info *info,
 		void *param ATTRIBUTE_UNUSED)
 {
   struct function_info *start = fun->start;
 
   if (start != NULL)
     {
+      htab_t call_hash = spu_hash_table (info)->call_hash;
       struct call_info *call, *call_next;
+      int ret;
 
       while (start->start != NULL)
 	start = start->start;
       for (call = fun->call_list; call != NULL; call = call_next)
 	{
 	  call_next = call->next;
-	  if (!insert_callee (start, call))
+	  unhash_call (call_hash, call);
+	  ret = insert_callee (info, start, call);
+	  if (ret < 0)
+	    return FALSE;
+	  if (ret == 0)
 	    free (call);
 	}
       fun->call_list = NULL;
+      fun->calls_hashed = FALSE;
     }
   return TRUE;
 }
@@ -3241,64 +3560,159 @@ mark_non_root (struct function_info *fun,
 {
   struct call_info *call;
 
-  if (fun->visit1)
-    return TRUE;
-  fun->visit1 = TRUE;
   for (call = fun->call_list; call; call = call->next)
-    {
-      call->fun->non_root = TRUE;
-      mark_non_root (call->fun, 0, 0);
-    }
+    call->fun->non_root = TRUE;
   return TRUE;
 }
 
-/* Remove cycles from the call graph.  Set depth of nodes.  */
+/* Count nodes in the call graph.  */
 
 static bfd_boolean
-remove_cycles (struct function_info *fun,
-	       struct bfd_link_info *info,
-	       void *param)
+count_functions (struct function_info *fun ATTRIBUTE_UNUSED,
+		 struct bfd_link_info *info ATTRIBUTE_UNUSED,
+		 void *param)
 {
-  struct call_info **callp, *call;
-  unsigned int depth = *(unsigned int *) param;
-  unsigned int max_depth = depth;
+  *(unsigned int *) param += 1;
+  return TRUE;
+}
+
+/* A node on the remove_cycles search path.  */
+
+struct _rc_frame
+{
+  struct function_info *fun;
+  /* Next call to look at.  */
+  struct call_info *call;
+  /* Where to store the maximum depth found below FUN.  */
+  unsigned int *depthp;
+  unsigned int max_depth;
+  /* Set if FUN calls itself.  */
+  unsigned int self_call : 1;
+};
+
+struct _rc_param
+{
+  /* Depth of the next root node.  */
+  unsigned int depth;
+  /* Number of nodes visited.  */
+  unsigned int dfs_num;
+  /* The search path, and nodes not yet assigned to a strongly
+     connected component.  Both sized for every node in the graph.  */
+  struct _rc_frame *frames;
+  unsigned int num_frames;
+  struct function_info **scc;
+  unsigned int num_scc;
+};
+
+/* Start visiting FUN in remove_cycles.  *DEPTHP is its depth.  */
+
+static void
+rc_enter (struct _rc_param *rc,
+	  struct function_info *fun,
+	  unsigned int *depthp)
+{
+  struct _rc_frame *f = &rc->frames[rc->num_frames++];
 
-  fun->depth = depth;
+  fun->depth = *depthp;
   fun->visit2 = TRUE;
   fun->marking = TRUE;
+  fun->dfs_num = fun->dfs_low = ++rc->dfs_num;
+  fun->on_scc_stack = TRUE;
+  rc->scc[rc->num_scc++] = fun;
+
+  f->fun = fun;
+  f->call = fun->call_list;
+  f->depthp = depthp;
+  f->max_depth = fun->depth;
+  f->self_call = 0;
+}
+
+/* Remove cycles from the call graph.  Set depth of nodes.  This is a
+   depth-first search from ROOT that breaks calls back to a function
+   on the current search path, and which finds groups of mutually
+   recursive functions (the strongly connected components of the
+   graph) by Tarjan's algorithm along the way.  */
+
+static bfd_boolean
+remove_cycles (struct function_info *root,
+	       struct bfd_link_info *info,
+	       void *param)
+{
+  struct spu_link_hash_table *htab = spu_hash_table (info);
+  struct _rc_param *rc = param;
 
-  callp = &fun->call_list;
-  while ((call = *callp) != NULL)
+  rc_enter (rc, root, &rc->depth);
+  while (rc->num_frames != 0)
     {
-      call->max_depth = depth + !call->is_pasted;
-      if (!call->fun->visit2)
+      struct _rc_frame *f = &rc->frames[rc->num_frames - 1];
+      struct function_info *fun = f->fun;
+      struct call_info *call = f->call;
+
+      if (call != NULL)
 	{
-	  if (!remove_cycles (call->fun, info, &call->max_depth))
-	    return FALSE;
-	  if (max_depth < call->max_depth)
-	    max_depth = call->max_depth;
+	  f->call = call->next;
+	  htab->cg_stats.calls += 1;
+	  call->max_depth = fun->depth + !call->is_pasted;
+	  if (!call->fun->visit2)
+	    {
+	      rc_enter (rc, call->fun, &call->max_depth);
+	      continue;
+	    }
+
+	  if (call->fun->marking)
+	    {
+	      if (!htab->params->auto_overlay
+		  && htab->params->stack_analysis)
+		{
+		  const char *f1 = func_name (fun);
+		  const char *f2 = func_name (call->fun);
+
+		  info->callbacks->info (_("Stack analysis will ignore the call "
+					   "from %s to %s\n"),
+					 f1, f2);
+		}
+
+	      call->broken_cycle = TRUE;
+	      htab->cg_stats.broken_cycles += 1;
+	      if (call->fun == fun)
+		f->self_call = 1;
+	    }
+	  if (call->fun->on_scc_stack
+	      && fun->dfs_low > call->fun->dfs_num)
+	    fun->dfs_low = call->fun->dfs_num;
+	  continue;
 	}
-      else if (call->fun->marking)
+
+      /* All calls from FUN have been visited.  */
+      fun->marking = FALSE;
+      *f->depthp = f->max_depth;
+      if (fun->dfs_low == fun->dfs_num)
 	{
-	  struct spu_link_hash_table *htab = spu_hash_table (info);
+	  struct function_info *member;
+	  unsigned int size = 0;
 
-	  if (!htab->params->auto_overlay
-	      && htab->params->stack_analysis)
+	  do
 	    {
-	      const char *f1 = func_name (fun);
-	      const char *f2 = func_name (call->fun);
-
-	      info->callbacks->info (_("Stack analysis will ignore the call "
-				       "from %s to %s\n"),
-				     f1, f2);
+	      member = rc->scc[--rc->num_scc];
+	      member->on_scc_stack = FALSE;
+	      size += 1;
 	    }
+	  while (member != fun);
+	  if (size > 1 || f->self_call)
+	    htab->cg_stats.recursive_groups += 1;
+	}
+
+      rc->num_frames -= 1;
+      if (rc->num_frames != 0)
+	{
+	  struct _rc_frame *caller = f - 1;
 
-	  call->broken_cycle = TRUE;
+	  if (caller->max_depth < *f->depthp)
+	    caller->max_depth = *f->depthp;
+	  if (caller->fun->dfs_low > fun->dfs_low)
+	    caller->fun->dfs_low = fun->dfs_low;
 	}
-      callp = &call->next;
     }
-  fun->marking = FALSE;
-  *(unsigned int *) param = max_depth;
   return TRUE;
 }
 
@@ -3315,7 +3729,7 @@ mark_detached_root (struct function_info *fun,
   if (fun->visit2)
     return TRUE;
   fun->non_root = FALSE;
-  *(unsigned int *) param = 0;
+  ((struct _rc_param *) param)->depth = 0;
   return remove_cycles (fun, info, param);
 }
 
@@ -3324,9 +3738,14 @@ mark_detached_root (struct function_info *fun,
 static bfd_boolean
 build_call_tree (struct bfd_link_info *info)
 {
+  struct spu_link_hash_table *htab = spu_hash_table (info);
   bfd *ibfd;
-  unsigned int depth;
+  struct _rc_param rc;
+  unsigned int num_fun;
+  long start_time;
+  bfd_boolean ret;
 
+  start_time = get_run_time ();
   for (ibfd = info->input_bfds; ibfd != NULL; ibfd = ibfd->link_next)
     {
       extern const bfd_target bfd_elf32_spu_vec;
@@ -3340,23 +3759,46 @@ build_call_tree (struct bfd_link_info *info)
 	  return FALSE;
     }
 
+  if (!for_each_node (sort_call_list, info, 0, FALSE))
+    return FALSE;
+
   /* Transfer call info from hot/cold section part of function
      to main entry.  */
-  if (!spu_hash_table (info)->params->auto_overlay
-      && !for_each_node (transfer_calls, info, 0, FALSE))
+  if (!htab->params->auto_overlay
+      && (!for_each_node (transfer_calls, info, 0, FALSE)
+	  || !for_each_node (sort_call_list, info, 0, FALSE)))
     return FALSE;
 
   /* Find the call graph root(s).  */
   if (!for_each_node (mark_non_root, info, 0, FALSE))
     return FALSE;
+  htab->cg_stats.build_time = get_run_time () - start_time;
+
+  start_time = get_run_time ();
+  num_fun = 0;
+  if (!for_each_node (count_functions, info, &num_fun, FALSE))
+    return FALSE;
+  htab->cg_stats.functions = num_fun;
+
+  memset (&rc, 0, sizeof (rc));
+  rc.frames = bfd_malloc (num_fun * sizeof (*rc.frames));
+  rc.scc = bfd_malloc (num_fun * sizeof (*rc.scc));
+  if (num_fun != 0 && (rc.frames == NULL || rc.scc == NULL))
+    {
+      free (rc.frames);
+      free (rc.scc);
+      return FALSE;
+    }
 
   /* Remove cycles from the call graph.  We start from the root node(s)
      so that we break cycles in a reasonable place.  */
-  depth = 0;
-  if (!for_each_node (remove_cycles, info, &depth, TRUE))
-    return FALSE;
+  ret = (for_each_node (remove_cycles, info, &rc, TRUE)
+	 && for_each_node (mark_detached_root, info, &rc, FALSE));
 
-  return for_each_node (mark_detached_root, info, &depth, FALSE);
+  free (rc.frames);
+  free (rc.scc);
+  htab->cg_stats.cycle_time = get_run_time () - start_time;
+  return ret;
 }
 
 /* qsort predicate to sort calls by priority, max_depth then count.  */
@@ -3759,11 +4201,8 @@ auto_ovl_lib_functions (struct bfd_link_info *info, unsigned int lib_size)
 	    for (call = sinfo->fun[k].call_list; call; call = call->next)
 	      if (call->fun->sec->linker_mark)
 		{
-		  struct call_info *p;
-		  for (p = dummy_caller.call_list; p; p = p->next)
-		    if (p->fun == call->fun)
-		      break;
-		  if (!p)
+		  if (find_callee (htab->call_hash, &dummy_caller,
+				   call->fun) == NULL)
 		    stub_size += ovl_stub_size (htab->params);
 		}
 	}
@@ -3784,6 +4223,7 @@ auto_ovl_lib_functions (struct bfd_link_info *info, unsigned int lib_size)
 	      {
 		lib_size += ovl_stub_size (htab->params);
 		*pp = p->next;
+		unhash_call (htab->call_hash, p);
 		free (p);
 	      }
 	    else
@@ -3799,25 +4239,13 @@ auto_ovl_lib_functions (struct bfd_link_info *info, unsigned int lib_size)
 		for (call = sinfo->fun[k].call_list;
 		     call;
 		     call = call->next)
-		  if (call->fun->sec->linker_mark)
-		    {
-		      struct call_info *callee;
-		      callee = bfd_malloc (sizeof (*callee));
-		      if (callee == NULL)
-			return (unsigned int) -1;
-		      *callee = *call;
-		      if (!insert_callee (&dummy_caller, callee))
-			free (callee);
-		    }
+		  if (call->fun->sec->linker_mark
+		      && !copy_callee (info, &dummy_caller, call))
+		    return (unsigned int) -1;
 	    }
 	}
     }
-  while (dummy_caller.call_list != NULL)
-    {
-      struct call_info *call = dummy_caller.call_list;
-      dummy_caller.call_list = call->next;
-      free (call);
-    }
+  free_call_list (info, &dummy_caller);
   for (i = 0; i < 2 * lib_count; i++)
     if (lib_sections[i])
       lib_sections[i]->gc_mark = 1;
@@ -3912,56 +4340,43 @@ collect_overlays (struct function_info *fun,
   return TRUE;
 }
 
+/* A node on the sum_stack search path.  */
+
+struct _ss_frame
+{
+  struct function_info *fun;
+  /* Next call to look at.  */
+  struct call_info *call;
+  /* Called function needing the most stack so far.  */
+  struct function_info *max;
+  size_t cum_stack;
+  bfd_boolean has_call;
+};
+
 struct _sum_stack_param {
   size_t cum_stack;
   size_t overall_stack;
   bfd_boolean emit_stack_syms;
+  /* Search path, allocated on first use.  Free after for_each_node.  */
+  struct _ss_frame *frames;
 };
 
-/* Descend the call graph for FUN, accumulating total stack required.  */
+/* Called from sum_stack when the total stack required by all
+   functions called from F->fun is known.  */
 
 static bfd_boolean
-sum_stack (struct function_info *fun,
-	   struct bfd_link_info *info,
-	   void *param)
+sum_stack_finish (struct _ss_frame *f,
+		  struct bfd_link_info *info,
+		  struct _sum_stack_param *sum_stack_param)
 {
+  struct function_info *fun = f->fun;
+  struct function_info *max = f->max;
   struct call_info *call;
-  struct function_info *max;
   size_t stack, cum_stack;
   const char *f1;
-  bfd_boolean has_call;
-  struct _sum_stack_param *sum_stack_param = param;
   struct spu_link_hash_table *htab;
 
-  cum_stack = fun->stack;
-  sum_stack_param->cum_stack = cum_stack;
-  if (fun->visit3)
-    return TRUE;
-
-  has_call = FALSE;
-  max = NULL;
-  for (call = fun->call_list; call; call = call->next)
-    {
-      if (call->broken_cycle)
-	continue;
-      if (!call->is_pasted)
-	has_call = TRUE;
-      if (!sum_stack (call->fun, info, sum_stack_param))
-	return FALSE;
-      stack = sum_stack_param->cum_stack;
-      /* Include caller stack for normal calls, don't do so for
-	 tail calls.  fun->stack here is local stack usage for
-	 this function.  */
-      if (!call->is_tail || call->is_pasted || call->fun->start != NULL)
-	stack += fun->stack;
-      if (cum_stack < stack)
-	{
-	  cum_stack = stack;
-	  max = call->fun;
-	}
-    }
-
-  sum_stack_param->cum_stack = cum_stack;
+  cum_stack = f->cum_stack;
   stack = fun->stack;
   /* Now fun->stack holds cumulative stack.  */
   fun->stack = cum_stack;
@@ -3983,7 +4398,7 @@ sum_stack (struct function_info *fun,
       info->callbacks->minfo (_("%s: 0x%v 0x%v\n"),
 			      f1, (bfd_vma) stack, (bfd_vma) cum_stack);
 
-      if (has_call)
+      if (f->has_call)
 	{
 	  info->callbacks->minfo (_("  calls:\n"));
 	  for (call = fun->call_list; call; call = call->next)
@@ -4034,6 +4449,101 @@ sum_stack (struct function_info *fun,
   return TRUE;
 }
 
+/* Descend the call graph for FUN, accumulating total stack required.
+   Functions are finished callees first, so the cumulative stack of
+   each function is calculated once and then reused by all callers.  */
+
+static bfd_boolean
+sum_stack (struct function_info *fun,
+	   struct bfd_link_info *info,
+	   void *param)
+{
+  struct _sum_stack_param *sum_stack_param = param;
+  unsigned int max_frames = spu_hash_table (info)->cg_stats.functions;
+  struct _ss_frame *frames, *f;
+  unsigned int num_frames;
+
+  if (fun->visit3)
+    {
+      sum_stack_param->cum_stack = fun->stack;
+      return TRUE;
+    }
+
+  frames = sum_stack_param->frames;
+  if (frames == NULL)
+    {
+      frames = bfd_malloc (max_frames * sizeof (*frames));
+      if (frames == NULL)
+	return FALSE;
+      sum_stack_param->frames = frames;
+    }
+
+  f = &frames[0];
+  f->fun = fun;
+  f->call = fun->call_list;
+  f->max = NULL;
+  f->cum_stack = fun->stack;
+  f->has_call = FALSE;
+  num_frames = 1;
+  while (num_frames != 0)
+    {
+      struct call_info *call;
+      size_t stack;
+
+      f = &frames[num_frames - 1];
+      call = f->call;
+      if (call == NULL)
+	{
+	  if (!sum_stack_finish (f, info, sum_stack_param))
+	    return FALSE;
+	  num_frames -= 1;
+	  continue;
+	}
+
+      if (call->broken_cycle)
+	{
+	  f->call = call->next;
+	  continue;
+	}
+
+      if (!call->fun->visit3)
+	{
+	  /* remove_cycles should have left an acyclic graph.  */
+	  if (num_frames == max_frames)
+	    {
+	      bfd_set_error (bfd_error_bad_value);
+	      return FALSE;
+	    }
+	  f = &frames[num_frames++];
+	  f->fun = call->fun;
+	  f->call = call->fun->call_list;
+	  f->max = NULL;
+	  f->cum_stack = call->fun->stack;
+	  f->has_call = FALSE;
+	  continue;
+	}
+
+      if (!call->is_pasted)
+	f->has_call = TRUE;
+      f->call = call->next;
+
+      /* Include caller stack for normal calls, don't do so for
+	 tail calls.  f->fun->stack here is local stack usage for
+	 this function.  */
+      stack = call->fun->stack;
+      if (!call->is_tail || call->is_pasted || call->fun->start != NULL)
+	stack += f->fun->stack;
+      if (f->cum_stack < stack)
+	{
+	  f->cum_stack = stack;
+	  f->max = call->fun;
+	}
+    }
+
+  sum_stack_param->cum_stack = fun->stack;
+  return TRUE;
+}
+
 /* SEC is part of a pasted function.  Return the call_info for the
    next section of this function.  */
 
@@ -4053,6 +4563,41 @@ find_pasted_call (asection *sec)
   return 0;
 }
 
+/* Print call graph statistics for --stats.  */
+
+static void
+print_call_graph_stats (struct bfd_link_info *info)
+{
+  struct spu_link_hash_table *htab = spu_hash_table (info);
+  char buf[200];
+
+  if (!htab->params->stats)
+    return;
+
+  info->callbacks->einfo (_("%P: call graph: %u functions, %u calls, "
+			    "%u merged calls, %u broken cycles, "
+			    "%u recursive groups\n"),
+			  htab->cg_stats.functions,
+			  htab->cg_stats.calls,
+			  htab->cg_stats.merged_calls,
+			  htab->cg_stats.broken_cycles,
+			  htab->cg_stats.recursive_groups);
+  /* einfo has no field widths, so format the times here.  */
+  sprintf (buf, "discover %ld.%06ld, build %ld.%06ld, cycles %ld.%06ld, "
+	   "stack %ld.%06ld, overlays %ld.%06ld",
+	   htab->cg_stats.discover_time / 1000000,
+	   htab->cg_stats.discover_time % 1000000,
+	   htab->cg_stats.build_time / 1000000,
+	   htab->cg_stats.build_time % 1000000,
+	   htab->cg_stats.cycle_time / 1000000,
+	   htab->cg_stats.cycle_time % 1000000,
+	   htab->cg_stats.stack_time / 1000000,
+	   htab->cg_stats.stack_time % 1000000,
+	   htab->cg_stats.overlay_time / 1000000,
+	   htab->cg_stats.overlay_time % 1000000);
+  info->callbacks->einfo (_("%P: call graph time: %s\n"), buf);
+}
+
 /* qsort predicate to sort bfds by file name.  */
 
 static int
@@ -4167,6 +4712,7 @@ spu_elf_auto_overlay (struct bfd_link_info *info)
   struct _mos_param mos_param;
   struct _uos_param uos_param;
   struct function_info dummy_caller;
+  long start_time;
 
   /* Find the extents of our loadable image.  */
   lo = (unsigned int) -1;
@@ -4194,10 +4740,16 @@ spu_elf_auto_overlay (struct bfd_link_info *info)
   if (reserved == 0)
     {
       struct _sum_stack_param sum_stack_param;
+      long start_time = get_run_time ();
+      bfd_boolean ok;
 
       sum_stack_param.emit_stack_syms = 0;
       sum_stack_param.overall_stack = 0;
-      if (!for_each_node (sum_stack, info, &sum_stack_param, TRUE))
+      sum_stack_param.frames = NULL;
+      ok = for_each_node (sum_stack, info, &sum_stack_param, TRUE);
+      free (sum_stack_param.frames);
+      htab->cg_stats.stack_time = get_run_time () - start_time;
+      if (!ok)
 	goto err_exit;
       reserved = (sum_stack_param.overall_stack
 		  + htab->params->extra_stack_space);
@@ -4207,10 +4759,13 @@ spu_elf_auto_overlay (struct bfd_link_info *info)
   if (fixed_size + reserved <= htab->local_store
       && htab->params->ovly_flavour != ovly_soft_icache)
     {
+      print_call_graph_stats (info);
       htab->params->auto_overlay = 0;
       return;
     }
 
+  start_time = get_run_time ();
+
   uos_param.exclude_input_section = 0;
   uos_param.exclude_output_section
     = bfd_get_section_by_name (info->output_bfd, ".interrupt");
@@ -4457,7 +5012,7 @@ spu_elf_auto_overlay (struct bfd_link_info *info)
 		}
 	      else if (call->fun->sec->linker_mark)
 		{
-		  if (!copy_callee (&dummy_caller, call))
+		  if (!copy_callee (info, &dummy_caller, call))
 		    goto err_exit;
 		}
 	  while (pasty != NULL)
@@ -4470,7 +5025,7 @@ spu_elf_auto_overlay (struct bfd_link_info *info)
 		    BFD_ASSERT (pasty == NULL);
 		    pasty = call;
 		  }
-		else if (!copy_callee (&dummy_caller, call))
+		else if (!copy_callee (info, &dummy_caller, call))
 		  goto err_exit;
 	    }
 
@@ -4514,18 +5069,16 @@ spu_elf_auto_overlay (struct bfd_link_info *info)
 	  goto err_exit;
 	}
 
-      while (dummy_caller.call_list != NULL)
-	{
-	  struct call_info *call = dummy_caller.call_list;
-	  dummy_caller.call_list = call->next;
-	  free (call);
-	}
+      free_call_list (info, &dummy_caller);
 
       ++ovlynum;
       while (base < i)
 	ovly_map[base++] = ovlynum;
     }
 
+  htab->cg_stats.overlay_time = get_run_time () - start_time;
+  print_call_graph_stats (info);
+
   script = htab->params->spu_elf_open_overlay_script ();
 
   if (htab->params->ovly_flavour == ovly_soft_icache)
@@ -4640,7 +5193,13 @@ spu_elf_auto_overlay (struct bfd_link_info *info)
     goto file_err;
 
   if (htab->params->auto_overlay & AUTO_RELINK)
-    (*htab->params->spu_elf_relink) ();
+    {
+      /* The call graph describes the layout being thrown away.  Stack
+	 analysis builds it again for the relinked layout.  */
+      free_stack_info (info);
+      (*htab->params->spu_elf_relink) ();
+      return;
+    }
 
   xexit (0);
 
@@ -4658,6 +5217,8 @@ spu_elf_stack_analysis (struct bfd_link_info *info)
 {
   struct spu_link_hash_table *htab;
   struct _sum_stack_param sum_stack_param;
+  long start_time;
+  bfd_boolean ok;
 
   if (!discover_functions (info))
     return FALSE;
@@ -4673,14 +5234,20 @@ spu_elf_stack_analysis (struct bfd_link_info *info)
 				"Annotations: '*' max stack, 't' tail call\n"));
     }
 
+  start_time = get_run_time ();
   sum_stack_param.emit_stack_syms = htab->params->emit_stack_syms;
   sum_stack_param.overall_stack = 0;
-  if (!for_each_node (sum_stack, info, &sum_stack_param, TRUE))
+  sum_stack_param.frames = NULL;
+  ok = for_each_node (sum_stack, info, &sum_stack_param, TRUE);
+  free (sum_stack_param.frames);
+  htab->cg_stats.stack_time = get_run_time () - start_time;
+  if (!ok)
     return FALSE;
 
   if (htab->params->stack_analysis)
     info->callbacks->info (_("Maximum stack required is 0x%v\n"),
 			   (bfd_vma) sum_stack_param.overall_stack);
+  print_call_graph_stats (info);
   return TRUE;
 }
 
@@ -5097,6 +5664,33 @@ spu_elf_relocate_section (bfd *output_bfd,
   return ret;
 }
 
+/* Return TRUE if spu_elf_relocate_section may relocate SEC on another
+   thread.  .fixup entries must be emitted in order, and PPU relocs
+   change the reloc count of the section.  */
+
+static bfd_boolean
+spu_elf_relocate_section_ahead (bfd *output_bfd ATTRIBUTE_UNUSED,
+				struct bfd_link_info *info,
+				asection *sec,
+				Elf_Internal_Rela *relocs)
+{
+  struct spu_link_hash_table *htab = spu_hash_table (info);
+  Elf_Internal_Rela *rel, *relend;
+
+  if (htab->params->emit_fixups)
+    return FALSE;
+
+  relend = relocs + sec->reloc_count;
+  for (rel = relocs; rel < relend; rel++)
+    {
+      int r_type = ELF32_R_TYPE (rel->r_info);
+
+      if (r_type == R_SPU_PPU32 || r_type == R_SPU_PPU64)
+	return FALSE;
+    }
+  return TRUE;
+}
+
 /* Adjust _SPUEAR_ syms to point at their overlay stubs.  */
 
 static int
@@ -5457,11 +6051,13 @@ spu_elf_size_sections (bfd * output_bfd, struct bfd_link_info *info)
 #define elf_info_to_howto			spu_elf_info_to_howto
 #define elf_backend_count_relocs		spu_elf_count_relocs
 #define elf_backend_relocate_section		spu_elf_relocate_section
+#define elf_backend_relocate_section_ahead	spu_elf_relocate_section_ahead
 #define elf_backend_symbol_processing		spu_elf_backend_symbol_processing
 #define elf_backend_link_output_symbol_hook	spu_elf_output_symbol_hook
 #define elf_backend_object_p			spu_elf_object_p
 #define bfd_elf32_new_section_hook		spu_elf_new_section_hook
 #define bfd_elf32_bfd_link_hash_table_create	spu_elf_link_hash_table_create
+#define bfd_elf32_bfd_link_hash_table_free	spu_elf_link_hash_table_free
 
 #define elf_backend_additional_program_headers	spu_elf_additional_program_headers
 #define elf_backend_modify_segment_map		spu_elf_modify_segment_map
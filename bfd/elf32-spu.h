@@ -20,7 +20,9 @@
 
 struct spu_elf_params
 {
-  /* Stash various callbacks for --auto-overlay.  */
+  /* Stash various callbacks for --auto-overlay.  spu_elf_relink
+     either does not return, or returns having redone the layout with
+     the overlay script, in which case the final link carries on.  */
   void (*place_spu_section) (asection *, asection *, const char *);
   bfd_size_type (*spu_elf_load_ovl_mgr) (void);
   FILE *(*spu_elf_open_overlay_script) (void);
@@ -60,6 +62,9 @@ struct spu_elf_params
   /* Set when the .fixup section should be generated. */
   unsigned int emit_fixups : 1;
 
+  /* Set if --stats.  */
+  unsigned int stats : 1;
+
   /* Range of valid addresses for loadable sections.  */
   bfd_vma local_store_lo;
   bfd_vma local_store_hi;
@@ -32,6 +32,7 @@
 #include "bfdlink.h"
 #include "libbfd.h"
 #include "elf-bfd.h"
+#include "hashtab.h"
 #include "elf/ppc64.h"
 #include "elf64-ppc.h"
 
@@ -3607,11 +3608,32 @@ enum ppc_stub_type {
   ppc_stub_plt_call
 };
 
+/* The information that identifies a stub, as encoded in the stub name
+   by ppc_stub_name.  Used as the key of the stub index.  */
+
+struct ppc_stub_key {
+  /* Id of the first input section in the stub group.  */
+  unsigned int id_sec;
+
+  /* For local syms, the id of the sym section and the sym index.  */
+  unsigned int sym_sec;
+  unsigned long r_symndx;
+
+  /* For global syms, the symbol.  */
+  const struct ppc_link_hash_entry *h;
+
+  /* Low 32 bits of the reloc addend.  */
+  unsigned int addend;
+};
+
 struct ppc_stub_hash_entry {
 
   /* Base hash table entry structure.  */
   struct bfd_hash_entry root;
 
+  /* Key of this entry in the stub index.  */
+  struct ppc_stub_key key;
+
   enum ppc_stub_type stub_type;
 
   /* The stub section.  */
@@ -3709,6 +3731,10 @@ struct ppc_link_hash_table
   /* The stub hash table.  */
   struct bfd_hash_table stub_hash_table;
 
+  /* Index of the stub hash table entries by ppc_stub_key, so that stubs
+     can be found without building their names.  */
+  htab_t stub_index;
+
   /* Another hash table for plt_branch stubs.  */
   struct bfd_hash_table branch_hash_table;
 
@@ -3789,6 +3815,22 @@ struct ppc_link_hash_table
   /* Incremented every time we size stubs.  */
   unsigned int stub_iteration;
 
+  /* Branches that were in reach on the last stub sizing pass.  Only
+     these need to be looked at again after the stub sections grow.  */
+  struct ppc_branch_check {
+    /* The section containing the branch, and the branch reloc.  */
+    asection *section;
+    unsigned int rel_index;
+    unsigned int r_type;
+    bfd_vma r_offset;
+    /* The branch destination, as an offset from DEST_SEC output
+       address, or an absolute address if DEST_SEC is NULL.  */
+    asection *dest_sec;
+    bfd_vma dest_off;
+  } *branch_check;
+  unsigned int branch_check_count;
+  unsigned int branch_check_alloc;
+
   /* Small local sym cache.  */
   struct sym_cache sym_cache;
 };
@@ -3934,6 +3976,46 @@ link_hash_newfunc (struct bfd_hash_entry *entry,
   return entry;
 }
 
+/* Hash and compare functions for the stub index.  */
+
+static hashval_t
+ppc_stub_key_hash (const struct ppc_stub_key *key)
+{
+  hashval_t hash;
+
+  hash = iterative_hash_object (key->id_sec, 0);
+  if (key->h != NULL)
+    hash = iterative_hash_object (key->h, hash);
+  else
+    {
+      hash = iterative_hash_object (key->sym_sec, hash);
+      hash = iterative_hash_object (key->r_symndx, hash);
+    }
+  return iterative_hash_object (key->addend, hash);
+}
+
+static hashval_t
+ppc_stub_index_hash (const void *entry)
+{
+  const struct ppc_stub_hash_entry *stub_entry = entry;
+
+  return ppc_stub_key_hash (&stub_entry->key);
+}
+
+static int
+ppc_stub_index_eq (const void *entry, const void *key)
+{
+  const struct ppc_stub_hash_entry *stub_entry = entry;
+  const struct ppc_stub_key *a = &stub_entry->key;
+  const struct ppc_stub_key *b = key;
+
+  return (a->id_sec == b->id_sec
+	  && a->h == b->h
+	  && a->sym_sec == b->sym_sec
+	  && a->r_symndx == b->r_symndx
+	  && a->addend == b->addend);
+}
+
 /* Create a ppc64 ELF linker hash table.  */
 
 static struct bfd_link_hash_table *
@@ -3963,6 +4045,11 @@ ppc64_elf_link_hash_table_create (bfd *abfd)
 			    sizeof (struct ppc_branch_hash_entry)))
     return NULL;
 
+  htab->stub_index = htab_try_create (1024, ppc_stub_index_hash,
+				      ppc_stub_index_eq, NULL);
+  if (htab->stub_index == NULL)
+    return NULL;
+
   /* Initializing two fields of the union is just cosmetic.  We really
      only care about glist, but when compiled on a 32-bit host the
      bfd_vma fields are larger.  Setting the bfd_vma to zero makes
@@ -3988,6 +4075,10 @@ ppc64_elf_link_hash_table_free (struct bfd_link_hash_table *hash)
 
   bfd_hash_table_free (&ret->stub_hash_table);
   bfd_hash_table_free (&ret->branch_hash_table);
+  if (ret->stub_index != NULL)
+    htab_delete (ret->stub_index);
+  if (ret->branch_check != NULL)
+    free (ret->branch_check);
   _bfd_generic_link_hash_table_free (hash);
 }
 
@@ -4054,8 +4145,43 @@ ppc_stub_name (const asection *input_section,
   return stub_name;
 }
 
+/* Fill in KEY with the stub index key for a stub that ppc_stub_name
+   would name using the same arguments.  */
+
+static void
+ppc_stub_key_init (struct ppc_stub_key *key,
+		   const asection *input_section,
+		   const asection *sym_sec,
+		   const struct ppc_link_hash_entry *h,
+		   const Elf_Internal_Rela *rel)
+{
+  key->id_sec = input_section->id;
+  key->h = h;
+  if (h)
+    {
+      key->sym_sec = 0;
+      key->r_symndx = 0;
+    }
+  else
+    {
+      key->sym_sec = sym_sec->id;
+      key->r_symndx = ELF64_R_SYM (rel->r_info);
+    }
+  key->addend = (int) rel->r_addend & 0xffffffff;
+}
+
+/* Find the stub with key KEY in the stub index.  */
+
+static struct ppc_stub_hash_entry *
+ppc_stub_index_lookup (struct ppc_link_hash_table *htab,
+		       const struct ppc_stub_key *key)
+{
+  return htab_find_with_hash (htab->stub_index, key,
+			      ppc_stub_key_hash (key));
+}
+
 /* Look up an entry in the stub hash.  Stub entries are cached because
-   creating the stub name takes a bit of time.  */
+   finding them takes a bit of time.  */
 
 static struct ppc_stub_hash_entry *
 ppc_get_stub_entry (const asection *input_section,
@@ -4082,34 +4208,30 @@ ppc_get_stub_entry (const asection *input_section,
     }
   else
     {
-      char *stub_name;
-
-      stub_name = ppc_stub_name (id_sec, sym_sec, h, rel);
-      if (stub_name == NULL)
-	return NULL;
+      struct ppc_stub_key key;
 
-      stub_entry = ppc_stub_hash_lookup (&htab->stub_hash_table,
-					 stub_name, FALSE, FALSE);
+      ppc_stub_key_init (&key, id_sec, sym_sec, h, rel);
+      stub_entry = ppc_stub_index_lookup (htab, &key);
       if (h != NULL)
 	h->u.stub_cache = stub_entry;
-
-      free (stub_name);
     }
 
   return stub_entry;
 }
 
-/* Add a new stub entry to the stub hash.  Not all fields of the new
-   stub entry are initialised.  */
+/* Add a new stub entry to the stub hash, and to the stub index under
+   KEY.  Not all fields of the new stub entry are initialised.  */
 
 static struct ppc_stub_hash_entry *
 ppc_add_stub (const char *stub_name,
+	      const struct ppc_stub_key *key,
 	      asection *section,
 	      struct ppc_link_hash_table *htab)
 {
   asection *link_sec;
   asection *stub_sec;
   struct ppc_stub_hash_entry *stub_entry;
+  void **slot;
 
   link_sec = htab->stub_group[section->id].link_sec;
   stub_sec = htab->stub_group[section->id].stub_sec;
@@ -4148,6 +4270,13 @@ ppc_add_stub (const char *stub_name,
       return NULL;
     }
 
+  stub_entry->key = *key;
+  slot = htab_find_slot_with_hash (htab->stub_index, &stub_entry->key,
+				   ppc_stub_key_hash (key), INSERT);
+  if (slot == NULL)
+    return NULL;
+  *slot = stub_entry;
+
   stub_entry->stub_sec = stub_sec;
   stub_entry->stub_offset = 0;
   stub_entry->id_sec = link_sec;
@@ -8781,6 +8910,22 @@ ppc64_elf_size_dynamic_sections (bfd *output_bfd ATTRIBUTE_UNUSED,
   return TRUE;
 }
 
+/* Return whether a branch of type R_TYPE at LOCATION can reach
+   DESTINATION without a stub.  */
+
+static inline bfd_boolean
+branch_in_reach (unsigned int r_type, bfd_vma location, bfd_vma destination)
+{
+  bfd_vma branch_offset = destination - location;
+  bfd_vma max_branch_offset;
+
+  max_branch_offset = 1 << 25;
+  if (r_type != R_PPC64_REL24)
+    max_branch_offset = 1 << 15;
+
+  return branch_offset + max_branch_offset < 2 * max_branch_offset;
+}
+
 /* Determine the type of stub needed, if any, for a call.  */
 
 static inline enum ppc_stub_type
@@ -8792,9 +8937,6 @@ ppc_type_of_stub (asection *input_sec,
 {
   struct ppc_link_hash_entry *h = *hash;
   bfd_vma location;
-  bfd_vma branch_offset;
-  bfd_vma max_branch_offset;
-  enum elf_ppc64_reloc_type r_type;
 
   if (h != NULL)
     {
@@ -8851,15 +8993,8 @@ ppc_type_of_stub (asection *input_sec,
 	      + input_sec->output_section->vma
 	      + rel->r_offset);
 
-  branch_offset = destination - location;
-  r_type = ELF64_R_TYPE (rel->r_info);
-
   /* Determine if a long branch stub is needed.  */
-  max_branch_offset = 1 << 25;
-  if (r_type != R_PPC64_REL24)
-    max_branch_offset = 1 << 15;
-
-  if (branch_offset + max_branch_offset >= 2 * max_branch_offset)
+  if (!branch_in_reach (ELF64_R_TYPE (rel->r_info), location, destination))
     /* We need a stub.  Figure out whether a long_branch or plt_branch
        is needed later.  */
     return ppc_stub_long_branch;
@@ -10048,322 +10183,508 @@ group_sections (struct ppc_link_hash_table *htab,
 #undef PREV_SEC
 }
 
-/* Determine and set the size of the stub section for a final link.
+/* Look at branch reloc IRELA in SECTION, and add a stub for it if one
+   is needed.  INTERNAL_RELOCS are the relocs for SECTION.  Return -1
+   on error.  Return 1 if the branch does not need a stub only because
+   it is currently in reach, and fill in CHECK so that the branch can
+   be looked at again if sections move.  Return 0 otherwise.  */
 
-   The basic idea here is to examine all the relocations looking for
-   PC-relative calls to a target that is unreachable with a "bl"
-   instruction.  */
-
-bfd_boolean
-ppc64_elf_size_stubs (bfd *output_bfd,
-		      struct bfd_link_info *info,
-		      bfd_signed_vma group_size,
-		      asection *(*add_stub_section) (const char *, asection *),
-		      void (*layout_sections_again) (void))
+static int
+size_branch_stub (struct bfd_link_info *info,
+		  asection *section,
+		  Elf_Internal_Rela *internal_relocs,
+		  Elf_Internal_Rela *irela,
+		  Elf_Internal_Sym **local_syms,
+		  struct ppc_branch_check *check)
 {
-  bfd_size_type stub_group_size;
-  bfd_boolean stubs_always_before_branch;
   struct ppc_link_hash_table *htab = ppc_hash_table (info);
+  bfd *input_bfd = section->owner;
+  enum elf_ppc64_reloc_type r_type;
+  unsigned int r_indx;
+  enum ppc_stub_type stub_type;
+  struct ppc_stub_hash_entry *stub_entry;
+  struct ppc_stub_key key;
+  asection *sym_sec, *code_sec, *dest_sec;
+  bfd_vma sym_value, code_value;
+  bfd_vma destination;
+  bfd_boolean ok_dest;
+  struct ppc_link_hash_entry *hash;
+  struct ppc_link_hash_entry *fdh;
+  struct elf_link_hash_entry *h;
+  Elf_Internal_Sym *sym;
+  char *stub_name;
+  const asection *id_sec;
+  struct _opd_sec_data *opd;
+  struct plt_entry *plt_ent;
 
-  /* Stash our params away.  */
-  htab->add_stub_section = add_stub_section;
-  htab->layout_sections_again = layout_sections_again;
-  stubs_always_before_branch = group_size < 0;
-  if (group_size < 0)
-    stub_group_size = -group_size;
-  else
-    stub_group_size = group_size;
-
-  group_sections (htab, stub_group_size, stubs_always_before_branch);
+  r_type = ELF64_R_TYPE (irela->r_info);
+  r_indx = ELF64_R_SYM (irela->r_info);
 
-  while (1)
+  if (r_type >= R_PPC64_max)
     {
-      bfd *input_bfd;
-      unsigned int bfd_indx;
-      asection *stub_sec;
+      bfd_set_error (bfd_error_bad_value);
+      return -1;
+    }
 
-      htab->stub_iteration += 1;
+  /* Only look for stubs on branch instructions.  */
+  if (r_type != R_PPC64_REL24
+      && r_type != R_PPC64_REL14
+      && r_type != R_PPC64_REL14_BRTAKEN
+      && r_type != R_PPC64_REL14_BRNTAKEN)
+    return 0;
+
+  /* Now determine the call target, its name, value,
+     section.  */
+  if (!get_sym_h (&h, &sym, &sym_sec, NULL, local_syms,
+		  r_indx, input_bfd))
+    return -1;
+  hash = (struct ppc_link_hash_entry *) h;
 
-      for (input_bfd = info->input_bfds, bfd_indx = 0;
-	   input_bfd != NULL;
-	   input_bfd = input_bfd->link_next, bfd_indx++)
+  ok_dest = FALSE;
+  fdh = NULL;
+  sym_value = 0;
+  if (hash == NULL)
+    {
+      sym_value = sym->st_value;
+      ok_dest = TRUE;
+    }
+  else if (hash->elf.root.type == bfd_link_hash_defined
+	   || hash->elf.root.type == bfd_link_hash_defweak)
+    {
+      sym_value = hash->elf.root.u.def.value;
+      if (sym_sec->output_section != NULL)
+	ok_dest = TRUE;
+    }
+  else if (hash->elf.root.type == bfd_link_hash_undefweak
+	   || hash->elf.root.type == bfd_link_hash_undefined)
+    {
+      /* Recognise an old ABI func code entry sym, and
+	 use the func descriptor sym instead if it is
+	 defined.  */
+      if (hash->elf.root.root.string[0] == '.'
+	  && (fdh = lookup_fdh (hash, htab)) != NULL)
 	{
-	  Elf_Internal_Shdr *symtab_hdr;
-	  asection *section;
-	  Elf_Internal_Sym *local_syms = NULL;
+	  if (fdh->elf.root.type == bfd_link_hash_defined
+	      || fdh->elf.root.type == bfd_link_hash_defweak)
+	    {
+	      sym_sec = fdh->elf.root.u.def.section;
+	      sym_value = fdh->elf.root.u.def.value;
+	      if (sym_sec->output_section != NULL)
+		ok_dest = TRUE;
+	    }
+	  else
+	    fdh = NULL;
+	}
+    }
+  else
+    {
+      bfd_set_error (bfd_error_bad_value);
+      return -1;
+    }
 
-	  if (!is_ppc64_elf (input_bfd))
-	    continue;
+  /* DEST_SEC is the section DESTINATION is relative to, if any.  */
+  destination = 0;
+  dest_sec = NULL;
+  if (ok_dest)
+    {
+      sym_value += irela->r_addend;
+      destination = (sym_value
+		     + sym_sec->output_offset
+		     + sym_sec->output_section->vma);
+      dest_sec = sym_sec;
+    }
 
-	  /* We'll need the symbol table in a second.  */
-	  symtab_hdr = &elf_symtab_hdr (input_bfd);
-	  if (symtab_hdr->sh_info == 0)
-	    continue;
+  code_sec = sym_sec;
+  code_value = sym_value;
+  opd = get_opd_info (sym_sec);
+  if (opd != NULL)
+    {
+      bfd_vma dest;
 
-	  /* Walk over each section attached to the input bfd.  */
-	  for (section = input_bfd->sections;
-	       section != NULL;
-	       section = section->next)
+      if (hash == NULL && opd->adjust != NULL)
+	{
+	  long adjust = opd->adjust[sym_value / 8];
+	  if (adjust == -1)
+	    return 0;
+	  code_value += adjust;
+	  sym_value += adjust;
+	}
+      dest = opd_entry_value (sym_sec, sym_value,
+			      &code_sec, &code_value);
+      if (dest != (bfd_vma) -1)
+	{
+	  destination = dest;
+	  dest_sec = NULL;
+	  if (sym_sec->reloc_count != 0
+	      && code_sec != NULL
+	      && code_sec->output_section != NULL)
+	    dest_sec = code_sec;
+	  if (fdh != NULL)
 	    {
-	      Elf_Internal_Rela *internal_relocs, *irelaend, *irela;
-
-	      /* If there aren't any relocs, then there's nothing more
-		 to do.  */
-	      if ((section->flags & SEC_RELOC) == 0
-		  || (section->flags & SEC_ALLOC) == 0
-		  || (section->flags & SEC_LOAD) == 0
-		  || (section->flags & SEC_CODE) == 0
-		  || section->reloc_count == 0)
-		continue;
+	      /* Fixup old ABI sym to point at code
+		 entry.  */
+	      hash->elf.root.type = bfd_link_hash_defweak;
+	      hash->elf.root.u.def.section = code_sec;
+	      hash->elf.root.u.def.value = code_value;
+	    }
+	}
+    }
 
-	      /* If this section is a link-once section that will be
-		 discarded, then don't create any stubs.  */
-	      if (section->output_section == NULL
-		  || section->output_section->owner != output_bfd)
-		continue;
+  /* Determine what (if any) linker stub is needed.  */
+  plt_ent = NULL;
+  stub_type = ppc_type_of_stub (section, irela, &hash,
+				&plt_ent, destination);
+
+  if (stub_type != ppc_stub_plt_call)
+    {
+      /* Check whether we need a TOC adjusting stub.
+	 Since the linker pastes together pieces from
+	 different object files when creating the
+	 _init and _fini functions, it may be that a
+	 call to what looks like a local sym is in
+	 fact a call needing a TOC adjustment.  */
+      if (code_sec != NULL
+	  && code_sec->output_section != NULL
+	  && (htab->stub_group[code_sec->id].toc_off
+	      != htab->stub_group[section->id].toc_off)
+	  && (code_sec->has_toc_reloc
+	      || code_sec->makes_toc_func_call))
+	stub_type = ppc_stub_long_branch_r2off;
+    }
+
+  if (stub_type == ppc_stub_none)
+    {
+      bfd_vma location;
+
+      /* A branch that is in reach may need a stub if the stub
+	 sections grow.  */
+      location = (section->output_offset
+		  + section->output_section->vma
+		  + irela->r_offset);
+      if (!branch_in_reach (r_type, location, destination))
+	return 0;
+
+      check->section = section;
+      check->rel_index = irela - internal_relocs;
+      check->r_type = r_type;
+      check->r_offset = irela->r_offset;
+      check->dest_sec = dest_sec;
+      check->dest_off = destination;
+      if (dest_sec != NULL)
+	check->dest_off -= (dest_sec->output_offset
+			    + dest_sec->output_section->vma);
+      return 1;
+    }
 
-	      /* Get the relocs.  */
-	      internal_relocs
-		= _bfd_elf_link_read_relocs (input_bfd, section, NULL, NULL,
-					     info->keep_memory);
-	      if (internal_relocs == NULL)
-		goto error_ret_free_local;
-
-	      /* Now examine each relocation.  */
-	      irela = internal_relocs;
-	      irelaend = irela + section->reloc_count;
-	      for (; irela < irelaend; irela++)
-		{
-		  enum elf_ppc64_reloc_type r_type;
-		  unsigned int r_indx;
-		  enum ppc_stub_type stub_type;
-		  struct ppc_stub_hash_entry *stub_entry;
-		  asection *sym_sec, *code_sec;
-		  bfd_vma sym_value, code_value;
-		  bfd_vma destination;
-		  bfd_boolean ok_dest;
-		  struct ppc_link_hash_entry *hash;
-		  struct ppc_link_hash_entry *fdh;
-		  struct elf_link_hash_entry *h;
-		  Elf_Internal_Sym *sym;
-		  char *stub_name;
-		  const asection *id_sec;
-		  struct _opd_sec_data *opd;
-		  struct plt_entry *plt_ent;
+  /* __tls_get_addr calls might be eliminated.  */
+  if (stub_type != ppc_stub_plt_call
+      && hash != NULL
+      && (hash == htab->tls_get_addr
+	  || hash == htab->tls_get_addr_fd)
+      && section->has_tls_reloc
+      && irela != internal_relocs)
+    {
+      /* Get tls info.  */
+      char *tls_mask;
 
-		  r_type = ELF64_R_TYPE (irela->r_info);
-		  r_indx = ELF64_R_SYM (irela->r_info);
+      if (!get_tls_mask (&tls_mask, NULL, NULL, local_syms,
+			 irela - 1, input_bfd))
+	return -1;
+      if (*tls_mask != 0)
+	return 0;
+    }
 
-		  if (r_type >= R_PPC64_max)
-		    {
-		      bfd_set_error (bfd_error_bad_value);
-		      goto error_ret_free_internal;
-		    }
+  /* Support for grouping stub sections.  */
+  id_sec = htab->stub_group[section->id].link_sec;
 
-		  /* Only look for stubs on branch instructions.  */
-		  if (r_type != R_PPC64_REL24
-		      && r_type != R_PPC64_REL14
-		      && r_type != R_PPC64_REL14_BRTAKEN
-		      && r_type != R_PPC64_REL14_BRNTAKEN)
-		    continue;
+  ppc_stub_key_init (&key, id_sec, sym_sec, hash, irela);
+  stub_entry = ppc_stub_index_lookup (htab, &key);
+  if (stub_entry != NULL)
+    {
+      /* The proper stub has already been created.  */
+      return 0;
+    }
 
-		  /* Now determine the call target, its name, value,
-		     section.  */
-		  if (!get_sym_h (&h, &sym, &sym_sec, NULL, &local_syms,
-				  r_indx, input_bfd))
-		    goto error_ret_free_internal;
-		  hash = (struct ppc_link_hash_entry *) h;
+  /* Get the name of this stub.  */
+  stub_name = ppc_stub_name (id_sec, sym_sec, hash, irela);
+  if (!stub_name)
+    return -1;
 
-		  ok_dest = FALSE;
-		  fdh = NULL;
-		  sym_value = 0;
-		  if (hash == NULL)
-		    {
-		      sym_value = sym->st_value;
-		      ok_dest = TRUE;
-		    }
-		  else if (hash->elf.root.type == bfd_link_hash_defined
-			   || hash->elf.root.type == bfd_link_hash_defweak)
-		    {
-		      sym_value = hash->elf.root.u.def.value;
-		      if (sym_sec->output_section != NULL)
-			ok_dest = TRUE;
-		    }
-		  else if (hash->elf.root.type == bfd_link_hash_undefweak
-			   || hash->elf.root.type == bfd_link_hash_undefined)
-		    {
-		      /* Recognise an old ABI func code entry sym, and
-			 use the func descriptor sym instead if it is
-			 defined.  */
-		      if (hash->elf.root.root.string[0] == '.'
-			  && (fdh = lookup_fdh (hash, htab)) != NULL)
-			{
-			  if (fdh->elf.root.type == bfd_link_hash_defined
-			      || fdh->elf.root.type == bfd_link_hash_defweak)
-			    {
-			      sym_sec = fdh->elf.root.u.def.section;
-			      sym_value = fdh->elf.root.u.def.value;
-			      if (sym_sec->output_section != NULL)
-				ok_dest = TRUE;
-			    }
-			  else
-			    fdh = NULL;
-			}
-		    }
-		  else
-		    {
-		      bfd_set_error (bfd_error_bad_value);
-		      goto error_ret_free_internal;
-		    }
+  stub_entry = ppc_add_stub (stub_name, &key, section, htab);
+  if (stub_entry == NULL)
+    {
+      free (stub_name);
+      return -1;
+    }
 
-		  destination = 0;
-		  if (ok_dest)
-		    {
-		      sym_value += irela->r_addend;
-		      destination = (sym_value
-				     + sym_sec->output_offset
-				     + sym_sec->output_section->vma);
-		    }
+  stub_entry->stub_type = stub_type;
+  if (stub_type != ppc_stub_plt_call)
+    {
+      stub_entry->target_value = code_value;
+      stub_entry->target_section = code_sec;
+    }
+  else
+    {
+      stub_entry->target_value = sym_value;
+      stub_entry->target_section = sym_sec;
+    }
+  stub_entry->h = hash;
+  stub_entry->plt_ent = plt_ent;
+  stub_entry->addend = irela->r_addend;
 
-		  code_sec = sym_sec;
-		  code_value = sym_value;
-		  opd = get_opd_info (sym_sec);
-		  if (opd != NULL)
-		    {
-		      bfd_vma dest;
+  if (stub_entry->h != NULL)
+    htab->stub_globals += 1;
 
-		      if (hash == NULL && opd->adjust != NULL)
-			{
-			  long adjust = opd->adjust[sym_value / 8];
-			  if (adjust == -1)
-			    continue;
-			  code_value += adjust;
-			  sym_value += adjust;
-			}
-		      dest = opd_entry_value (sym_sec, sym_value,
-					      &code_sec, &code_value);
-		      if (dest != (bfd_vma) -1)
-			{
-			  destination = dest;
-			  if (fdh != NULL)
-			    {
-			      /* Fixup old ABI sym to point at code
-				 entry.  */
-			      hash->elf.root.type = bfd_link_hash_defweak;
-			      hash->elf.root.u.def.section = code_sec;
-			      hash->elf.root.u.def.value = code_value;
-			    }
-			}
-		    }
+  return 0;
+}
 
-		  /* Determine what (if any) linker stub is needed.  */
-		  plt_ent = NULL;
-		  stub_type = ppc_type_of_stub (section, irela, &hash,
-						&plt_ent, destination);
+/* Free or cache LOCAL_SYMS, read for INPUT_BFD while sizing stubs.  */
 
-		  if (stub_type != ppc_stub_plt_call)
-		    {
-		      /* Check whether we need a TOC adjusting stub.
-			 Since the linker pastes together pieces from
-			 different object files when creating the
-			 _init and _fini functions, it may be that a
-			 call to what looks like a local sym is in
-			 fact a call needing a TOC adjustment.  */
-		      if (code_sec != NULL
-			  && code_sec->output_section != NULL
-			  && (htab->stub_group[code_sec->id].toc_off
-			      != htab->stub_group[section->id].toc_off)
-			  && (code_sec->has_toc_reloc
-			      || code_sec->makes_toc_func_call))
-			stub_type = ppc_stub_long_branch_r2off;
-		    }
+static void
+release_local_syms (struct bfd_link_info *info,
+		    bfd *input_bfd,
+		    Elf_Internal_Sym *local_syms)
+{
+  Elf_Internal_Shdr *symtab_hdr = &elf_symtab_hdr (input_bfd);
 
-		  if (stub_type == ppc_stub_none)
-		    continue;
+  if (local_syms != NULL
+      && symtab_hdr->contents != (unsigned char *) local_syms)
+    {
+      if (!info->keep_memory)
+	free (local_syms);
+      else
+	symtab_hdr->contents = (unsigned char *) local_syms;
+    }
+}
 
-		  /* __tls_get_addr calls might be eliminated.  */
-		  if (stub_type != ppc_stub_plt_call
-		      && hash != NULL
-		      && (hash == htab->tls_get_addr
-			  || hash == htab->tls_get_addr_fd)
-		      && section->has_tls_reloc
-		      && irela != internal_relocs)
-		    {
-		      /* Get tls info.  */
-		      char *tls_mask;
+/* Look at all the branch relocs on the first stub sizing pass, noting
+   branches that are in reach in htab->branch_check.  */
 
-		      if (!get_tls_mask (&tls_mask, NULL, NULL, &local_syms,
-					 irela - 1, input_bfd))
-			goto error_ret_free_internal;
-		      if (*tls_mask != 0)
-			continue;
-		    }
+static bfd_boolean
+size_stubs_scan_relocs (bfd *output_bfd, struct bfd_link_info *info)
+{
+  struct ppc_link_hash_table *htab = ppc_hash_table (info);
+  bfd *input_bfd;
 
-		  /* Support for grouping stub sections.  */
-		  id_sec = htab->stub_group[section->id].link_sec;
+  htab->branch_check_count = 0;
+  for (input_bfd = info->input_bfds;
+       input_bfd != NULL;
+       input_bfd = input_bfd->link_next)
+    {
+      Elf_Internal_Shdr *symtab_hdr;
+      asection *section;
+      Elf_Internal_Sym *local_syms = NULL;
 
-		  /* Get the name of this stub.  */
-		  stub_name = ppc_stub_name (id_sec, sym_sec, hash, irela);
-		  if (!stub_name)
-		    goto error_ret_free_internal;
+      if (!is_ppc64_elf (input_bfd))
+	continue;
 
-		  stub_entry = ppc_stub_hash_lookup (&htab->stub_hash_table,
-						     stub_name, FALSE, FALSE);
-		  if (stub_entry != NULL)
-		    {
-		      /* The proper stub has already been created.  */
-		      free (stub_name);
-		      continue;
-		    }
+      /* We'll need the symbol table in a second.  */
+      symtab_hdr = &elf_symtab_hdr (input_bfd);
+      if (symtab_hdr->sh_info == 0)
+	continue;
 
-		  stub_entry = ppc_add_stub (stub_name, section, htab);
-		  if (stub_entry == NULL)
-		    {
-		      free (stub_name);
-		    error_ret_free_internal:
-		      if (elf_section_data (section)->relocs == NULL)
-			free (internal_relocs);
-		    error_ret_free_local:
-		      if (local_syms != NULL
-			  && (symtab_hdr->contents
-			      != (unsigned char *) local_syms))
-			free (local_syms);
-		      return FALSE;
-		    }
+      /* Walk over each section attached to the input bfd.  */
+      for (section = input_bfd->sections;
+	   section != NULL;
+	   section = section->next)
+	{
+	  Elf_Internal_Rela *internal_relocs, *irelaend, *irela;
 
-		  stub_entry->stub_type = stub_type;
-		  if (stub_type != ppc_stub_plt_call)
-		    {
-		      stub_entry->target_value = code_value;
-		      stub_entry->target_section = code_sec;
-		    }
-		  else
-		    {
-		      stub_entry->target_value = sym_value;
-		      stub_entry->target_section = sym_sec;
-		    }
-		  stub_entry->h = hash;
-		  stub_entry->plt_ent = plt_ent;
-		  stub_entry->addend = irela->r_addend;
+	  /* If there aren't any relocs, then there's nothing more
+	     to do.  */
+	  if ((section->flags & SEC_RELOC) == 0
+	      || (section->flags & SEC_ALLOC) == 0
+	      || (section->flags & SEC_LOAD) == 0
+	      || (section->flags & SEC_CODE) == 0
+	      || section->reloc_count == 0)
+	    continue;
+
+	  /* If this section is a link-once section that will be
+	     discarded, then don't create any stubs.  */
+	  if (section->output_section == NULL
+	      || section->output_section->owner != output_bfd)
+	    continue;
 
-		  if (stub_entry->h != NULL)
-		    htab->stub_globals += 1;
+	  /* Get the relocs.  */
+	  internal_relocs
+	    = _bfd_elf_link_read_relocs (input_bfd, section, NULL, NULL,
+					 info->keep_memory);
+	  if (internal_relocs == NULL)
+	    goto error_ret_free_local;
+
+	  /* Now examine each relocation.  */
+	  irela = internal_relocs;
+	  irelaend = irela + section->reloc_count;
+	  for (; irela < irelaend; irela++)
+	    {
+	      int ret;
+
+	      if (htab->branch_check_count == htab->branch_check_alloc)
+		{
+		  struct ppc_branch_check *p;
+		  bfd_size_type amt;
+
+		  amt = htab->branch_check_alloc * 2 + 1024;
+		  p = bfd_realloc (htab->branch_check, amt * sizeof (*p));
+		  if (p == NULL)
+		    goto error_ret_free_internal;
+		  htab->branch_check = p;
+		  htab->branch_check_alloc = amt;
 		}
 
-	      /* We're done with the internal relocs, free them.  */
-	      if (elf_section_data (section)->relocs != internal_relocs)
-		free (internal_relocs);
+	      ret = size_branch_stub (info, section, internal_relocs, irela,
+				      &local_syms,
+				      (htab->branch_check
+				       + htab->branch_check_count));
+	      if (ret < 0)
+		{
+		error_ret_free_internal:
+		  if (elf_section_data (section)->relocs == NULL)
+		    free (internal_relocs);
+		error_ret_free_local:
+		  if (local_syms != NULL
+		      && (symtab_hdr->contents
+			  != (unsigned char *) local_syms))
+		    free (local_syms);
+		  return FALSE;
+		}
+	      htab->branch_check_count += ret;
 	    }
 
-	  if (local_syms != NULL
-	      && symtab_hdr->contents != (unsigned char *) local_syms)
+	  /* We're done with the internal relocs, free them.  */
+	  if (elf_section_data (section)->relocs != internal_relocs)
+	    free (internal_relocs);
+	}
+
+      release_local_syms (info, input_bfd, local_syms);
+    }
+
+  return TRUE;
+}
+
+/* On later stub sizing passes, only branches that were in reach
+   before can need new stubs.  Look at those that have gone out of
+   reach, and drop them from htab->branch_check once they no longer
+   depend on section placement.  */
+
+static bfd_boolean
+size_stubs_recheck_branches (struct bfd_link_info *info)
+{
+  struct ppc_link_hash_table *htab = ppc_hash_table (info);
+  struct ppc_branch_check *check, *keep, *end;
+  asection *section = NULL;
+  Elf_Internal_Rela *internal_relocs = NULL;
+  bfd *input_bfd = NULL;
+  Elf_Internal_Sym *local_syms = NULL;
+  bfd_boolean ok = TRUE;
+
+  check = keep = htab->branch_check;
+  end = check + htab->branch_check_count;
+  for (; check < end; check++)
+    {
+      bfd_vma location, destination;
+      int ret;
+
+      location = (check->section->output_offset
+		  + check->section->output_section->vma
+		  + check->r_offset);
+      destination = check->dest_off;
+      if (check->dest_sec != NULL)
+	destination += (check->dest_sec->output_offset
+			+ check->dest_sec->output_section->vma);
+      if (branch_in_reach (check->r_type, location, destination))
+	{
+	  *keep++ = *check;
+	  continue;
+	}
+
+      if (check->section != section)
+	{
+	  if (internal_relocs != NULL
+	      && elf_section_data (section)->relocs != internal_relocs)
+	    free (internal_relocs);
+	  section = check->section;
+	  if (section->owner != input_bfd)
 	    {
-	      if (!info->keep_memory)
-		free (local_syms);
-	      else
-		symtab_hdr->contents = (unsigned char *) local_syms;
+	      if (input_bfd != NULL)
+		release_local_syms (info, input_bfd, local_syms);
+	      input_bfd = section->owner;
+	      local_syms = NULL;
 	    }
+	  internal_relocs
+	    = _bfd_elf_link_read_relocs (input_bfd, section, NULL, NULL,
+					 info->keep_memory);
+	  if (internal_relocs == NULL)
+	    {
+	      ok = FALSE;
+	      break;
+	    }
+	}
+
+      ret = size_branch_stub (info, section, internal_relocs,
+			      internal_relocs + check->rel_index,
+			      &local_syms, keep);
+      if (ret < 0)
+	{
+	  ok = FALSE;
+	  break;
+	}
+      keep += ret;
+    }
+  htab->branch_check_count = keep - htab->branch_check;
+
+  if (internal_relocs != NULL
+      && elf_section_data (section)->relocs != internal_relocs)
+    free (internal_relocs);
+  if (input_bfd != NULL)
+    release_local_syms (info, input_bfd, local_syms);
+  return ok;
+}
+
+/* Determine and set the size of the stub section for a final link.
+
+   The basic idea here is to examine all the relocations looking for
+   PC-relative calls to a target that is unreachable with a "bl"
+   instruction.  */
+
+bfd_boolean
+ppc64_elf_size_stubs (bfd *output_bfd,
+		      struct bfd_link_info *info,
+		      bfd_signed_vma group_size,
+		      asection *(*add_stub_section) (const char *, asection *),
+		      void (*layout_sections_again) (void))
+{
+  bfd_size_type stub_group_size;
+  bfd_boolean stubs_always_before_branch;
+  bfd_boolean first_pass;
+  struct ppc_link_hash_table *htab = ppc_hash_table (info);
+
+  /* Stash our params away.  */
+  htab->add_stub_section = add_stub_section;
+  htab->layout_sections_again = layout_sections_again;
+  stubs_always_before_branch = group_size < 0;
+  if (group_size < 0)
+    stub_group_size = -group_size;
+  else
+    stub_group_size = group_size;
+
+  group_sections (htab, stub_group_size, stubs_always_before_branch);
+
+  first_pass = TRUE;
+  while (1)
+    {
+      asection *stub_sec;
+
+      htab->stub_iteration += 1;
+
+      if (first_pass)
+	{
+	  if (!size_stubs_scan_relocs (output_bfd, info))
+	    return FALSE;
+	  first_pass = FALSE;
 	}
+      else if (!size_stubs_recheck_branches (info))
+	return FALSE;
 
       /* We may have added some stubs.  Find out the new size of the
 	 stub sections.  */
@@ -29,6 +29,9 @@
 #include "safe-ctype.h"
 #include "libiberty.h"
 #include "objalloc.h"
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
 
 /* This struct is used to pass information to routines called via
    elf_link_hash_traverse which must return failure.  */
@@ -4895,6 +4898,199 @@ _bfd_elf_archive_symbol_lookup (bfd *abfd,
   return h;
 }
 
+/* An index of an archive map, used by elf_link_add_archive_symbols to
+   find the map entries that a newly undefined symbol might select.
+   Names are keyed without a leading dot or version, since archive
+   symbol lookup functions only ever add those to the name.  */
+
+struct archive_symbol_entry
+{
+  struct bfd_hash_entry root;
+  /* First map entry with this key.  Others are chained through the
+     NEXT array of the index.  */
+  symindex first;
+};
+
+struct archive_symbol_index
+{
+  struct bfd_hash_table table;
+  symindex *next;
+  /* Buffer for stripping names.  */
+  char *buf;
+  size_t bufsize;
+};
+
+/* Map entries waiting to be looked at, lowest index first.  */
+
+struct archive_symbol_queue
+{
+  symindex *heap;
+  symindex count;
+  symindex size;
+};
+
+static struct bfd_hash_entry *
+archive_symbol_newfunc (struct bfd_hash_entry *entry,
+			struct bfd_hash_table *table,
+			const char *string)
+{
+  struct archive_symbol_entry *ret = (struct archive_symbol_entry *) entry;
+
+  if (ret == NULL)
+    {
+      ret = ((struct archive_symbol_entry *)
+	     bfd_hash_allocate (table, sizeof (struct archive_symbol_entry)));
+      if (ret == NULL)
+	return NULL;
+    }
+
+  ret = ((struct archive_symbol_entry *)
+	 bfd_hash_newfunc ((struct bfd_hash_entry *) ret, table, string));
+  if (ret != NULL)
+    ret->first = BFD_NO_MORE_SYMBOLS;
+
+  return (struct bfd_hash_entry *) ret;
+}
+
+/* Return the key under which NAME is indexed, or NULL on error.  The
+   result may live in SIDX's buffer.  */
+
+static const char *
+archive_symbol_key (struct archive_symbol_index *sidx, const char *name)
+{
+  const char *p;
+  size_t len;
+
+  if (name[0] == '.')
+    name++;
+  p = strchr (name, ELF_VER_CHR);
+  if (p == NULL)
+    return name;
+
+  len = p - name;
+  if (len + 1 > sidx->bufsize)
+    {
+      char *buf = (char *) bfd_realloc (sidx->buf, len + 1);
+      if (buf == NULL)
+	return NULL;
+      sidx->buf = buf;
+      sidx->bufsize = len + 1;
+    }
+  memcpy (sidx->buf, name, len);
+  sidx->buf[len] = '\0';
+  return sidx->buf;
+}
+
+static void
+archive_symbol_index_free (struct archive_symbol_index *sidx)
+{
+  bfd_hash_table_free (&sidx->table);
+  free (sidx->next);
+  if (sidx->buf != NULL)
+    free (sidx->buf);
+}
+
+/* Index the C entries of archive map SYMDEFS.  */
+
+static bfd_boolean
+archive_symbol_index_init (struct archive_symbol_index *sidx,
+			   carsym *symdefs, symindex c)
+{
+  bfd_size_type amt;
+  symindex i;
+
+  sidx->buf = NULL;
+  sidx->bufsize = 0;
+  amt = c * sizeof (symindex);
+  sidx->next = (symindex *) bfd_malloc (amt);
+  if (sidx->next == NULL)
+    return FALSE;
+  if (!bfd_hash_table_init (&sidx->table, archive_symbol_newfunc,
+			    sizeof (struct archive_symbol_entry)))
+    {
+      free (sidx->next);
+      return FALSE;
+    }
+
+  /* Link in reverse, so that each chain is in map order.  */
+  for (i = c; i-- > 0; )
+    {
+      const char *key = archive_symbol_key (sidx, symdefs[i].name);
+      struct archive_symbol_entry *ent;
+
+      if (key != NULL)
+	ent = ((struct archive_symbol_entry *)
+	       bfd_hash_lookup (&sidx->table, key, TRUE,
+				key != symdefs[i].name));
+      if (key == NULL || ent == NULL)
+	{
+	  archive_symbol_index_free (sidx);
+	  return FALSE;
+	}
+      sidx->next[i] = ent->first;
+      ent->first = i;
+    }
+  return TRUE;
+}
+
+static bfd_boolean
+archive_queue_push (struct archive_symbol_queue *q, symindex i)
+{
+  symindex n;
+
+  if (q->count == q->size)
+    {
+      symindex *heap;
+
+      q->size = q->size ? q->size * 2 : 64;
+      heap = (symindex *) bfd_realloc (q->heap, q->size * sizeof (symindex));
+      if (heap == NULL)
+	return FALSE;
+      q->heap = heap;
+    }
+
+  for (n = q->count++; n > 0 && q->heap[(n - 1) / 2] > i; n = (n - 1) / 2)
+    q->heap[n] = q->heap[(n - 1) / 2];
+  q->heap[n] = i;
+  return TRUE;
+}
+
+static symindex
+archive_queue_pop (struct archive_symbol_queue *q)
+{
+  symindex top = q->heap[0];
+  symindex last = q->heap[--q->count];
+  symindex n = 0;
+
+  for (;;)
+    {
+      symindex child = 2 * n + 1;
+
+      if (child >= q->count)
+	break;
+      if (child + 1 < q->count && q->heap[child + 1] < q->heap[child])
+	child++;
+      if (q->heap[child] >= last)
+	break;
+      q->heap[n] = q->heap[child];
+      n = child;
+    }
+  q->heap[n] = last;
+  return top;
+}
+
+/* Queue map entry I on Q for pass PASS, unless it already is.  */
+
+static bfd_boolean
+archive_queue_add (struct archive_symbol_queue *q, unsigned int *queued,
+		   unsigned int pass, symindex i)
+{
+  if (queued[i] == pass)
+    return TRUE;
+  queued[i] = pass;
+  return archive_queue_push (q, i);
+}
+
 /* Add symbols from an ELF archive file to the linker hash table.  We
    don't use _bfd_generic_link_add_archive_symbols because of a
    problem which arises on UnixWare.  The UnixWare libc.so is an
@@ -4918,7 +5114,11 @@ _bfd_elf_archive_symbol_lookup (bfd *abfd,
    object file.
 
    Unfortunately, we do have to make multiple passes over the symbol
-   table until nothing further is resolved.  */
+   table until nothing further is resolved.  Only the first pass looks
+   at the whole map.  Later passes look at the entries whose symbol has
+   been referenced since they were last looked at, along with those
+   whose symbol was undefweak or common, in the same order as a full
+   pass would, so the same elements are included.  */
 
 static bfd_boolean
 elf_link_add_archive_symbols (bfd *abfd, struct bfd_link_info *info)
@@ -4926,8 +5126,14 @@ elf_link_add_archive_symbols (bfd *abfd, struct bfd_link_info *info)
   symindex c;
   bfd_boolean *defined = NULL;
   bfd_boolean *included = NULL;
+  unsigned int *queued = NULL;
+  struct archive_symbol_queue queue[2];
+  struct archive_symbol_index sidx;
+  bfd_boolean have_index = FALSE;
   carsym *symdefs;
   bfd_boolean loop;
+  bfd_boolean scan_all;
+  unsigned int pass;
   bfd_size_type amt;
   const struct elf_backend_data *bed;
   struct elf_link_hash_entry * (*archive_symbol_lookup)
@@ -4948,36 +5154,57 @@ elf_link_add_archive_symbols (bfd *abfd, struct bfd_link_info *info)
   c = bfd_ardata (abfd)->symdef_count;
   if (c == 0)
     return TRUE;
+  memset (queue, 0, sizeof (queue));
   amt = c;
   amt *= sizeof (bfd_boolean);
   defined = (bfd_boolean *) bfd_zmalloc (amt);
   included = (bfd_boolean *) bfd_zmalloc (amt);
-  if (defined == NULL || included == NULL)
+  amt = c;
+  amt *= sizeof (unsigned int);
+  queued = (unsigned int *) bfd_zmalloc (amt);
+  if (defined == NULL || included == NULL || queued == NULL)
     goto error_return;
 
   symdefs = bfd_ardata (abfd)->symdefs;
   bed = get_elf_backend_data (abfd);
   archive_symbol_lookup = bed->elf_backend_archive_symbol_lookup;
 
+  scan_all = TRUE;
+  pass = 1;
   do
     {
+      /* Entries to look at in this pass, and in the next.  */
+      struct archive_symbol_queue *now = &queue[pass & 1];
+      struct archive_symbol_queue *later = &queue[(pass + 1) & 1];
+      bfd_boolean linear = scan_all;
       file_ptr last;
       symindex i;
-      carsym *symdef;
-      carsym *symdefend;
 
       loop = FALSE;
+      scan_all = FALSE;
       last = -1;
+      if (linear)
+	now->count = 0;
 
-      symdef = symdefs;
-      symdefend = symdef + c;
-      for (i = 0; symdef < symdefend; symdef++, i++)
+      for (i = 0; ; i++)
 	{
 	  struct elf_link_hash_entry *h;
 	  bfd *element;
 	  struct bfd_link_hash_entry *undefs_tail;
+	  struct bfd_link_hash_entry *u;
+	  carsym *symdef;
 	  symindex mark;
 
+	  if (!linear)
+	    {
+	      if (now->count == 0)
+		break;
+	      i = archive_queue_pop (now);
+	    }
+	  else if (i >= c)
+	    break;
+	  symdef = symdefs + i;
+
 	  if (defined[i] || included[i])
 	    continue;
 	  if (symdef->file_offset == last)
@@ -5008,12 +5235,18 @@ elf_link_add_archive_symbols (bfd *abfd, struct bfd_link_info *info)
 		 table and check that to see what kind of symbol definition
 		 this is.  */
 	      if (! elf_link_is_defined_archive_symbol (abfd, symdef))
-		continue;
+		{
+		  if (!archive_queue_add (later, queued, pass + 1, i))
+		    goto error_return;
+		  continue;
+		}
 	    }
 	  else if (h->root.type != bfd_link_hash_undefined)
 	    {
 	      if (h->root.type != bfd_link_hash_undefweak)
 		defined[i] = TRUE;
+	      else if (!archive_queue_add (later, queued, pass + 1, i))
+		goto error_return;
 	      continue;
 	    }
 
@@ -5043,16 +5276,6 @@ elf_link_add_archive_symbols (bfd *abfd, struct bfd_link_info *info)
 	  if (! bfd_link_add_symbols (element, info))
 	    goto error_return;
 
-	  /* If there are any new undefined symbols, we need to make
-	     another pass through the archive in order to see whether
-	     they can be defined.  FIXME: This isn't perfect, because
-	     common symbols wind up on undefs_tail and because an
-	     undefined symbol which is defined later on in this pass
-	     does not require another pass.  This isn't a bug, but it
-	     does make the code less efficient than it could be.  */
-	  if (undefs_tail != info->hash->undefs_tail)
-	    loop = TRUE;
-
 	  /* Look backward to mark all symbols from this object file
 	     which we have already seen in this pass.  */
 	  mark = i;
@@ -5068,12 +5291,90 @@ elf_link_add_archive_symbols (bfd *abfd, struct bfd_link_info *info)
 	  /* We mark subsequent symbols from this object file as we go
 	     on through the loop.  */
 	  last = symdef->file_offset;
+
+	  /* If there are any new undefined symbols, we need to make
+	     another pass through the archive in order to see whether
+	     they can be defined.  FIXME: This isn't perfect, because
+	     common symbols wind up on undefs_tail and because an
+	     undefined symbol which is defined later on in this pass
+	     does not require another pass.  This isn't a bug, but it
+	     does make the code less efficient than it could be.  */
+	  if (undefs_tail == info->hash->undefs_tail)
+	    continue;
+	  loop = TRUE;
+
+	  /* Queue the map entries for the new undefined symbols: later
+	     entries for this pass, and earlier ones for the next.  If
+	     the old tail has been dropped from the undefs list, we
+	     can't tell which symbols are new, so look at everything.  */
+	  if (undefs_tail == NULL)
+	    u = info->hash->undefs;
+	  else if (undefs_tail->type == bfd_link_hash_new
+		   || undefs_tail->type == bfd_link_hash_undefweak)
+	    {
+	      symindex k;
+
+	      scan_all = TRUE;
+	      if (!linear)
+		for (k = i + 1; k < c; k++)
+		  if (!defined[k] && !included[k]
+		      && !archive_queue_add (now, queued, pass, k))
+		    goto error_return;
+	      u = NULL;
+	    }
+	  else
+	    u = undefs_tail->u.undef.next;
+
+	  if (u != NULL && !have_index)
+	    {
+	      if (!archive_symbol_index_init (&sidx, symdefs, c))
+		goto error_return;
+	      have_index = TRUE;
+	    }
+
+	  for (; u != NULL; u = u->u.undef.next)
+	    {
+	      struct archive_symbol_entry *ent;
+	      const char *key;
+	      symindex k;
+
+	      if (u->type != bfd_link_hash_undefined
+		  && u->type != bfd_link_hash_common)
+		continue;
+	      key = archive_symbol_key (&sidx, u->root.string);
+	      if (key == NULL)
+		goto error_return;
+	      ent = ((struct archive_symbol_entry *)
+		     bfd_hash_lookup (&sidx.table, key, FALSE, FALSE));
+	      if (ent == NULL)
+		continue;
+	      for (k = ent->first; k != BFD_NO_MORE_SYMBOLS; k = sidx.next[k])
+		{
+		  if (defined[k] || included[k])
+		    continue;
+		  if (k > i)
+		    {
+		      if (!linear && !archive_queue_add (now, queued, pass, k))
+			goto error_return;
+		    }
+		  else if (!archive_queue_add (later, queued, pass + 1, k))
+		    goto error_return;
+		}
+	    }
 	}
+      pass++;
     }
   while (loop);
 
   free (defined);
   free (included);
+  free (queued);
+  if (queue[0].heap != NULL)
+    free (queue[0].heap);
+  if (queue[1].heap != NULL)
+    free (queue[1].heap);
+  if (have_index)
+    archive_symbol_index_free (&sidx);
 
   return TRUE;
 
@@ -5082,6 +5383,14 @@ elf_link_add_archive_symbols (bfd *abfd, struct bfd_link_info *info)
     free (defined);
   if (included != NULL)
     free (included);
+  if (queued != NULL)
+    free (queued);
+  if (queue[0].heap != NULL)
+    free (queue[0].heap);
+  if (queue[1].heap != NULL)
+    free (queue[1].heap);
+  if (have_index)
+    archive_symbol_index_free (&sidx);
   return FALSE;
 }
 
@@ -7302,6 +7611,8 @@ struct elf_final_link_info
   size_t symbuf_size;
   /* And same for symshndxbuf.  */
   size_t shndxbuf_size;
+  /* Input files relocated ahead on other threads, or NULL.  */
+  struct elf_link_ahead *ahead;
 };
 
 /* This struct is used to pass information to elf_link_output_extsym.  */
@@ -8947,6 +9258,684 @@ _bfd_elf_check_kept_section (asection *sec, struct bfd_link_info *info)
   return kept;
 }
 
+/* Return the section of the local symbol ISYM of INPUT_BFD, or NULL if
+   it has none that the linker can use.  If ISYM is in a SEC_MERGE
+   section, adjust its value for the merged contents and return the
+   section holding them.  */
+
+static asection *
+elf_link_local_sym_section (bfd *output_bfd, bfd *input_bfd,
+			    Elf_Internal_Sym *isym)
+{
+  asection *isec;
+
+  if (elf_bad_symtab (input_bfd)
+      && ELF_ST_BIND (isym->st_info) != STB_LOCAL)
+    return NULL;
+
+  if (isym->st_shndx == SHN_UNDEF)
+    return bfd_und_section_ptr;
+  if (isym->st_shndx == SHN_ABS)
+    return bfd_abs_section_ptr;
+  if (isym->st_shndx == SHN_COMMON)
+    return bfd_com_section_ptr;
+
+  /* Symbols with st_shndx in the reserved range other than SHN_ABS
+     and SHN_COMMON have no section.  */
+  isec = bfd_section_from_elf_index (input_bfd, isym->st_shndx);
+  if (isec != NULL
+      && isec->sec_info_type == ELF_INFO_TYPE_MERGE
+      && ELF_ST_TYPE (isym->st_info) != STT_SECTION)
+    isym->st_value =
+      _bfd_merged_section_offset (output_bfd, &isec,
+				  elf_section_data (isec)->sec_info,
+				  isym->st_value);
+  return isec;
+}
+
+/* When the linker may use threads, the sections of the next few input
+   files are relocated before elf_link_input_bfd reaches them, several
+   at a time.  Each is relocated in a private copy of its contents and
+   relocs, against a private copy of the local symbols of its file.
+   elf_link_input_bfd then uses the result instead of relocating the
+   section itself, unless relocating it ahead reported any problem, or
+   something it read has since been changed by the relocs of an
+   earlier section.  Those sections are relocated again in order, so
+   that neither the output file nor the messages of the linker depend
+   on the number of threads.  */
+
+/* A section relocated ahead.  */
+
+struct elf_reloc_ahead
+{
+  /* The next section of the same input file.  */
+  struct elf_reloc_ahead *next;
+  asection *sec;
+  struct elf_input_ahead *input;
+  /* The relocated contents and relocs.  */
+  bfd_byte *contents;
+  Elf_Internal_Rela *relocs;
+  /* What relocate_section returned.  */
+  int ret;
+  /* Whether elf_link_input_bfd may use the result.  */
+  bfd_boolean valid;
+};
+
+/* An input file with sections relocated ahead.  */
+
+struct elf_input_ahead
+{
+  bfd *abfd;
+  /* The local symbols, and their sections, as elf_link_input_bfd
+     would pass them to relocate_section.  */
+  Elf_Internal_Sym *isymbuf;
+  asection **sections;
+  /* The sections relocated ahead, and the next of them that
+     elf_link_input_bfd will reach.  */
+  struct elf_reloc_ahead *sections_ahead;
+  struct elf_reloc_ahead *next_ahead;
+};
+
+#ifdef HAVE_PTHREAD_H
+
+/* Limits on the size of a batch of input files relocated ahead.  */
+#define ELF_LINK_AHEAD_FILES_PER_THREAD 16
+#define ELF_LINK_AHEAD_BYTES (32 * 1024 * 1024)
+
+struct elf_link_ahead
+{
+  struct elf_final_link_info *finfo;
+  unsigned int threads;
+  /* The ELF input files, in the order elf_link_input_bfd sees them,
+     and the index of the first not yet relocated ahead.  */
+  bfd **inputs;
+  size_t count;
+  size_t next;
+  /* The current batch of input files, and the index of the next one
+     elf_link_input_bfd will see.  */
+  struct elf_input_ahead *batch;
+  size_t batch_count;
+  size_t current;
+  /* The sections of the batch, shared out between the threads.  */
+  struct elf_reloc_ahead **jobs;
+  size_t job_count;
+  size_t jobs_size;
+  size_t next_job;
+  pthread_mutex_t lock;
+};
+
+/* Each thread relocating ahead records the section it is working on
+   here, for the callbacks below.  */
+static pthread_key_t elf_ahead_key;
+static pthread_once_t elf_ahead_key_once = PTHREAD_ONCE_INIT;
+static bfd_boolean elf_ahead_key_ok;
+
+static void
+elf_ahead_create_key (void)
+{
+  elf_ahead_key_ok = pthread_key_create (&elf_ahead_key, NULL) == 0;
+}
+
+/* The link callbacks and error handler used while relocating ahead.
+   Rather than report anything, they mark the section to be relocated
+   again in order, and stop relocate_section where they can.  */
+
+static void
+elf_ahead_diagnose (void)
+{
+  struct elf_reloc_ahead *job;
+
+  job = (struct elf_reloc_ahead *) pthread_getspecific (elf_ahead_key);
+  if (job != NULL)
+    job->valid = FALSE;
+}
+
+static bfd_boolean
+elf_ahead_warning (struct bfd_link_info *info ATTRIBUTE_UNUSED,
+		   const char *warning ATTRIBUTE_UNUSED,
+		   const char *symbol ATTRIBUTE_UNUSED,
+		   bfd *abfd ATTRIBUTE_UNUSED,
+		   asection *section ATTRIBUTE_UNUSED,
+		   bfd_vma address ATTRIBUTE_UNUSED)
+{
+  elf_ahead_diagnose ();
+  return FALSE;
+}
+
+static bfd_boolean
+elf_ahead_undefined_symbol (struct bfd_link_info *info ATTRIBUTE_UNUSED,
+			    const char *name ATTRIBUTE_UNUSED,
+			    bfd *abfd ATTRIBUTE_UNUSED,
+			    asection *section ATTRIBUTE_UNUSED,
+			    bfd_vma address ATTRIBUTE_UNUSED,
+			    bfd_boolean fatal ATTRIBUTE_UNUSED)
+{
+  elf_ahead_diagnose ();
+  return FALSE;
+}
+
+static bfd_boolean
+elf_ahead_reloc_overflow (struct bfd_link_info *info ATTRIBUTE_UNUSED,
+			  struct bfd_link_hash_entry *entry ATTRIBUTE_UNUSED,
+			  const char *name ATTRIBUTE_UNUSED,
+			  const char *reloc_name ATTRIBUTE_UNUSED,
+			  bfd_vma addend ATTRIBUTE_UNUSED,
+			  bfd *abfd ATTRIBUTE_UNUSED,
+			  asection *section ATTRIBUTE_UNUSED,
+			  bfd_vma address ATTRIBUTE_UNUSED)
+{
+  elf_ahead_diagnose ();
+  return FALSE;
+}
+
+static bfd_boolean
+elf_ahead_reloc_dangerous (struct bfd_link_info *info ATTRIBUTE_UNUSED,
+			   const char *message ATTRIBUTE_UNUSED,
+			   bfd *abfd ATTRIBUTE_UNUSED,
+			   asection *section ATTRIBUTE_UNUSED,
+			   bfd_vma address ATTRIBUTE_UNUSED)
+{
+  elf_ahead_diagnose ();
+  return FALSE;
+}
+
+/* Used for unattached_reloc and notice, which have the same type.  */
+
+static bfd_boolean
+elf_ahead_notice (struct bfd_link_info *info ATTRIBUTE_UNUSED,
+		  const char *name ATTRIBUTE_UNUSED,
+		  bfd *abfd ATTRIBUTE_UNUSED,
+		  asection *section ATTRIBUTE_UNUSED,
+		  bfd_vma address ATTRIBUTE_UNUSED)
+{
+  elf_ahead_diagnose ();
+  return FALSE;
+}
+
+/* Used for einfo, info, minfo and _bfd_error_handler.  */
+
+static void
+elf_ahead_message (const char *fmt ATTRIBUTE_UNUSED, ...)
+{
+  elf_ahead_diagnose ();
+}
+
+/* Return TRUE if the loop over the relocs of section O of INPUT_BFD
+   in elf_link_input_bfd, before relocate_section is called, would do
+   nothing for RELOCS.  */
+
+static bfd_boolean
+elf_link_relocs_unchecked (struct elf_final_link_info *finfo,
+			   bfd *input_bfd, asection *o,
+			   Elf_Internal_Rela *relocs,
+			   Elf_Internal_Sym *isymbuf, asection **sections,
+			   size_t locsymcount)
+{
+  const struct elf_backend_data *bed;
+  struct elf_link_hash_entry **sym_hashes;
+  Elf_Internal_Rela *rel, *relend;
+  size_t extsymoff;
+  int r_sym_shift;
+  int action_discarded;
+
+  bed = get_elf_backend_data (finfo->output_bfd);
+  sym_hashes = elf_sym_hashes (input_bfd);
+  extsymoff = elf_bad_symtab (input_bfd) ? 0 : locsymcount;
+  r_sym_shift = bed->s->arch_size == 32 ? 8 : 32;
+
+  action_discarded = -1;
+  if (!elf_section_ignore_discarded_relocs (o))
+    action_discarded = (*bed->action_discarded) (o);
+
+  rel = relocs;
+  relend = rel + o->reloc_count * bed->s->int_rels_per_ext_rel;
+  for ( ; rel < relend; rel++)
+    {
+      unsigned long r_symndx = rel->r_info >> r_sym_shift;
+      unsigned int s_type;
+      asection *sec;
+
+      if (r_symndx == STN_UNDEF)
+	continue;
+
+      sec = NULL;
+      if (r_symndx >= locsymcount
+	  || (elf_bad_symtab (input_bfd) && sections[r_symndx] == NULL))
+	{
+	  struct elf_link_hash_entry *h = sym_hashes[r_symndx - extsymoff];
+
+	  if (h == NULL)
+	    return FALSE;
+	  while (h->root.type == bfd_link_hash_indirect
+		 || h->root.type == bfd_link_hash_warning)
+	    h = (struct elf_link_hash_entry *) h->root.u.i.link;
+	  s_type = h->type;
+	  if (h->root.type == bfd_link_hash_defined
+	      || h->root.type == bfd_link_hash_defweak)
+	    sec = h->root.u.def.section;
+	}
+      else
+	{
+	  s_type = ELF_ST_TYPE (isymbuf[r_symndx].st_info);
+	  sec = sections[r_symndx];
+	}
+
+      if ((s_type == STT_RELC || s_type == STT_SRELC)
+	  && !finfo->info->relocatable)
+	return FALSE;
+
+      if (action_discarded != -1
+	  && sec != NULL
+	  && elf_discarded_section (sec))
+	return FALSE;
+    }
+  return TRUE;
+}
+
+/* Read the local symbols of the input file IN, and those of its
+   sections which can be relocated ahead.  Add the size of what was
+   read to *BYTES.  Failures are not reported here: the sections are
+   left to elf_link_input_bfd, which will run into them again.  */
+
+static void
+elf_link_read_input_ahead (struct elf_link_ahead *ahead,
+			   struct elf_input_ahead *in,
+			   bfd_size_type *bytes)
+{
+  struct elf_final_link_info *finfo = ahead->finfo;
+  bfd *output_bfd = finfo->output_bfd;
+  const struct elf_backend_data *bed = get_elf_backend_data (output_bfd);
+  bfd *input_bfd = in->abfd;
+  Elf_Internal_Shdr *symtab_hdr;
+  struct elf_reloc_ahead **tail;
+  size_t locsymcount;
+  size_t i;
+  asection *o;
+
+  symtab_hdr = &elf_tdata (input_bfd)->symtab_hdr;
+  if (elf_bad_symtab (input_bfd))
+    locsymcount = symtab_hdr->sh_size / bed->s->sizeof_sym;
+  else
+    locsymcount = symtab_hdr->sh_info;
+
+  if (locsymcount != 0)
+    {
+      /* relocate_section may look up the names of local symbols, so
+	 read their string table now.  */
+      if (bfd_elf_string_from_elf_section (input_bfd, symtab_hdr->sh_link,
+					   0) == NULL)
+	return;
+
+      in->isymbuf = (Elf_Internal_Sym *)
+	  bfd_malloc (locsymcount * sizeof (Elf_Internal_Sym));
+      in->sections = (asection **)
+	  bfd_malloc (locsymcount * sizeof (asection *));
+      if (in->isymbuf == NULL || in->sections == NULL)
+	return;
+      if (symtab_hdr->contents != NULL)
+	memcpy (in->isymbuf, symtab_hdr->contents,
+		locsymcount * sizeof (Elf_Internal_Sym));
+      else if (bfd_elf_get_elf_syms (input_bfd, symtab_hdr, locsymcount, 0,
+				     in->isymbuf, NULL, NULL) == NULL)
+	return;
+
+      for (i = 0; i < locsymcount; i++)
+	in->sections[i] = elf_link_local_sym_section (output_bfd, input_bfd,
+						      in->isymbuf + i);
+    }
+
+  tail = &in->sections_ahead;
+  for (o = input_bfd->sections; o != NULL; o = o->next)
+    {
+      struct elf_reloc_ahead *job;
+      bfd_size_type amt;
+      bfd_size_type relsize;
+      Elf_Internal_Rela *relocs;
+
+      if (! o->linker_mark
+	  || ((o->flags & (SEC_HAS_CONTENTS | SEC_RELOC | SEC_LINKER_CREATED))
+	      != (SEC_HAS_CONTENTS | SEC_RELOC))
+	  || o->size == 0
+	  || o->reloc_count == 0
+	  || o->sec_info_type != ELF_INFO_TYPE_NONE
+	  || (o->rawsize != 0 && o->rawsize < o->size))
+	continue;
+
+      if (ahead->job_count == ahead->jobs_size)
+	{
+	  struct elf_reloc_ahead **jobs;
+	  size_t size = ahead->jobs_size ? ahead->jobs_size * 2 : 64;
+
+	  jobs = (struct elf_reloc_ahead **)
+	      bfd_realloc (ahead->jobs, size * sizeof (*jobs));
+	  if (jobs == NULL)
+	    return;
+	  ahead->jobs = jobs;
+	  ahead->jobs_size = size;
+	}
+
+      relocs = _bfd_elf_link_read_relocs (input_bfd, o, NULL, NULL, FALSE);
+      if (relocs == NULL)
+	return;
+      relsize = (o->reloc_count * bed->s->int_rels_per_ext_rel
+		 * sizeof (Elf_Internal_Rela));
+      if (relocs == elf_section_data (o)->relocs)
+	{
+	  relocs = (Elf_Internal_Rela *) bfd_malloc (relsize);
+	  if (relocs == NULL)
+	    return;
+	  memcpy (relocs, elf_section_data (o)->relocs, relsize);
+	}
+
+      if (! (*bed->elf_backend_relocate_section_ahead) (output_bfd,
+							finfo->info,
+							o, relocs)
+	  || ! elf_link_relocs_unchecked (finfo, input_bfd, o, relocs,
+					  in->isymbuf, in->sections,
+					  locsymcount))
+	{
+	  free (relocs);
+	  continue;
+	}
+
+      job = (struct elf_reloc_ahead *) bfd_zmalloc (sizeof (*job));
+      amt = o->rawsize ? o->rawsize : o->size;
+      if (job != NULL)
+	job->contents = (bfd_byte *) bfd_malloc (amt);
+      if (job == NULL || job->contents == NULL)
+	{
+	  free (job);
+	  free (relocs);
+	  return;
+	}
+      job->sec = o;
+      job->input = in;
+      job->relocs = relocs;
+      *tail = job;
+      tail = &job->next;
+
+      if (elf_section_data (o)->this_hdr.contents != NULL)
+	memcpy (job->contents, elf_section_data (o)->this_hdr.contents, amt);
+      else if (! bfd_get_section_contents (input_bfd, o, job->contents,
+					   0, amt))
+	return;
+
+      ahead->jobs[ahead->job_count++] = job;
+      *bytes += amt + relsize;
+    }
+}
+
+/* Relocate sections of the batch until none are left.  This is run
+   by each thread.  */
+
+static void *
+elf_link_relocate_ahead (void *data)
+{
+  struct elf_link_ahead *ahead = (struct elf_link_ahead *) data;
+  struct elf_final_link_info *finfo = ahead->finfo;
+  const struct elf_backend_data *bed;
+
+  bed = get_elf_backend_data (finfo->output_bfd);
+  for (;;)
+    {
+      struct elf_reloc_ahead *job = NULL;
+
+      pthread_mutex_lock (&ahead->lock);
+      if (ahead->next_job < ahead->job_count)
+	job = ahead->jobs[ahead->next_job++];
+      pthread_mutex_unlock (&ahead->lock);
+      if (job == NULL)
+	break;
+
+      job->valid = TRUE;
+      pthread_setspecific (elf_ahead_key, job);
+      job->ret = (*bed->elf_backend_relocate_section) (finfo->output_bfd,
+						       finfo->info,
+						       job->input->abfd,
+						       job->sec,
+						       job->contents,
+						       job->relocs,
+						       job->input->isymbuf,
+						       job->input->sections);
+      pthread_setspecific (elf_ahead_key, NULL);
+      if (job->ret == 0)
+	job->valid = FALSE;
+    }
+  return NULL;
+}
+
+/* Free the current batch of input files relocated ahead.  */
+
+static void
+elf_link_free_batch (struct elf_link_ahead *ahead)
+{
+  size_t i;
+
+  for (i = 0; i < ahead->batch_count; i++)
+    {
+      struct elf_input_ahead *in = &ahead->batch[i];
+      struct elf_reloc_ahead *job, *next;
+
+      for (job = in->sections_ahead; job != NULL; job = next)
+	{
+	  next = job->next;
+	  free (job->contents);
+	  free (job->relocs);
+	  free (job);
+	}
+      if (in->isymbuf != NULL)
+	free (in->isymbuf);
+      if (in->sections != NULL)
+	free (in->sections);
+    }
+  if (ahead->batch != NULL)
+    free (ahead->batch);
+  ahead->batch = NULL;
+  ahead->batch_count = 0;
+  ahead->current = 0;
+  ahead->job_count = 0;
+  ahead->next_job = 0;
+}
+
+/* Read the next batch of input files, and relocate what can be
+   relocated of them, on as many threads as we may use.  */
+
+static void
+elf_link_batch_ahead (struct elf_link_ahead *ahead)
+{
+  struct bfd_link_info *info = ahead->finfo->info;
+  const struct bfd_link_callbacks *callbacks;
+  struct bfd_link_callbacks quiet;
+  bfd_error_handler_type error_handler;
+  bfd_size_type bytes;
+  size_t max_files;
+  pthread_t *threads;
+  unsigned int nthreads, i;
+
+  max_files = (size_t) ahead->threads * ELF_LINK_AHEAD_FILES_PER_THREAD;
+  if (max_files > ahead->count - ahead->next)
+    max_files = ahead->count - ahead->next;
+  ahead->batch = (struct elf_input_ahead *)
+      bfd_zmalloc (max_files * sizeof (struct elf_input_ahead));
+  if (ahead->batch == NULL)
+    return;
+
+  /* Anything that goes wrong from here on will happen again when
+     elf_link_input_bfd reaches the section, and be reported then.  */
+  error_handler = bfd_set_error_handler (elf_ahead_message);
+
+  bytes = 0;
+  while (ahead->batch_count < max_files && bytes < ELF_LINK_AHEAD_BYTES)
+    {
+      struct elf_input_ahead *in = &ahead->batch[ahead->batch_count++];
+
+      in->abfd = ahead->inputs[ahead->next++];
+      elf_link_read_input_ahead (ahead, in, &bytes);
+      in->next_ahead = in->sections_ahead;
+    }
+
+  if (ahead->job_count == 0)
+    {
+      bfd_set_error_handler (error_handler);
+      return;
+    }
+
+  callbacks = info->callbacks;
+  quiet = *callbacks;
+  quiet.warning = elf_ahead_warning;
+  quiet.undefined_symbol = elf_ahead_undefined_symbol;
+  quiet.reloc_overflow = elf_ahead_reloc_overflow;
+  quiet.reloc_dangerous = elf_ahead_reloc_dangerous;
+  quiet.unattached_reloc = elf_ahead_notice;
+  quiet.notice = elf_ahead_notice;
+  quiet.einfo = elf_ahead_message;
+  quiet.info = elf_ahead_message;
+  quiet.minfo = elf_ahead_message;
+  info->callbacks = &quiet;
+
+  nthreads = ahead->threads - 1;
+  if (nthreads > ahead->job_count - 1)
+    nthreads = ahead->job_count - 1;
+  threads = NULL;
+  if (nthreads != 0)
+    threads = (pthread_t *) bfd_malloc (nthreads * sizeof (pthread_t));
+  if (threads == NULL)
+    nthreads = 0;
+  for (i = 0; i < nthreads; i++)
+    if (pthread_create (&threads[i], NULL, elf_link_relocate_ahead,
+			ahead) != 0)
+      break;
+  nthreads = i;
+
+  elf_link_relocate_ahead (ahead);
+
+  for (i = 0; i < nthreads; i++)
+    pthread_join (threads[i], NULL);
+  if (threads != NULL)
+    free (threads);
+
+  bfd_set_error_handler (error_handler);
+  info->callbacks = callbacks;
+}
+
+/* Return the sections of INPUT_BFD relocated ahead, relocating the
+   next batch of input files if INPUT_BFD starts it.  */
+
+static struct elf_input_ahead *
+elf_link_input_ahead (struct elf_link_ahead *ahead, bfd *input_bfd)
+{
+  if (ahead->current == ahead->batch_count)
+    {
+      elf_link_free_batch (ahead);
+      if (ahead->next < ahead->count
+	  && ahead->inputs[ahead->next] == input_bfd)
+	elf_link_batch_ahead (ahead);
+    }
+
+  if (ahead->current < ahead->batch_count
+      && ahead->batch[ahead->current].abfd == input_bfd)
+    return &ahead->batch[ahead->current++];
+  return NULL;
+}
+
+/* Return the relocated copy of section O of the input file IN, or
+   NULL if O must be relocated in order.  */
+
+static struct elf_reloc_ahead *
+elf_link_reloc_ahead (struct elf_input_ahead *in, asection *o)
+{
+  struct elf_reloc_ahead *job = in->next_ahead;
+
+  if (job == NULL || job->sec != o)
+    return NULL;
+  in->next_ahead = job->next;
+  return job->valid ? job : NULL;
+}
+
+/* Called when the relocs of a section have changed a symbol that
+   sections relocated ahead may have read.  */
+
+static void
+elf_link_invalidate_ahead (struct elf_link_ahead *ahead)
+{
+  size_t i;
+
+  for (i = 0; i < ahead->job_count; i++)
+    ahead->jobs[i]->valid = FALSE;
+}
+
+/* Set up relocating ahead for the link described by FINFO, using
+   THREADS threads.  Return NULL if that is not possible.  */
+
+static struct elf_link_ahead *
+elf_link_ahead_init (struct elf_final_link_info *finfo,
+		     unsigned int threads)
+{
+  const struct elf_backend_data *bed;
+  struct elf_link_ahead *ahead;
+  asection *o;
+  struct bfd_link_order *p;
+  bfd *sub;
+  size_t count;
+
+  pthread_once (&elf_ahead_key_once, elf_ahead_create_key);
+  if (! elf_ahead_key_ok)
+    return NULL;
+
+  ahead = (struct elf_link_ahead *) bfd_zmalloc (sizeof (*ahead));
+  if (ahead == NULL)
+    return NULL;
+  ahead->finfo = finfo;
+  ahead->threads = threads;
+
+  count = 0;
+  for (sub = finfo->info->input_bfds; sub != NULL; sub = sub->link_next)
+    count++;
+  ahead->inputs = (bfd **) bfd_malloc ((count + 1) * sizeof (bfd *));
+  if (ahead->inputs == NULL
+      || pthread_mutex_init (&ahead->lock, NULL) != 0)
+    {
+      free (ahead->inputs);
+      free (ahead);
+      return NULL;
+    }
+
+  /* Find the order in which bfd_elf_final_link will pass the input
+     files to elf_link_input_bfd.  */
+  bed = get_elf_backend_data (finfo->output_bfd);
+  for (o = finfo->output_bfd->sections; o != NULL; o = o->next)
+    for (p = o->map_head.link_order; p != NULL; p = p->next)
+      if (p->type == bfd_indirect_link_order
+	  && (bfd_get_flavour ((sub = p->u.indirect.section->owner))
+	      == bfd_target_elf_flavour)
+	  && elf_elfheader (sub)->e_ident[EI_CLASS] == bed->s->elfclass
+	  && ! sub->output_has_begun)
+	{
+	  sub->output_has_begun = TRUE;
+	  if ((sub->flags & DYNAMIC) == 0 && ahead->count < count)
+	    ahead->inputs[ahead->count++] = sub;
+	}
+  for (sub = finfo->info->input_bfds; sub != NULL; sub = sub->link_next)
+    sub->output_has_begun = FALSE;
+
+  return ahead;
+}
+
+static void
+elf_link_ahead_free (struct elf_link_ahead *ahead)
+{
+  if (ahead == NULL)
+    return;
+  elf_link_free_batch (ahead);
+  if (ahead->jobs != NULL)
+    free (ahead->jobs);
+  free (ahead->inputs);
+  pthread_mutex_destroy (&ahead->lock);
+  free (ahead);
+}
+
+#endif /* HAVE_PTHREAD_H */
+
 /* Link an input file into the linker output file.  This function
    handles all the sections and relocations of the input file at once.
    This is so that we only have to read the local symbols once, and
@@ -8970,6 +9959,10 @@ elf_link_input_bfd (struct elf_final_link_info *finfo, bfd *input_bfd)
   asection *o;
   const struct elf_backend_data *bed;
   struct elf_link_hash_entry **sym_hashes;
+  bfd_byte *contents_buf;
+#ifdef HAVE_PTHREAD_H
+  struct elf_input_ahead *input_ahead;
+#endif
 
   output_bfd = finfo->output_bfd;
   bed = get_elf_backend_data (output_bfd);
@@ -8981,6 +9974,12 @@ elf_link_input_bfd (struct elf_final_link_info *finfo, bfd *input_bfd)
   if ((input_bfd->flags & DYNAMIC) != 0)
     return TRUE;
 
+#ifdef HAVE_PTHREAD_H
+  input_ahead = NULL;
+  if (finfo->ahead != NULL)
+    input_ahead = elf_link_input_ahead (finfo->ahead, input_bfd);
+#endif
+
   symtab_hdr = &elf_tdata (input_bfd)->symtab_hdr;
   if (elf_bad_symtab (input_bfd))
     {
@@ -9021,40 +10020,10 @@ elf_link_input_bfd (struct elf_final_link_info *finfo, bfd *input_bfd)
 
       *pindex = -1;
 
-      if (elf_bad_symtab (input_bfd))
-	{
-	  if (ELF_ST_BIND (isym->st_info) != STB_LOCAL)
-	    {
-	      *ppsection = NULL;
-	      continue;
-	    }
-	}
-
-      if (isym->st_shndx == SHN_UNDEF)
-	isec = bfd_und_section_ptr;
-      else if (isym->st_shndx == SHN_ABS)
-	isec = bfd_abs_section_ptr;
-      else if (isym->st_shndx == SHN_COMMON)
-	isec = bfd_com_section_ptr;
-      else
-	{
-	  isec = bfd_section_from_elf_index (input_bfd, isym->st_shndx);
-	  if (isec == NULL)
-	    {
-	      /* Don't attempt to output symbols with st_shnx in the
-		 reserved range other than SHN_ABS and SHN_COMMON.  */
-	      *ppsection = NULL;
-	      continue;
-	    }
-	  else if (isec->sec_info_type == ELF_INFO_TYPE_MERGE
-		   && ELF_ST_TYPE (isym->st_info) != STT_SECTION)
-	    isym->st_value =
-	      _bfd_merged_section_offset (output_bfd, &isec,
-					  elf_section_data (isec)->sec_info,
-					  isym->st_value);
-	}
-
+      isec = elf_link_local_sym_section (output_bfd, input_bfd, isym);
       *ppsection = isec;
+      if (isec == NULL)
+	continue;
 
       /* Don't output the first, undefined, symbol.  */
       if (ppsection == finfo->sections)
@@ -9145,6 +10114,7 @@ elf_link_input_bfd (struct elf_final_link_info *finfo, bfd *input_bfd)
   for (o = input_bfd->sections; o != NULL; o = o->next)
     {
       bfd_byte *contents;
+      struct elf_reloc_ahead *sec_ahead;
 
       if (! o->linker_mark)
 	{
@@ -9231,8 +10201,43 @@ elf_link_input_bfd (struct elf_final_link_info *finfo, bfd *input_bfd)
 	 relaxation routine.  Note that o is a section in an input
 	 file, so the contents field will not have been set by any of
 	 the routines which work on output files.  */
-      if (elf_section_data (o)->this_hdr.contents != NULL)
+      contents_buf = NULL;
+      sec_ahead = NULL;
+#ifdef HAVE_PTHREAD_H
+      if (input_ahead != NULL)
+	sec_ahead = elf_link_reloc_ahead (input_ahead, o);
+#endif
+      if (sec_ahead != NULL)
+	{
+	  /* The section has already been relocated.  */
+	  contents = sec_ahead->contents;
+	  if (elf_section_data (o)->this_hdr.contents != NULL)
+	    {
+	      memcpy (elf_section_data (o)->this_hdr.contents, contents,
+		      o->rawsize ? o->rawsize : o->size);
+	      contents = elf_section_data (o)->this_hdr.contents;
+	    }
+	}
+      else if (elf_section_data (o)->this_hdr.contents != NULL)
 	contents = elf_section_data (o)->this_hdr.contents;
+      else if ((o->flags & SEC_RELOC) == 0
+	       && bed->elf_backend_write_section == NULL
+	       && o->sec_info_type == ELF_INFO_TYPE_MERGE)
+	/* Merged sections are written from the merge hash table.  */
+	contents = NULL;
+      else if ((o->flags & SEC_RELOC) == 0
+	       && bed->elf_backend_write_section == NULL
+	       && o->sec_info_type == ELF_INFO_TYPE_NONE
+	       && (o->rawsize == 0 || o->rawsize >= o->size))
+	{
+	  const bfd_byte *view;
+
+	  /* The contents will be written out unchanged, so there is
+	     no need for a private copy of them.  */
+	  if (! bfd_map_section_contents (input_bfd, o, &view, &contents_buf))
+	    return FALSE;
+	  contents = (bfd_byte *) view;
+	}
       else
 	{
 	  bfd_size_type amt = o->rawsize ? o->rawsize : o->size;
@@ -9252,9 +10257,21 @@ elf_link_input_bfd (struct elf_final_link_info *finfo, bfd *input_bfd)
 	  int ret;
 
 	  /* Get the swapped relocs.  */
-	  internal_relocs
-	    = _bfd_elf_link_read_relocs (input_bfd, o, finfo->external_relocs,
-					 finfo->internal_relocs, FALSE);
+	  if (sec_ahead != NULL)
+	    {
+	      internal_relocs = sec_ahead->relocs;
+	      if (elf_section_data (o)->relocs != NULL)
+		{
+		  memcpy (elf_section_data (o)->relocs, internal_relocs,
+			  (o->reloc_count * bed->s->int_rels_per_ext_rel
+			   * sizeof (Elf_Internal_Rela)));
+		  internal_relocs = elf_section_data (o)->relocs;
+		}
+	    }
+	  else
+	    internal_relocs
+	      = _bfd_elf_link_read_relocs (input_bfd, o, finfo->external_relocs,
+					   finfo->internal_relocs, FALSE);
 	  if (internal_relocs == NULL
 	      && o->reloc_count > 0)
 	    return FALSE;
@@ -9282,6 +10299,9 @@ elf_link_input_bfd (struct elf_final_link_info *finfo, bfd *input_bfd)
 
 	  rel = internal_relocs;
 	  relend = rel + o->reloc_count * bed->s->int_rels_per_ext_rel;
+	  if (sec_ahead != NULL)
+	    /* That was found to have nothing to do before relocating.  */
+	    rel = relend;
 	  for ( ; rel < relend; rel++)
 	    {
 	      unsigned long r_symndx = rel->r_info >> r_sym_shift;
@@ -9361,6 +10381,10 @@ elf_link_input_bfd (struct elf_final_link_info *finfo, bfd *input_bfd)
 		  /* Symbol evaluated OK.  Update to absolute value.  */
 		  set_symbol_value (input_bfd, isymbuf, locsymcount,
 				    r_symndx, val);
+#ifdef HAVE_PTHREAD_H
+		  if (finfo->ahead != NULL)
+		    elf_link_invalidate_ahead (finfo->ahead);
+#endif
 		  continue;
 		}
 
@@ -9392,6 +10416,10 @@ elf_link_input_bfd (struct elf_final_link_info *finfo, bfd *input_bfd)
 			  if (kept != NULL)
 			    {
 			      *ps = kept;
+#ifdef HAVE_PTHREAD_H
+			      if (finfo->ahead != NULL)
+				elf_link_invalidate_ahead (finfo->ahead);
+#endif
 			      continue;
 			    }
 			}
@@ -9419,11 +10447,14 @@ elf_link_input_bfd (struct elf_final_link_info *finfo, bfd *input_bfd)
 	     corresponding to the output section, which will require
 	     the addend to be adjusted.  */
 
-	  ret = (*relocate_section) (output_bfd, finfo->info,
-				     input_bfd, o, contents,
-				     internal_relocs,
-				     isymbuf,
-				     finfo->sections);
+	  if (sec_ahead != NULL)
+	    ret = sec_ahead->ret;
+	  else
+	    ret = (*relocate_section) (output_bfd, finfo->info,
+				       input_bfd, o, contents,
+				       internal_relocs,
+				       isymbuf,
+				       finfo->sections);
 	  if (!ret)
 	    return FALSE;
 
@@ -9718,10 +10749,17 @@ elf_link_input_bfd (struct elf_final_link_info *finfo, bfd *input_bfd)
 					       contents,
 					       (file_ptr) o->output_offset,
 					       o->size))
-	      return FALSE;
+	      {
+		if (contents_buf != NULL)
+		  free (contents_buf);
+		return FALSE;
+	      }
 	  }
 	  break;
 	}
+
+      if (contents_buf != NULL)
+	free (contents_buf);
     }
 
   return TRUE;
@@ -10122,6 +11160,7 @@ bfd_elf_final_link (bfd *abfd, struct bfd_link_info *info)
   finfo.symshndxbuf = NULL;
   finfo.symbuf_count = 0;
   finfo.shndxbuf_size = 0;
+  finfo.ahead = NULL;
 
   /* The object attributes have been merged.  Remove the input
      sections from the link, and set the contents of the output
@@ -10544,6 +11583,10 @@ bfd_elf_final_link (bfd *abfd, struct bfd_link_info *info)
 
   for (sub = info->input_bfds; sub != NULL; sub = sub->link_next)
     sub->output_has_begun = FALSE;
+#ifdef HAVE_PTHREAD_H
+  if (info->threads > 1 && bed->elf_backend_relocate_section_ahead != NULL)
+    finfo.ahead = elf_link_ahead_init (&finfo, info->threads);
+#endif
   for (o = abfd->sections; o != NULL; o = o->next)
     {
       for (p = o->map_head.link_order; p != NULL; p = p->next)
@@ -10574,6 +11617,11 @@ bfd_elf_final_link (bfd *abfd, struct bfd_link_info *info)
 	}
     }
 
+#ifdef HAVE_PTHREAD_H
+  elf_link_ahead_free (finfo.ahead);
+  finfo.ahead = NULL;
+#endif
+
   /* Free symbol buffer if needed.  */
   if (!info->reduce_memory_overheads)
     {
@@ -11101,6 +12149,9 @@ bfd_elf_final_link (bfd *abfd, struct bfd_link_info *info)
   return TRUE;
 
  error_return:
+#ifdef HAVE_PTHREAD_H
+  elf_link_ahead_free (finfo.ahead);
+#endif
   if (finfo.symstrtab != NULL)
     _bfd_stringtab_free (finfo.symstrtab);
   if (finfo.contents != NULL)
@@ -47,10 +47,198 @@ SUBSECTION
 #include "sysdep.h"
 #include "bfd.h"
 #include "libbfd.h"
+#include "elf-bfd.h"
+#include "aout/ar.h"
 
 /* IMPORT from targets.c.  */
 extern const size_t _bfd_target_vector_entries;
 
+/* The targets that recognized the last few ELF object files whose
+   target was defaulted, found by the fields of the ELF header that the
+   ELF backends look at to recognize a file: e_ident, e_type, e_machine,
+   e_version and e_flags.  Another such file with the same fields is
+   first offered to the target that recognized the earlier one, and the
+   search of all the targets is skipped if that target accepts it.
+   This matters to programs that open many similar files, such as
+   strip and objcopy run over a directory of objects or an archive.  */
+
+#define FORMAT_CACHE_KEY_SIZE 28
+#define FORMAT_CACHE_SIZE 8
+
+struct format_cache_entry
+{
+  unsigned char key[FORMAT_CACHE_KEY_SIZE];
+  const bfd_target *target;
+};
+
+static struct format_cache_entry format_cache[FORMAT_CACHE_SIZE];
+static unsigned int format_cache_count;
+static unsigned int format_cache_next;
+
+/* The number of bytes at the start of a file that are read to find
+   its cache key and to rule out targets.  This is enough for the
+   fields of an ELF header up to e_flags.  */
+
+#define FORMAT_HEADER_SIZE 52
+
+/* Return TRUE if HEADER starts with the ELF magic number.  */
+
+static bfd_boolean
+format_elf_magic_p (const bfd_byte *header)
+{
+  return (header[EI_MAG0] == ELFMAG0
+	  && header[EI_MAG1] == ELFMAG1
+	  && header[EI_MAG2] == ELFMAG2
+	  && header[EI_MAG3] == ELFMAG3);
+}
+
+/* Set KEY to the cache key of a file starting with the SIZE bytes at
+   HEADER.  Return FALSE if the file does not look like an ELF file.  */
+
+static bfd_boolean
+format_cache_key (const bfd_byte *header, bfd_size_type size,
+		  unsigned char *key)
+{
+  unsigned int flags_offset;
+
+  if (size < FORMAT_HEADER_SIZE
+      || !format_elf_magic_p (header))
+    return FALSE;
+
+  /* e_flags follows e_entry, e_phoff and e_shoff, which are 4 or 8
+     bytes each depending on the class.  */
+  if (header[4] == 1)
+    flags_offset = 36;
+  else if (header[4] == 2)
+    flags_offset = 48;
+  else
+    return FALSE;
+
+  /* e_ident, e_type, e_machine and e_version, then e_flags.  */
+  memcpy (key, header, 24);
+  memcpy (key + 24, header + flags_offset, 4);
+  return TRUE;
+}
+
+/* Return the target that recognized a file with KEY, or NULL.  */
+
+static const bfd_target *
+format_cache_lookup (const unsigned char *key)
+{
+  unsigned int i;
+
+  for (i = 0; i < format_cache_count; i++)
+    if (memcmp (format_cache[i].key, key, FORMAT_CACHE_KEY_SIZE) == 0)
+      return format_cache[i].target;
+  return NULL;
+}
+
+/* Remember that TARGET recognized a file with KEY.  */
+
+static void
+format_cache_add (const unsigned char *key, const bfd_target *target)
+{
+  struct format_cache_entry *entry;
+  unsigned int i;
+
+  for (i = 0; i < format_cache_count; i++)
+    if (memcmp (format_cache[i].key, key, FORMAT_CACHE_KEY_SIZE) == 0)
+      {
+	format_cache[i].target = target;
+	return;
+      }
+
+  entry = &format_cache[format_cache_next];
+  format_cache_next = (format_cache_next + 1) % FORMAT_CACHE_SIZE;
+  if (format_cache_count < FORMAT_CACHE_SIZE)
+    format_cache_count++;
+  memcpy (entry->key, key, FORMAT_CACHE_KEY_SIZE);
+  entry->target = target;
+}
+
+static struct bfd_format_stats format_stats;
+
+/* Return TRUE if TARGET surely does not recognize a file of FORMAT
+   starting with the SIZE bytes at HEADER, so that there is no need to
+   ask it.  This knows just enough of the checks made by ELF targets
+   and archives to be sure, and returns FALSE for everything else.  */
+
+static bfd_boolean
+format_target_excluded (const bfd_target *target, bfd_format format,
+			const bfd_byte *header, bfd_size_type size)
+{
+  bfd_boolean elf;
+
+  if (format == bfd_archive)
+    return (target->_bfd_check_format[bfd_archive] == bfd_generic_archive_p
+	    && (size < SARMAG
+		|| (memcmp (header, ARMAG, SARMAG) != 0
+		    && memcmp (header, ARMAGB, SARMAG) != 0
+		    && memcmp (header, ARMAGT, SARMAG) != 0)));
+
+  if (format != bfd_object)
+    return FALSE;
+
+  /* elf_object_p reads a whole ELF header, at least this much.  */
+  elf = size >= FORMAT_HEADER_SIZE && format_elf_magic_p (header);
+
+  switch (target->flavour)
+    {
+    case bfd_target_elf_flavour:
+      {
+	const struct elf_backend_data *ebd;
+	int machine;
+
+	if (!elf
+	    || header[EI_VERSION] != EV_CURRENT
+	    || (header[EI_DATA] != ELFDATA2MSB
+		&& header[EI_DATA] != ELFDATA2LSB))
+	  return TRUE;
+
+	ebd = xvec_get_elf_backend_data (target);
+	if (header[EI_CLASS] != ebd->s->elfclass
+	    || (header[EI_DATA] == ELFDATA2MSB)
+		!= (target->header_byteorder == BFD_ENDIAN_BIG))
+	  return TRUE;
+
+	if (header[EI_DATA] == ELFDATA2MSB)
+	  {
+	    if (bfd_getb16 (header + 16) == ET_CORE)
+	      return TRUE;
+	    machine = bfd_getb16 (header + 18);
+	  }
+	else
+	  {
+	    if (bfd_getl16 (header + 16) == ET_CORE)
+	      return TRUE;
+	    machine = bfd_getl16 (header + 18);
+	  }
+
+	/* The generic ELF targets take files of any machine, and any
+	   OS/ABI.  */
+	if (ebd->elf_machine_code == EM_NONE)
+	  return FALSE;
+	if (ebd->elf_machine_code != machine
+	    && (ebd->elf_machine_alt1 == 0
+		|| ebd->elf_machine_alt1 != machine)
+	    && (ebd->elf_machine_alt2 == 0
+		|| ebd->elf_machine_alt2 != machine))
+	  return TRUE;
+	return (ebd->elf_osabi != ELFOSABI_NONE
+		&& ebd->elf_osabi != header[EI_OSABI]);
+      }
+
+    case bfd_target_coff_flavour:
+    case bfd_target_ecoff_flavour:
+    case bfd_target_xcoff_flavour:
+      /* No COFF magic number starts with the ELF magic bytes.  */
+      return elf;
+
+    default:
+      return FALSE;
+    }
+}
+
 /*
 FUNCTION
 	bfd_check_format
@@ -124,6 +312,10 @@ bfd_check_format_matches (bfd *abfd, bfd_format format, char ***matching)
   const bfd_target *save_targ, *right_targ, *ar_right_targ;
   int match_count;
   int ar_match_index;
+  bfd_byte header[FORMAT_HEADER_SIZE];
+  bfd_size_type header_size;
+  unsigned char cache_key[FORMAT_CACHE_KEY_SIZE];
+  bfd_boolean use_cache = FALSE;
 
   if (matching != NULL)
     *matching = NULL;
@@ -166,6 +358,7 @@ bfd_check_format_matches (bfd *abfd, bfd_format format, char ***matching)
       if (bfd_seek (abfd, (file_ptr) 0, SEEK_SET) != 0)	/* rewind! */
 	goto err_ret;
 
+      format_stats.probes++;
       right_targ = BFD_SEND_FMT (abfd, _bfd_check_format, (abfd));
 
       if (right_targ)
@@ -187,6 +380,45 @@ bfd_check_format_matches (bfd *abfd, bfd_format format, char ***matching)
 	goto err_unrecog;
     }
 
+  /* Read the start of the file, to rule out targets that cannot
+     recognize it without asking them.  */
+  header_size = 0;
+  if (format == bfd_object || format == bfd_archive)
+    {
+      if (bfd_seek (abfd, (file_ptr) 0, SEEK_SET) != 0)
+	goto err_ret;
+      header_size = bfd_bread (header, sizeof (header), abfd);
+      if (header_size > sizeof (header))
+	header_size = 0;
+    }
+
+  if (abfd->target_defaulted && format == bfd_object)
+    {
+      use_cache = format_cache_key (header, header_size, cache_key);
+      if (use_cache)
+	{
+	  const bfd_target *cached = format_cache_lookup (cache_key);
+
+	  if (cached != NULL)
+	    {
+	      abfd->xvec = cached;
+	      if (bfd_seek (abfd, (file_ptr) 0, SEEK_SET) != 0)
+		goto err_ret;
+	      bfd_set_error (bfd_error_wrong_format);
+	      format_stats.probes++;
+	      right_targ = BFD_SEND_FMT (abfd, _bfd_check_format, (abfd));
+	      if (right_targ)
+		{
+		  format_stats.cache_hits++;
+		  goto ok_ret;
+		}
+	      right_targ = 0;
+	      abfd->xvec = save_targ;
+	    }
+	}
+    }
+
+  format_stats.searches++;
   for (target = bfd_target_vector; *target != NULL; target++)
     {
       const bfd_target *temp;
@@ -197,6 +429,13 @@ bfd_check_format_matches (bfd *abfd, bfd_format format, char ***matching)
 	  || (!abfd->target_defaulted && *target == save_targ))
 	continue;
 
+      if (header_size != 0
+	  && format_target_excluded (*target, format, header, header_size))
+	{
+	  format_stats.skipped++;
+	  continue;
+	}
+
       abfd->xvec = *target;	/* Change BFD's target temporarily.  */
 
       if (bfd_seek (abfd, (file_ptr) 0, SEEK_SET) != 0)
@@ -208,6 +447,7 @@ bfd_check_format_matches (bfd *abfd, bfd_format format, char ***matching)
 	 _bfd_check_format might have this problem.  */
       bfd_set_error (bfd_error_wrong_format);
 
+      format_stats.probes++;
       temp = BFD_SEND_FMT (abfd, _bfd_check_format, (abfd));
 
       if (temp && (abfd->format != bfd_archive || bfd_has_map (abfd)))
@@ -247,8 +487,9 @@ bfd_check_format_matches (bfd *abfd, bfd_format format, char ***matching)
 
   if (match_count == 0)
     {
-      /* Try partial matches.  */
+      /* Try partial matches.  These are not remembered.  */
       right_targ = ar_right_targ;
+      use_cache = FALSE;
 
       if (right_targ == bfd_default_vector[0])
 	{
@@ -287,6 +528,9 @@ bfd_check_format_matches (bfd *abfd, bfd_format format, char ***matching)
 
   if (match_count == 1)
     {
+      if (use_cache)
+	format_cache_add (cache_key, right_targ);
+
     ok_ret:
       abfd->xvec = right_targ;		/* Change BFD's target permanently.  */
 
@@ -334,6 +578,24 @@ bfd_check_format_matches (bfd *abfd, bfd_format format, char ***matching)
   return FALSE;
 }
 
+/*
+FUNCTION
+	bfd_format_get_stats
+
+SYNOPSIS
+	void bfd_format_get_stats (struct bfd_format_stats *stats);
+
+DESCRIPTION
+	Fill in @var{stats} with counts of the work done so far by
+	<<bfd_check_format_matches>> to recognize files.
+*/
+
+void
+bfd_format_get_stats (struct bfd_format_stats *stats)
+{
+  *stats = format_stats;
+}
+
 /*
 FUNCTION
 	bfd_set_format
@@ -610,6 +610,22 @@ extern bfd_boolean _bfd_write_merged_section
 extern bfd_vma _bfd_merged_section_offset
   (bfd *, asection **, void *, bfd_vma);
 
+/* A string to be sorted by _bfd_sort_string_suffixes.  The string is
+   the LEN bytes before END, and ENTRY is for the caller's use.  */
+
+struct bfd_suffix_sort_key
+{
+  const unsigned char *end;
+  unsigned int len;
+  void *entry;
+};
+
+/* Sort distinct strings so that strings ending in the same bytes are
+   adjacent, and each string comes just before any it is a suffix of.  */
+
+extern void _bfd_sort_string_suffixes
+  (struct bfd_suffix_sort_key *, size_t);
+
 /* Create a string table.  */
 extern struct bfd_strtab_hash *_bfd_stringtab_init
   (void);
@@ -790,6 +806,11 @@ bfd_boolean bfd_cache_init (bfd *abfd);
 
 bfd_boolean bfd_cache_close (bfd *abfd);
 
+bfd_boolean bfd_cache_shrink (void);
+
+const bfd_byte *bfd_cache_map_view
+   (bfd *abfd, file_ptr offset, bfd_size_type size);
+
 FILE* bfd_open_file (bfd *abfd);
 
 /* Extracted from reloc.c.  */
@@ -94,8 +94,11 @@ struct sec_merge_sec_info
   struct sec_merge_hash *htab;
   /* First string in this section.  */
   struct sec_merge_hash_entry *first_str;
-  /* Original section content.  */
-  unsigned char contents[1];
+  /* Original section content.  This is either a view of the input
+     file, which must not be written, or COPY.  */
+  unsigned char *contents;
+  /* A copy of the section content, if no view was available.  */
+  unsigned char copy[1];
 };
 
 
@@ -348,6 +351,7 @@ _bfd_add_merge_section (bfd *abfd, void **psinfo, asection *sec,
   struct sec_merge_sec_info *secinfo;
   unsigned int align;
   bfd_size_type amt;
+  const bfd_byte *view;
 
   if ((abfd->flags & DYNAMIC) != 0
       || (sec->flags & SEC_MERGE) == 0)
@@ -403,14 +407,36 @@ _bfd_add_merge_section (bfd *abfd, void **psinfo, asection *sec,
 	goto error_return;
     }
 
-  /* Read the section from abfd.  */
+  /* Use the section contents in place if possible, rather than
+     reading them from abfd.  */
 
-  amt = sizeof (struct sec_merge_sec_info) - 1 + sec->size;
-  if (sec->flags & SEC_STRINGS)
-    /* Some versions of gcc may emit a string without a zero terminator.
-       See http://gcc.gnu.org/ml/gcc-patches/2006-06/msg01004.html
-       Allocate space for an extra zero.  */
-    amt += sec->entsize;
+  view = bfd_section_contents_view (sec->owner, sec);
+  if (view != NULL && sec->rawsize != 0 && sec->rawsize < sec->size)
+    view = NULL;
+  if (view != NULL && (sec->flags & SEC_STRINGS))
+    {
+      /* Some versions of gcc may emit a string without a zero
+	 terminator.  Such a section needs a copy with an extra zero.  */
+      unsigned int i;
+
+      for (i = 0; i < sec->entsize; i++)
+	if (view[sec->size - 1 - i] != 0)
+	  {
+	    view = NULL;
+	    break;
+	  }
+    }
+
+  amt = sizeof (struct sec_merge_sec_info) - 1;
+  if (view == NULL)
+    {
+      amt += sec->size;
+      if (sec->flags & SEC_STRINGS)
+	/* Some versions of gcc may emit a string without a zero terminator.
+	   See http://gcc.gnu.org/ml/gcc-patches/2006-06/msg01004.html
+	   Allocate space for an extra zero.  */
+	amt += sec->entsize;
+    }
   *psecinfo = bfd_alloc (abfd, amt);
   if (*psecinfo == NULL)
     goto error_return;
@@ -430,11 +456,17 @@ _bfd_add_merge_section (bfd *abfd, void **psinfo, asection *sec,
   secinfo->first_str = NULL;
 
   sec->rawsize = sec->size;
-  if (sec->flags & SEC_STRINGS)
-    memset (secinfo->contents + sec->size, 0, sec->entsize);
-  if (! bfd_get_section_contents (sec->owner, sec, secinfo->contents,
-				  0, sec->size))
-    goto error_return;
+  if (view != NULL)
+    secinfo->contents = (unsigned char *) view;
+  else
+    {
+      secinfo->contents = secinfo->copy;
+      if (sec->flags & SEC_STRINGS)
+	memset (secinfo->contents + sec->size, 0, sec->entsize);
+      if (! bfd_get_section_contents (sec->owner, sec, secinfo->contents,
+				      0, sec->size))
+	goto error_return;
+    }
 
   return TRUE;
 
@@ -527,16 +559,33 @@ error_return:
   return FALSE;
 }
 
+/* The byte DEPTH bytes back from the end of K's string, or -1 once the
+   string is exhausted, so that a string sorts before any it is a
+   suffix of.  */
+#define SUFFIX_KEY(k, depth) \
+  ((depth) < (k)->len ? (int) (k)->end[-1 - (bfd_signed_vma) (depth)] : -1)
+
+static inline void
+suffix_sort_swap (struct bfd_suffix_sort_key *a, struct bfd_suffix_sort_key *b)
+{
+  struct bfd_suffix_sort_key t = *a;
+  *a = *b;
+  *b = t;
+}
+
+/* Compare two reversed strings known to agree in their last DEPTH
+   bytes.  */
+
 static int
-strrevcmp (const void *a, const void *b)
+suffix_sort_cmp (const struct bfd_suffix_sort_key *a,
+		 const struct bfd_suffix_sort_key *b,
+		 unsigned int depth)
 {
-  struct sec_merge_hash_entry *A = *(struct sec_merge_hash_entry **) a;
-  struct sec_merge_hash_entry *B = *(struct sec_merge_hash_entry **) b;
-  unsigned int lenA = A->len;
-  unsigned int lenB = B->len;
-  const unsigned char *s = (const unsigned char *) A->root.string + lenA - 1;
-  const unsigned char *t = (const unsigned char *) B->root.string + lenB - 1;
-  int l = lenA < lenB ? lenA : lenB;
+  unsigned int lenA = a->len;
+  unsigned int lenB = b->len;
+  const unsigned char *s = a->end - 1 - depth;
+  const unsigned char *t = b->end - 1 - depth;
+  unsigned int l = (lenA < lenB ? lenA : lenB) - depth;
 
   while (l)
     {
@@ -546,36 +595,120 @@ strrevcmp (const void *a, const void *b)
       t--;
       l--;
     }
-  return lenA - lenB;
+  return lenA < lenB ? -1 : lenA > lenB;
 }
 
-/* Like strrevcmp, but for the case where all strings have the same
-   alignment > entsize.  */
+/* This is a multikey quicksort on the reversed strings: each pass
+   partitions on a single byte, so shared tails are only scanned once
+   instead of on every comparison as qsort with strrevcmp would.  */
 
-static int
-strrevcmp_align (const void *a, const void *b)
+static void
+sort_suffixes (struct bfd_suffix_sort_key *keys, size_t n, unsigned int depth)
 {
-  struct sec_merge_hash_entry *A = *(struct sec_merge_hash_entry **) a;
-  struct sec_merge_hash_entry *B = *(struct sec_merge_hash_entry **) b;
-  unsigned int lenA = A->len;
-  unsigned int lenB = B->len;
-  const unsigned char *s = (const unsigned char *) A->root.string + lenA - 1;
-  const unsigned char *t = (const unsigned char *) B->root.string + lenB - 1;
-  int l = lenA < lenB ? lenA : lenB;
-  int tail_align = (lenA & (A->alignment - 1)) - (lenB & (A->alignment - 1));
-
-  if (tail_align != 0)
-    return tail_align;
-
-  while (l)
+  while (n > 1)
     {
-      if (*s != *t)
-	return (int) *s - (int) *t;
-      s--;
-      t--;
-      l--;
+      size_t lt, gt, i, nlt, ngt;
+      int a, b, c, v;
+
+      if (n < 16)
+	{
+	  for (i = 1; i < n; i++)
+	    {
+	      size_t j;
+
+	      for (j = i;
+		   j > 0 && suffix_sort_cmp (&keys[j - 1], &keys[j], depth) > 0;
+		   j--)
+		suffix_sort_swap (&keys[j - 1], &keys[j]);
+	    }
+	  return;
+	}
+
+      /* Median of three for the pivot byte.  */
+      a = SUFFIX_KEY (&keys[0], depth);
+      b = SUFFIX_KEY (&keys[n / 2], depth);
+      c = SUFFIX_KEY (&keys[n - 1], depth);
+      if (a > b)
+	v = a, a = b, b = v;
+      v = c < a ? a : c > b ? b : c;
+
+      /* Partition into [0,lt) < v, [lt,gt) == v, [gt,n) > v.  */
+      lt = i = 0;
+      gt = n;
+      while (i < gt)
+	{
+	  c = SUFFIX_KEY (&keys[i], depth);
+	  if (c < v)
+	    suffix_sort_swap (&keys[lt++], &keys[i++]);
+	  else if (c > v)
+	    suffix_sort_swap (&keys[i], &keys[--gt]);
+	  else
+	    i++;
+	}
+
+      /* Recurse on the smaller parts and iterate on the largest, to
+	 keep the stack shallow.  Strings equal to the end are already
+	 in place, there being at most one of them.  */
+      nlt = lt;
+      ngt = n - gt;
+      if (v < 0)
+	{
+	  if (nlt < ngt)
+	    {
+	      sort_suffixes (keys, nlt, depth);
+	      keys += gt;
+	      n = ngt;
+	    }
+	  else
+	    {
+	      sort_suffixes (keys + gt, ngt, depth);
+	      n = nlt;
+	    }
+	  continue;
+	}
+
+      if (gt - lt >= nlt && gt - lt >= ngt)
+	{
+	  sort_suffixes (keys, nlt, depth);
+	  sort_suffixes (keys + gt, ngt, depth);
+	  keys += lt;
+	  n = gt - lt;
+	  depth++;
+	}
+      else if (nlt >= ngt)
+	{
+	  sort_suffixes (keys + lt, gt - lt, depth + 1);
+	  sort_suffixes (keys + gt, ngt, depth);
+	  n = nlt;
+	}
+      else
+	{
+	  sort_suffixes (keys, nlt, depth);
+	  sort_suffixes (keys + lt, gt - lt, depth + 1);
+	  keys += gt;
+	  n = ngt;
+	}
     }
-  return lenA - lenB;
+}
+
+void
+_bfd_sort_string_suffixes (struct bfd_suffix_sort_key *keys, size_t n)
+{
+  sort_suffixes (keys, n, 0);
+}
+
+/* Order strings that all have the same alignment > entsize by their
+   length modulo the alignment.  */
+
+static int
+tailcmp (const void *a, const void *b)
+{
+  const struct bfd_suffix_sort_key *A = (const struct bfd_suffix_sort_key *) a;
+  const struct bfd_suffix_sort_key *B = (const struct bfd_suffix_sort_key *) b;
+  unsigned int mask
+    = ((struct sec_merge_hash_entry *) A->entry)->alignment - 1;
+
+  return (int) (A->len & mask) - (int) (B->len & mask);
 }
 
 static inline int
@@ -596,23 +729,27 @@ is_suffix (const struct sec_merge_hash_entry *A,
 static void
 merge_strings (struct sec_merge_info *sinfo)
 {
-  struct sec_merge_hash_entry **array, **a, *e;
+  struct bfd_suffix_sort_key *array, *k;
+  struct sec_merge_hash_entry **a, *e;
   struct sec_merge_sec_info *secinfo;
   bfd_size_type size, amt;
   unsigned int alignment = 0;
 
   /* Now sort the strings */
-  amt = sinfo->htab->size * sizeof (struct sec_merge_hash_entry *);
-  array = (struct sec_merge_hash_entry **) bfd_malloc (amt);
+  amt = sinfo->htab->size * sizeof (struct bfd_suffix_sort_key);
+  array = (struct bfd_suffix_sort_key *) bfd_malloc (amt);
   if (array == NULL)
     goto alloc_failure;
 
-  for (e = sinfo->htab->first, a = array; e; e = e->next)
+  for (e = sinfo->htab->first, k = array; e; e = e->next)
     if (e->alignment)
       {
-	*a++ = e;
 	/* Adjust the length to not include the zero terminator.  */
 	e->len -= sinfo->htab->entsize;
+	k->end = (const unsigned char *) e->root.string + e->len;
+	k->len = e->len;
+	k->entry = e;
+	k++;
 	if (alignment != e->alignment)
 	  {
 	    if (alignment == 0)
@@ -622,20 +759,37 @@ merge_strings (struct sec_merge_info *sinfo)
 	  }
       }
 
-  sinfo->htab->size = a - array;
+  sinfo->htab->size = k - array;
   if (sinfo->htab->size != 0)
     {
-      qsort (array, (size_t) sinfo->htab->size,
-	     sizeof (struct sec_merge_hash_entry *),
-	     (alignment != (unsigned) -1 && alignment > sinfo->htab->entsize
-	      ? strrevcmp_align : strrevcmp));
+      if (alignment != (unsigned) -1 && alignment > sinfo->htab->entsize)
+	{
+	  struct bfd_suffix_sort_key *run;
+
+	  /* All strings have the same alignment > entsize.  Only strings
+	     whose lengths agree modulo the alignment can be merged, so
+	     group them by that first and sort each group.  */
+	  qsort (array, (size_t) sinfo->htab->size,
+		 sizeof (struct bfd_suffix_sort_key), tailcmp);
+	  for (run = array; run < k; )
+	    {
+	      struct bfd_suffix_sort_key *next = run + 1;
+
+	      while (next < k && tailcmp (run, next) == 0)
+		next++;
+	      _bfd_sort_string_suffixes (run, next - run);
+	      run = next;
+	    }
+	}
+      else
+	_bfd_sort_string_suffixes (array, (size_t) sinfo->htab->size);
 
       /* Loop over the sorted array and merge suffixes */
-      e = *--a;
+      e = (--k)->entry;
       e->len += sinfo->htab->entsize;
-      while (--a >= array)
+      while (--k >= array)
 	{
-	  struct sec_merge_hash_entry *cmp = *a;
+	  struct sec_merge_hash_entry *cmp = k->entry;
 
 	  cmp->len += sinfo->htab->entsize;
 	  if (e->alignment >= cmp->alignment
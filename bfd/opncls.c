@@ -200,7 +200,9 @@ bfd_fopen (const char *filename, const char *target, const char *mode, int fd)
     nbfd->iostream = fdopen (fd, mode);
   else
 #endif
-    nbfd->iostream = real_fopen (filename, mode);
+    do
+      nbfd->iostream = real_fopen (filename, mode);
+    while (nbfd->iostream == NULL && bfd_cache_shrink ());
   if (nbfd->iostream == NULL)
     {
       bfd_set_error (bfd_error_system_call);
@@ -1503,6 +1503,80 @@ bfd_malloc_and_get_section (bfd *abfd, sec_ptr sec, bfd_byte **buf)
 
   return bfd_get_section_contents (abfd, sec, p, 0, sz);
 }
+
+/*
+FUNCTION
+	bfd_section_contents_view
+
+SYNOPSIS
+	const bfd_byte *bfd_section_contents_view
+	  (bfd *abfd, asection *section);
+
+DESCRIPTION
+	Return a pointer to the contents of @var{section} in BFD
+	@var{abfd} as they would be read by <<bfd_get_section_contents>>,
+	without copying them, or NULL if that is not possible.  A view
+	is available when the contents are already held in memory, or
+	when the file cache has mapped @var{abfd}'s file and the target
+	reads section contents straight from the file.
+
+	The contents must not be written through the view.  A view of
+	the file stays valid until @var{abfd} is closed.
+*/
+
+const bfd_byte *
+bfd_section_contents_view (bfd *abfd, sec_ptr section)
+{
+  bfd_size_type sz = section->rawsize ? section->rawsize : section->size;
+
+  if (sz == 0
+      || (section->flags & SEC_HAS_CONTENTS) == 0
+      || (section->flags & SEC_CONSTRUCTOR) != 0)
+    return NULL;
+
+  if ((section->flags & SEC_IN_MEMORY) != 0)
+    return section->contents;
+
+  if (abfd->xvec->_bfd_get_section_contents
+      != _bfd_generic_get_section_contents)
+    return NULL;
+
+  return bfd_cache_map_view (abfd, section->filepos, sz);
+}
+
+/*
+FUNCTION
+	bfd_map_section_contents
+
+SYNOPSIS
+	bfd_boolean bfd_map_section_contents
+	  (bfd *abfd, asection *section, const bfd_byte **view,
+	   bfd_byte **buf);
+
+DESCRIPTION
+	Set *@var{view} to the contents of @var{section} in BFD
+	@var{abfd}, using <<bfd_section_contents_view>> if possible and
+	setting *@var{buf} to NULL.  Otherwise the contents are read into
+	a buffer malloc'd by this function, returned in both *@var{view}
+	and *@var{buf}, which the caller should free when done with
+	*@var{view}.
+*/
+
+bfd_boolean
+bfd_map_section_contents (bfd *abfd, sec_ptr sec, const bfd_byte **view,
+			  bfd_byte **buf)
+{
+  *view = bfd_section_contents_view (abfd, sec);
+  *buf = NULL;
+  if (*view != NULL)
+    return TRUE;
+
+  if (!bfd_malloc_and_get_section (abfd, sec, buf))
+    return FALSE;
+  *view = *buf;
+  return TRUE;
+}
+
 /*
 FUNCTION
 	bfd_copy_private_section_data
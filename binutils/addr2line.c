@@ -35,22 +35,35 @@
 #include "bfd.h"
 #include "getopt.h"
 #include "libiberty.h"
+#include "hashtab.h"
 #include "demangle.h"
 #include "bucomm.h"
+#include <sys/stat.h>
 
 static bfd_boolean unwind_inlines;	/* -i, unwind inlined functions. */
 static bfd_boolean with_functions;	/* -f, show function names.  */
 static bfd_boolean do_demangle;		/* -C, demangle names.  */
 static bfd_boolean base_names;		/* -s, strip directory names.  */
+static bfd_boolean batch_mode;		/* --batch, translate all at once.  */
+static const char *cache_name;		/* --cache, translation cache file.  */
 
 static int naddr;		/* Number of addresses to process.  */
 static char **addr;		/* Hex addresses to process.  */
 
 static asymbol **syms;		/* Symbol table.  */
+static bfd_boolean syms_read;	/* Whether slurp_symtab has run.  */
+
+enum option_values
+  {
+    OPTION_BATCH = 150,
+    OPTION_CACHE
+  };
 
 static struct option long_options[] =
 {
   {"basenames", no_argument, NULL, 's'},
+  {"batch", no_argument, NULL, OPTION_BATCH},
+  {"cache", optional_argument, NULL, OPTION_CACHE},
   {"demangle", optional_argument, NULL, 'C'},
   {"exe", required_argument, NULL, 'e'},
   {"functions", no_argument, NULL, 'f'},
@@ -67,6 +80,7 @@ static void slurp_symtab (bfd *);
 static void find_address_in_section (bfd *, asection *, void *);
 static void find_offset_in_section (bfd *, asection *);
 static void translate_addresses (bfd *, asection *);
+static void translate_batch (bfd *, asection *, const char *);
 
 /* Print a usage message to STREAM and exit with STATUS.  */
 
@@ -85,6 +99,9 @@ usage (FILE *stream, int status)
   -s --basenames         Strip directory names\n\
   -f --functions         Show function names\n\
   -C --demangle[=style]  Demangle function names\n\
+     --batch             Translate all the addresses at once\n\
+     --cache[=<file>]    Reuse and save translations in <file> (default\n\
+                          <executable>.a2l); implies --batch\n\
   -h --help              Display this information\n\
   -v --version           Display the program's version\n\
 \n"));
@@ -104,6 +121,7 @@ slurp_symtab (bfd *abfd)
   long symcount;
   bfd_boolean dynamic = FALSE;
 
+  syms_read = TRUE;
   if ((bfd_get_file_flags (abfd) & HAS_SYMS) == 0)
     return;
 
@@ -183,6 +201,98 @@ find_offset_in_section (bfd *abfd, asection *section)
 				 &filename, &functionname, &line);
 }
 
+/* Text printed for one or more addresses.  */
+
+struct text_buf
+{
+  char *text;
+  size_t len;
+  size_t alloc;
+};
+
+static void
+text_buf_add (struct text_buf *buf, const char *str, size_t len)
+{
+  if (buf->len + len > buf->alloc)
+    {
+      buf->alloc = 2 * (buf->len + len) + 256;
+      buf->text = (char *) xrealloc (buf->text, buf->alloc);
+    }
+  memcpy (buf->text + buf->len, str, len);
+  buf->len += len;
+}
+
+static void
+text_buf_add_string (struct text_buf *buf, const char *str)
+{
+  text_buf_add (buf, str, strlen (str));
+}
+
+/* Translate PC into file_name:line_number and optionally function
+   name, appending the lines to print for it to BUF.  */
+
+static void
+translate_address (bfd *abfd, asection *section, struct text_buf *buf)
+{
+  found = FALSE;
+  if (section)
+    find_offset_in_section (abfd, section);
+  else
+    bfd_map_over_sections (abfd, find_address_in_section, NULL);
+
+  if (! found)
+    {
+      if (with_functions)
+	text_buf_add_string (buf, "??\n");
+      text_buf_add_string (buf, "??:0\n");
+    }
+  else
+    {
+      do {
+	char num[32];
+
+	if (with_functions)
+	  {
+	    const char *name;
+	    char *alloc = NULL;
+
+	    name = functionname;
+	    if (name == NULL || *name == '\0')
+	      name = "??";
+	    else if (do_demangle)
+	      {
+		alloc = bfd_demangle (abfd, name, DMGL_ANSI | DMGL_PARAMS);
+		if (alloc != NULL)
+		  name = alloc;
+	      }
+
+	    text_buf_add_string (buf, name);
+	    text_buf_add_string (buf, "\n");
+
+	    if (alloc != NULL)
+	      free (alloc);
+	  }
+
+	if (base_names && filename != NULL)
+	  {
+	    char *h;
+
+	    h = strrchr (filename, '/');
+	    if (h != NULL)
+	      filename = h + 1;
+	  }
+
+	text_buf_add_string (buf, filename ? filename : "??");
+	sprintf (num, ":%u\n", line);
+	text_buf_add_string (buf, num);
+	if (!unwind_inlines)
+	  found = FALSE;
+	else
+	  found = bfd_find_inliner_info (abfd, &filename, &functionname, &line);
+      } while (found);
+    }
+}
+
 /* Read hexadecimal addresses from stdin, translate into
    file_name:line_number and optionally function name.  */
 
@@ -190,7 +300,9 @@ static void
 translate_addresses (bfd *abfd, asection *section)
 {
   int read_stdin = (naddr == 0);
+  struct text_buf out;
 
+  memset (&out, 0, sizeof (out));
   for (;;)
     {
       if (read_stdin)
@@ -209,66 +321,378 @@ translate_addresses (bfd *abfd, asection *section)
 	  pc = bfd_scan_vma (*addr++, NULL, 16);
 	}
 
-      found = FALSE;
-      if (section)
-	find_offset_in_section (abfd, section);
-      else
-	bfd_map_over_sections (abfd, find_address_in_section, NULL);
+      out.len = 0;
+      translate_address (abfd, section, &out);
+      fwrite (out.text, 1, out.len, stdout);
+
+      /* fflush() is essential for using this command as a server
+         child process that reads addresses from a pipe and responds
+         with line number information, processing one address at a
+         time.  */
+      fflush (stdout);
+    }
+
+  free (out.text);
+}
+
+/* The translation cache.  It maps each address to the text printed
+   for it, and is only valid for the same executable and options.  */
+
+struct cache_entry
+{
+  bfd_vma pc;
+  const char *text;
+  size_t len;
+};
+
+static htab_t cache_table;
+static char *cache_text;		/* Contents of the cache file.  */
+static struct cache_entry *cache_entries;	/* Entries read from it.  */
+static bfd_boolean cache_dirty;		/* Whether it needs rewriting.  */
+
+static hashval_t
+cache_entry_hash (const void *p)
+{
+  const struct cache_entry *entry = (const struct cache_entry *) p;
+
+  return iterative_hash_object (entry->pc, 0);
+}
+
+static int
+cache_entry_eq (const void *p1, const void *p2)
+{
+  const struct cache_entry *e1 = (const struct cache_entry *) p1;
+  const struct cache_entry *e2 = (const struct cache_entry *) p2;
+
+  return e1->pc == e2->pc;
+}
+
+/* Return the first line of a cache file for FILE_NAME read as TARGET,
+   recording what the cached text depends on, or NULL if FILE_NAME
+   can't be stat'd.  */
+
+static char *
+cache_header (const char *file_name, const char *section_name,
+	      const char *target)
+{
+  struct stat statbuf;
+  char *header;
+
+  if (stat (file_name, &statbuf) != 0)
+    return NULL;
+
+  if (section_name == NULL)
+    section_name = "-";
+  if (target == NULL)
+    target = "-";
+  header = (char *) xmalloc (strlen (section_name) + strlen (target) + 100);
+  sprintf (header, "addr2line cache 2 %ld %ld %c%c%c%c%d %s %s\n",
+	   (long) statbuf.st_size, (long) statbuf.st_mtime,
+	   with_functions ? 'f' : '-', unwind_inlines ? 'i' : '-',
+	   do_demangle ? 'C' : '-', base_names ? 's' : '-',
+	   (int) current_demangling_style, section_name, target);
+  return header;
+}
+
+/* Read the cache file into cache_table.  A missing, stale or damaged
+   file just means starting from an empty cache.  */
+
+static void
+load_cache (const char *header)
+{
+  FILE *f;
+  size_t size, alloc, got, count;
+  char *p, *end;
+
+  cache_table = htab_create (1024, cache_entry_hash, cache_entry_eq, NULL);
+  cache_dirty = TRUE;
 
-      if (! found)
+  f = fopen (cache_name, FOPEN_RB);
+  if (f == NULL)
+    return;
+
+  size = 0;
+  alloc = 65536;
+  cache_text = (char *) xmalloc (alloc + 1);
+  while ((got = fread (cache_text + size, 1, alloc - size, f)) > 0)
+    {
+      size += got;
+      if (size == alloc)
 	{
-	  if (with_functions)
-	    printf ("??\n");
-	  printf ("??:0\n");
+	  alloc *= 2;
+	  cache_text = (char *) xrealloc (cache_text, alloc + 1);
 	}
-      else
+    }
+  fclose (f);
+  cache_text[size] = '\0';
+
+  if (size < strlen (header)
+      || strncmp (cache_text, header, strlen (header)) != 0)
+    return;
+
+  /* Each entry is a line "ADDRESS LENGTH" followed by LENGTH bytes of
+     text.  Count them first so that the entries can be one array.  */
+  end = cache_text + size;
+  count = 0;
+  for (p = cache_text + strlen (header); p < end; p++)
+    if (*p == '\n')
+      count++;
+  cache_entries = (struct cache_entry *)
+    xmalloc ((count + 1) * sizeof (struct cache_entry));
+
+  count = 0;
+  p = cache_text + strlen (header);
+  while (p < end)
+    {
+      struct cache_entry *entry = &cache_entries[count];
+      unsigned long len;
+      void **slot;
+
+      entry->pc = bfd_scan_vma (p, (const char **) &p, 16);
+      if (*p != ' ')
+	return;
+      len = strtoul (p + 1, &p, 10);
+      if (*p != '\n' || len > (size_t) (end - p - 1))
+	return;
+      entry->text = p + 1;
+      entry->len = len;
+      p += 1 + len;
+
+      slot = htab_find_slot (cache_table, entry, INSERT);
+      if (slot == NULL)
+	return;
+      *slot = entry;
+      count++;
+    }
+
+  cache_dirty = FALSE;
+}
+
+static int
+write_cache_entry (void **slot, void *data)
+{
+  const struct cache_entry *entry = (const struct cache_entry *) *slot;
+  FILE *f = (FILE *) data;
+  char buf[30];
+
+  sprintf_vma (buf, entry->pc);
+  fprintf (f, "%s %lu\n", buf, (unsigned long) entry->len);
+  fwrite (entry->text, 1, entry->len, f);
+  return 1;
+}
+
+/* Rewrite the cache file from cache_table.  The new contents go to a
+   temporary file which replaces the old one, so that concurrent
+   readers never see a partly written cache.  */
+
+static void
+save_cache (const char *header)
+{
+  char *tmpname;
+  FILE *f;
+  bfd_boolean ok;
+
+  tmpname = make_tempname (cache_name);
+  if (tmpname == NULL
+      || (f = fopen (tmpname, FOPEN_WB)) == NULL)
+    {
+      non_fatal (_("could not create temporary file for %s: %s"),
+		 cache_name, strerror (errno));
+      if (tmpname != NULL)
+	free (tmpname);
+      return;
+    }
+
+  fputs (header, f);
+  htab_traverse (cache_table, write_cache_entry, f);
+  ok = !ferror (f);
+  if (fclose (f) != 0)
+    ok = FALSE;
+  if (!ok || rename (tmpname, cache_name) != 0)
+    {
+      non_fatal (_("could not update %s: %s"), cache_name, strerror (errno));
+      unlink (tmpname);
+    }
+  free (tmpname);
+}
+
+/* An address to translate in batch mode, and where it was read.  */
+
+struct batch_addr
+{
+  bfd_vma pc;
+  size_t index;
+};
+
+/* Where the text for one address was put in the output buffer.  */
+
+struct batch_result
+{
+  size_t start;
+  size_t len;
+};
+
+static int
+compare_batch_addr (const void *a, const void *b)
+{
+  const struct batch_addr *aa = (const struct batch_addr *) a;
+  const struct batch_addr *bb = (const struct batch_addr *) b;
+
+  if (aa->pc != bb->pc)
+    return aa->pc < bb->pc ? -1 : 1;
+  if (aa->index != bb->index)
+    return aa->index < bb->index ? -1 : 1;
+  return 0;
+}
+
+/* Read all the addresses to translate, from the command line or else
+   from stdin, returning their count in *COUNTP.  */
+
+static struct batch_addr *
+read_batch_addresses (size_t *countp)
+{
+  struct batch_addr *addrs;
+  size_t count = 0;
+
+  if (naddr > 0)
+    {
+      addrs = (struct batch_addr *) xmalloc (naddr * sizeof (*addrs));
+      for (; count < (size_t) naddr; count++)
 	{
-	  do {
-	    if (with_functions)
-	      {
-		const char *name;
-		char *alloc = NULL;
+	  addrs[count].pc = bfd_scan_vma (addr[count], NULL, 16);
+	  addrs[count].index = count;
+	}
+    }
+  else
+    {
+      size_t size = 0, alloc = 65536, got, lines = 0;
+      char *text, *p, *end;
 
-		name = functionname;
-		if (name == NULL || *name == '\0')
-		  name = "??";
-		else if (do_demangle)
-		  {
-		    alloc = bfd_demangle (abfd, name, DMGL_ANSI | DMGL_PARAMS);
-		    if (alloc != NULL)
-		      name = alloc;
-		  }
+      /* Read stdin in large blocks rather than a line at a time.  */
+      text = (char *) xmalloc (alloc + 1);
+      while ((got = fread (text + size, 1, alloc - size, stdin)) > 0)
+	{
+	  size += got;
+	  if (size == alloc)
+	    {
+	      alloc *= 2;
+	      text = (char *) xrealloc (text, alloc + 1);
+	    }
+	}
+      text[size] = '\0';
+      end = text + size;
 
-		printf ("%s\n", name);
+      for (p = text; p < end; p++)
+	if (*p == '\n')
+	  lines++;
+      addrs = (struct batch_addr *) xmalloc ((lines + 1) * sizeof (*addrs));
 
-		if (alloc != NULL)
-		  free (alloc);
-	      }
+      for (p = text; p < end; )
+	{
+	  char *nl = (char *) memchr (p, '\n', end - p);
 
-	    if (base_names && filename != NULL)
-	      {
-		char *h;
+	  addrs[count].pc = bfd_scan_vma (p, NULL, 16);
+	  addrs[count].index = count;
+	  count++;
+	  p = nl != NULL ? nl + 1 : end;
+	}
+      free (text);
+    }
 
-		h = strrchr (filename, '/');
-		if (h != NULL)
-		  filename = h + 1;
-	      }
+  *countp = count;
+  return addrs;
+}
 
-	    printf ("%s:%u\n", filename ? filename : "??", line);
-	    if (!unwind_inlines)
-	      found = FALSE;
-	    else
-	      found = bfd_find_inliner_info (abfd, &filename, &functionname, &line);
-	  } while (found);
+/* Translate all the addresses at once.  They are looked up in address
+   order, so that each compilation unit's debug info is decoded and
+   used in turn, and each distinct address is looked up only once.
+   The results are printed in the original order.  */
 
+static void
+translate_batch (bfd *abfd, asection *section, const char *header)
+{
+  struct batch_addr *addrs;
+  struct batch_result *results;
+  struct cache_entry *new_entries = NULL;
+  size_t *new_results = NULL;
+  size_t count, new_count, i;
+  struct text_buf out;
+
+  addrs = read_batch_addresses (&count);
+  qsort (addrs, count, sizeof (*addrs), compare_batch_addr);
+
+  results = (struct batch_result *) xmalloc (count * sizeof (*results) + 1);
+  if (cache_table != NULL)
+    {
+      new_entries = (struct cache_entry *)
+	xmalloc (count * sizeof (*new_entries) + 1);
+      new_results = (size_t *) xmalloc (count * sizeof (*new_results) + 1);
+    }
+  new_count = 0;
+
+  memset (&out, 0, sizeof (out));
+  for (i = 0; i < count; i++)
+    {
+      struct batch_result *result = &results[addrs[i].index];
+      struct cache_entry *entry = NULL;
+
+      if (i > 0 && addrs[i].pc == addrs[i - 1].pc)
+	{
+	  *result = results[addrs[i - 1].index];
+	  continue;
 	}
 
-      /* fflush() is essential for using this command as a server
-         child process that reads addresses from a pipe and responds
-         with line number information, processing one address at a
-         time.  */
-      fflush (stdout);
+      pc = addrs[i].pc;
+      result->start = out.len;
+      if (cache_table != NULL)
+	{
+	  struct cache_entry key;
+
+	  key.pc = pc;
+	  entry = (struct cache_entry *) htab_find (cache_table, &key);
+	}
+      if (entry != NULL)
+	text_buf_add (&out, entry->text, entry->len);
+      else
+	{
+	  /* The symbols are only needed if something isn't cached.  */
+	  if (!syms_read)
+	    slurp_symtab (abfd);
+	  translate_address (abfd, section, &out);
+	  if (new_results != NULL)
+	    {
+	      new_entries[new_count].pc = pc;
+	      new_results[new_count++] = addrs[i].index;
+	    }
+	}
+      result->len = out.len - result->start;
+    }
+
+  for (i = 0; i < count; i++)
+    fwrite (out.text + results[i].start, 1, results[i].len, stdout);
+  fflush (stdout);
+
+  if (cache_table != NULL && (new_count != 0 || cache_dirty))
+    {
+      for (i = 0; i < new_count; i++)
+	{
+	  struct cache_entry *entry = &new_entries[i];
+	  void **slot;
+
+	  entry->text = out.text + results[new_results[i]].start;
+	  entry->len = results[new_results[i]].len;
+	  slot = htab_find_slot (cache_table, entry, INSERT);
+	  if (slot != NULL)
+	    *slot = entry;
+	}
+      save_cache (header);
     }
+
+  free (new_results);
+  free (new_entries);
+  free (out.text);
+  free (results);
+  free (addrs);
 }
 
 /* Process a file.  Returns an exit value for main().  */
@@ -311,15 +735,45 @@ process_file (const char *file_name, const char *section_name,
   else
     section = NULL;
 
-  slurp_symtab (abfd);
+  if (batch_mode)
+    {
+      char *header = NULL;
 
-  translate_addresses (abfd, section);
+      if (cache_name != NULL)
+	{
+	  header = cache_header (file_name, section_name, target);
+	  if (header == NULL)
+	    bfd_fatal (file_name);
+	  load_cache (header);
+	}
+
+      translate_batch (abfd, section, header);
+
+      if (cache_table != NULL)
+	{
+	  htab_delete (cache_table);
+	  cache_table = NULL;
+	  free (cache_entries);
+	  cache_entries = NULL;
+	  free (cache_text);
+	  cache_text = NULL;
+	}
+      if (header != NULL)
+	free (header);
+    }
+  else
+    {
+      slurp_symtab (abfd);
+
+      translate_addresses (abfd, section);
+    }
 
   if (syms != NULL)
     {
       free (syms);
       syms = NULL;
     }
+  syms_read = FALSE;
 
   bfd_close (abfd);
 
@@ -332,6 +786,7 @@ main (int argc, char **argv)
   const char *file_name;
   const char *section_name;
   char *target;
+  bfd_boolean cache_requested = FALSE;
   int c;
 
 #if defined (HAVE_SETLOCALE) && defined (HAVE_LC_MESSAGES)
@@ -401,6 +856,14 @@ main (int argc, char **argv)
 	case 'j':
 	  section_name = optarg;
 	  break;
+	case OPTION_BATCH:
+	  batch_mode = TRUE;
+	  break;
+	case OPTION_CACHE:
+	  batch_mode = TRUE;
+	  cache_requested = TRUE;
+	  cache_name = optarg;
+	  break;
 	default:
 	  usage (stderr, 1);
 	  break;
@@ -410,6 +873,9 @@ main (int argc, char **argv)
   if (file_name == NULL)
     file_name = "a.out";
 
+  if (cache_requested && cache_name == NULL)
+    cache_name = concat (file_name, ".a2l", (const char *) NULL);
+
   addr = argv + optind;
   naddr = argc - optind;
 
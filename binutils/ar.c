@@ -126,6 +126,11 @@ get_pos_bfd (bfd **, enum pos, const char *);
 static bfd_boolean counted_name_mode = 0;
 static int counted_name_counter = 0;
 
+/* Whether the symbol table entries for members copied unchanged can be
+   taken from the symbol table of the input archive.  ranlib rebuilds
+   the table from scratch.  */
+static bfd_boolean reuse_armap = TRUE;
+
 /* Whether to truncate names of files stored in the archive.  */
 static bfd_boolean ar_truncate = FALSE;
 
@@ -1021,6 +1026,9 @@ write_archive (bfd *iarch)
   if (deterministic)
     obfd->flags |= BFD_DETERMINISTIC_OUTPUT;
 
+  if (reuse_armap)
+    obfd->flags |= BFD_ARCHIVE_REUSE_ARMAP;
+
   if (make_thin_archive || bfd_is_thin_archive (iarch))
     bfd_is_thin_archive (obfd) = 1;
 
@@ -1280,6 +1288,7 @@ ranlib_only (const char *archname)
   if (get_file_size (archname) < 1)
     return 1;
   write_armap = 1;
+  reuse_armap = FALSE;
   arch = open_inarch (archname, (char *) NULL);
   if (arch == NULL)
     xexit (1);
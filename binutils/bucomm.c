@@ -489,7 +489,7 @@ template_in_dir (const char *path)
    as FILENAME.  */
 
 char *
-make_tempname (char *filename)
+make_tempname (const char *filename)
 {
   char *tmpname = template_in_dir (filename);
   int fd;
@@ -512,7 +512,7 @@ make_tempname (char *filename)
    directory containing FILENAME.  */
 
 char *
-make_tempdir (char *filename)
+make_tempdir (const char *filename)
 {
   char *tmpname = template_in_dir (filename);
 
@@ -550,6 +550,23 @@ parse_vma (const char *s, const char *arg)
   return ret;
 }
 
+/* Parse the argument of a --threads option, with a fatal error if it
+   is not a number between 1 and MAX_THREAD_COUNT.  */
+
+unsigned int
+parse_thread_count (const char *s, const char *arg)
+{
+  unsigned long ret;
+  char *end;
+
+  ret = strtoul (s, &end, 0);
+
+  if (*end != '\0' || ret == 0 || ret > MAX_THREAD_COUNT)
+    fatal (_("%s: bad thread count: %s"), arg, s);
+
+  return (unsigned int) ret;
+}
+
 /* Returns the size of the named file.  If the file does not
    exist, or if it is not a real file, then a suitable non-fatal
    error message is printed and zero is returned.  */
@@ -51,11 +51,16 @@ int display_info (void);
 
 void print_arelt_descr (FILE *, bfd *, bfd_boolean);
 
-char *make_tempname (char *);
-char *make_tempdir (char *);
+char *make_tempname (const char *);
+char *make_tempdir (const char *);
 
 bfd_vma parse_vma (const char *, const char *);
 
+/* The largest count accepted by --threads.  */
+#define MAX_THREAD_COUNT 1024
+
+unsigned int parse_thread_count (const char *, const char *);
+
 off_t get_file_size (const char *);
 
 extern char *program_name;
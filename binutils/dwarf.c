@@ -27,6 +27,11 @@
 #include "dwarf2.h"
 #include "dwarf.h"
 
+#if defined (HAVE_FORK) && defined (HAVE_SYS_WAIT_H)
+#include <sys/wait.h>
+#define DWARF_WORKERS 1
+#endif
+
 static int have_frame_base;
 static int need_base_address;
 
@@ -54,6 +59,13 @@ int do_debug_str;
 int do_debug_loc;
 int do_wide;
 
+/* Do not display DIEs at this depth or deeper, unless -1.  */
+int dwarf_cutoff_level = -1;
+/* Do not display DIEs before this offset in .debug_info.  */
+unsigned long dwarf_start_die;
+/* Display .debug_info and .debug_line in this many processes.  */
+unsigned int dwarf_threads;
+
 /* Values for do_debug_lines.  */
 #define FLAG_DEBUG_LINES_RAW	 1
 #define FLAG_DEBUG_LINES_DECODED 2
@@ -1114,6 +1126,10 @@ decode_location_expression (unsigned char * data,
   return need_frame_base;
 }
 
+/* Read the value of ATTRIBUTE in FORM at DATA, and display it unless
+   DO_LOC.  If DEBUG_INFO_P is not NULL, record the location lists,
+   range lists and base address it gives in *DEBUG_INFO_P.  */
+
 static unsigned char *
 read_and_display_attr_value (unsigned long attribute,
 			     unsigned long form,
@@ -1242,8 +1258,7 @@ read_and_display_attr_value (unsigned long attribute,
 	  printf (" 0x%lx", uvalue);
 	  printf (" 0x%lx", (unsigned long) byte_get (data + 4, 4));
 	}
-      if ((do_loc || do_debug_loc || do_debug_ranges)
-	  && num_debug_info_entries == 0)
+      if (debug_info_p != NULL)
 	{
 	  if (sizeof (uvalue) == 8)
 	    uvalue = byte_get (data, 8);
@@ -1310,8 +1325,7 @@ read_and_display_attr_value (unsigned long attribute,
       break;
     }
 
-  if ((do_loc || do_debug_loc || do_debug_ranges)
-      && num_debug_info_entries == 0)
+  if (debug_info_p != NULL)
     {
       switch (attribute)
 	{
@@ -1379,7 +1393,11 @@ read_and_display_attr_value (unsigned long attribute,
     }
 
   if (do_loc)
-    return data;
+    {
+      if (attribute == DW_AT_frame_base)
+	have_frame_base = 1;
+      return data;
+    }
 
   /* For some attributes we can display further information.  */
   printf ("\t");
@@ -1799,91 +1817,196 @@ read_and_display_attr (unsigned long attribute,
 }
 
 
-/* Process the contents of a .debug_info section.  If do_loc is non-zero
-   then we are scanning for location lists and we do not want to display
-   anything to the user.  */
+static unsigned int load_debug_info (void *);
+
+/* Return the start of the unit after the one at START in SECTION,
+   going by the initial length field that the units of .debug_info and
+   .debug_line start with.  Return NULL if the unit does not end inside
+   the section.  */
+
+static unsigned char *
+next_unit (struct dwarf_section *section, unsigned char *start)
+{
+  unsigned long offset = start - section->start;
+  unsigned long length;
+  unsigned int initial_length_size = 4;
+
+  if (section->size < offset + 4)
+    return NULL;
+
+  length = byte_get (start, 4);
+  if (length == 0xffffffff)
+    {
+      if (section->size < offset + 12)
+	return NULL;
+      length = byte_get (start + 4, 8);
+      initial_length_size = 12;
+    }
+
+  if (length > section->size - offset - initial_length_size)
+    return NULL;
+  return start + initial_length_size + length;
+}
+
+/* A function that displays the units of SECTION from START up to
+   STOP, returning zero if the rest of the section cannot be
+   displayed.  */
+
+typedef int (*display_units_fn) (struct dwarf_section *section,
+				 unsigned char *start,
+				 unsigned char *stop);
+
+#ifdef DWARF_WORKERS
+
+/* Display the units of SECTION from START up to END with DISPLAY in
+   dwarf_threads processes at once.  The units are shared out in
+   groups of consecutive units of about the same size.  Each worker
+   prints its group into a temporary file, and the files are copied to
+   stdout in order.  Like objcopy, this uses processes rather than
+   threads because the decoding keeps its state in static variables.  */
 
 static int
-process_debug_info (struct dwarf_section *section,
-		    void *file,
-		    int do_loc)
+display_units_in_workers (struct dwarf_section *section,
+			  unsigned char *start,
+			  unsigned char *end,
+			  display_units_fn display)
 {
-  unsigned char *start = section->start;
-  unsigned char *end = start + section->size;
-  unsigned char *section_begin;
-  unsigned int unit;
-  unsigned int num_units = 0;
+  unsigned char **cut;
+  FILE **out;
+  pid_t *pids;
+  unsigned char *p;
+  unsigned long share;
+  unsigned int ngroups;
+  unsigned int g;
+  int ret = 1;
+
+  /* Find where each group starts.  Once a unit does not end inside
+     the section, the rest of it goes into the last group.  */
+  cut = (unsigned char **) xmalloc ((dwarf_threads + 1) * sizeof (*cut));
+  share = (end - start) / dwarf_threads;
+  cut[0] = start;
+  ngroups = 1;
+  for (p = start; p < end && ngroups < dwarf_threads; )
+    {
+      p = next_unit (section, p);
+      if (p == NULL || p >= end)
+	break;
+      if ((unsigned long) (p - start) >= ngroups * share)
+	cut[ngroups++] = p;
+    }
+  cut[ngroups] = end;
 
-  if ((do_loc || do_debug_loc || do_debug_ranges)
-      && num_debug_info_entries == 0)
+  if (ngroups == 1)
     {
-      unsigned long length;
+      free (cut);
+      return display (section, start, end);
+    }
 
-      /* First scan the section to get the number of comp units.  */
-      for (section_begin = start, num_units = 0; section_begin < end;
-	   num_units ++)
-	{
-	  /* Read the first 4 bytes.  For a 32-bit DWARF section, this
-	     will be the length.  For a 64-bit DWARF section, it'll be
-	     the escape code 0xffffffff followed by an 8 byte length.  */
-	  length = byte_get (section_begin, 4);
+  out = (FILE **) xmalloc (ngroups * sizeof (*out));
+  pids = (pid_t *) xmalloc (ngroups * sizeof (*pids));
 
-	  if (length == 0xffffffff)
-	    {
-	      length = byte_get (section_begin + 4, 8);
-	      section_begin += length + 12;
-	    }
-	  else if (length >= 0xfffffff0 && length < 0xffffffff)
-	    {
-	      warn (_("Reserved length value (%lx) found in section %s\n"), length, section->name);
-	      return 0;
-	    }
-	  else
-	    section_begin += length + 4;
+  /* Flush anything buffered, so that it is not written again by each
+     worker.  */
+  fflush (stdout);
+  fflush (stderr);
 
-	  /* Negative values are illegal, they may even cause infinite
-	     looping.  This can happen if we can't accurately apply
-	     relocations to an object file.  */
-	  if ((signed long) length <= 0)
-	    {
-	      warn (_("Corrupt unit length (%lx) found in section %s\n"), length, section->name);
-	      return 0;
-	    }
-	}
+  for (g = 0; g < ngroups; g++)
+    {
+      pids[g] = -1;
+      out[g] = tmpfile ();
+      if (out[g] == NULL)
+	continue;
 
-      if (num_units == 0)
+      pids[g] = fork ();
+      if (pids[g] == 0)
 	{
-	  error (_("No comp units in %s section ?"), section->name);
-	  return 0;
+	  int status;
+
+	  if (dup2 (fileno (out[g]), fileno (stdout)) < 0)
+	    _exit (1);
+	  status = display (section, cut[g], cut[g + 1]) ? 0 : 2;
+	  fflush (stdout);
+	  fflush (stderr);
+	  _exit (status);
 	}
+    }
 
-      /* Then allocate an array to hold the information.  */
-      debug_information = (debug_info *) cmalloc (num_units,
-                                                  sizeof (* debug_information));
-      if (debug_information == NULL)
+  for (g = 0; g < ngroups; g++)
+    {
+      int wstatus = 0;
+      bfd_boolean done = FALSE;
+
+      if (pids[g] > 0
+	  && waitpid (pids[g], &wstatus, 0) == pids[g]
+	  && WIFEXITED (wstatus)
+	  && (WEXITSTATUS (wstatus) == 0 || WEXITSTATUS (wstatus) == 2))
 	{
-	  error (_("Not enough memory for a debug info array of %u entries"),
-		 num_units);
-	  return 0;
+	  char buf[64 * 1024];
+	  size_t n;
+
+	  done = TRUE;
+	  if (ret != 0)
+	    {
+	      rewind (out[g]);
+	      while ((n = fread (buf, 1, sizeof (buf), out[g])) > 0)
+		fwrite (buf, 1, n, stdout);
+	      if (WEXITSTATUS (wstatus) == 2)
+		ret = 0;
+	    }
 	}
-    }
 
-  if (!do_loc)
-    {
-      printf (_("Contents of the %s section:\n\n"), section->name);
+      /* Display the group here if its worker could not be started or
+	 did not finish.  */
+      if (!done && ret != 0)
+	ret = display (section, cut[g], cut[g + 1]);
 
-      load_debug_section (str, file);
+      if (out[g] != NULL)
+	fclose (out[g]);
     }
 
-  load_debug_section (abbrev, file);
-  if (debug_displays [abbrev].section.start == NULL)
-    {
-      warn (_("Unable to locate %s section!\n"),
-	    debug_displays [abbrev].section.name);
-      return 0;
-    }
+  free (pids);
+  free (out);
+  free (cut);
+  return ret;
+}
+
+#endif /* DWARF_WORKERS */
 
-  for (section_begin = start, unit = 0; start < end; unit++)
+/* Display the units of SECTION from START up to END with DISPLAY,
+   sharing them out between dwarf_threads processes if asked to.  */
+
+static int
+display_debug_units (struct dwarf_section *section,
+		     unsigned char *start,
+		     unsigned char *end,
+		     display_units_fn display)
+{
+#ifdef DWARF_WORKERS
+  if (dwarf_threads > 1)
+    return display_units_in_workers (section, start, end, display);
+#endif
+  return display (section, start, end);
+}
+
+/* Process the compilation units of the .debug_info SECTION from START
+   up to STOP, numbering them from UNIT.  If DO_LOC is non-zero then we
+   are scanning for location lists and we do not want to display
+   anything to the user.  If COLLECT is non-zero then record the
+   location and range lists of each unit in debug_information.  Return
+   zero if the rest of the section cannot be processed.  */
+
+static int
+process_debug_info_units (struct dwarf_section *section,
+			  unsigned char *start,
+			  unsigned char *stop,
+			  unsigned int unit,
+			  int do_loc,
+			  int collect)
+{
+  unsigned char *section_begin = section->start;
+  unsigned char *end = section->start + section->size;
+
+  for (; start < stop; unit++)
     {
       DWARF2_Internal_CompUnit compunit;
       unsigned char *hdrptr;
@@ -1923,8 +2046,7 @@ process_debug_info (struct dwarf_section *section,
 
       compunit.cu_pointer_size = byte_get (hdrptr, 1);
       hdrptr += 1;
-      if ((do_loc || do_debug_loc || do_debug_ranges)
-	  && num_debug_info_entries == 0)
+      if (collect)
 	{
 	  debug_information [unit].cu_offset = cu_offset;
 	  debug_information [unit].pointer_size
@@ -1989,6 +2111,7 @@ process_debug_info (struct dwarf_section *section,
 	  unsigned long die_offset;
 	  abbrev_entry *entry;
 	  abbrev_attr *attr;
+	  int do_printing;
 
 	  die_offset = tags - section_begin;
 
@@ -2028,7 +2151,12 @@ process_debug_info (struct dwarf_section *section,
 	      continue;
 	    }
 
-	  if (!do_loc)
+	  do_printing = (!do_loc
+			 && die_offset >= dwarf_start_die
+			 && (dwarf_cutoff_level == -1
+			     || level < dwarf_cutoff_level));
+
+	  if (do_printing)
 	    printf (_(" <%d><%lx>: Abbrev Number: %lu"),
 		    level, die_offset, abbrev_number);
 
@@ -2041,7 +2169,7 @@ process_debug_info (struct dwarf_section *section,
 
 	  if (entry == NULL)
 	    {
-	      if (!do_loc)
+	      if (do_printing)
 		{
 		  printf ("\n");
 		  fflush (stdout);
@@ -2051,7 +2179,7 @@ process_debug_info (struct dwarf_section *section,
 	      return 0;
 	    }
 
-	  if (!do_loc)
+	  if (do_printing)
 	    printf (_(" (%s)\n"), get_TAG_name (entry->tag));
 
 	  switch (entry->tag)
@@ -2072,7 +2200,7 @@ process_debug_info (struct dwarf_section *section,
 
 	  for (attr = entry->first_attr; attr; attr = attr->next)
 	    {
-	      if (! do_loc)
+	      if (do_printing)
 		/* Show the offset from where the tag was extracted.  */
 		printf ("    <%2lx>", (unsigned long)(tags - section_begin));
 
@@ -2082,8 +2210,10 @@ process_debug_info (struct dwarf_section *section,
 					    compunit.cu_pointer_size,
 					    offset_size,
 					    compunit.cu_version,
-					    debug_information + unit,
-					    do_loc, section);
+					    (collect
+					     ? debug_information + unit
+					     : NULL),
+					    !do_printing, section);
 	    }
 
  	  if (entry->children)
@@ -2091,10 +2221,142 @@ process_debug_info (struct dwarf_section *section,
  	}
     }
 
+  return 1;
+}
+
+/* Display the compilation units of the .debug_info SECTION from START
+   up to STOP.  */
+
+static int
+display_debug_info_units (struct dwarf_section *section,
+			  unsigned char *start,
+			  unsigned char *stop)
+{
+  return process_debug_info_units (section, start, stop, 0, 0, 0);
+}
+
+/* Process the contents of a .debug_info section.  If do_loc is non-zero
+   then we are scanning for location lists and we do not want to display
+   anything to the user.  */
+
+static int
+process_debug_info (struct dwarf_section *section,
+		    void *file,
+		    int do_loc)
+{
+  unsigned char *start = section->start;
+  unsigned char *end = start + section->size;
+  unsigned char *section_begin;
+  unsigned int num_units = 0;
+  int collect;
+
+  /* Units that are skipped, or displayed by other processes, cannot
+     record their location and range lists, so read those first.  */
+  if (!do_loc
+      && (do_debug_loc || do_debug_ranges)
+      && num_debug_info_entries == 0
+      && (dwarf_start_die != 0 || dwarf_threads > 1))
+    load_debug_info (file);
+
+  collect = ((do_loc || do_debug_loc || do_debug_ranges)
+	     && num_debug_info_entries == 0);
+
+  if (collect)
+    {
+      unsigned long length;
+
+      /* First scan the section to get the number of comp units.  */
+      for (section_begin = start, num_units = 0; section_begin < end;
+	   num_units ++)
+	{
+	  /* Read the first 4 bytes.  For a 32-bit DWARF section, this
+	     will be the length.  For a 64-bit DWARF section, it'll be
+	     the escape code 0xffffffff followed by an 8 byte length.  */
+	  length = byte_get (section_begin, 4);
+
+	  if (length == 0xffffffff)
+	    {
+	      length = byte_get (section_begin + 4, 8);
+	      section_begin += length + 12;
+	    }
+	  else if (length >= 0xfffffff0 && length < 0xffffffff)
+	    {
+	      warn (_("Reserved length value (%lx) found in section %s\n"), length, section->name);
+	      return 0;
+	    }
+	  else
+	    section_begin += length + 4;
+
+	  /* Negative values are illegal, they may even cause infinite
+	     looping.  This can happen if we can't accurately apply
+	     relocations to an object file.  */
+	  if ((signed long) length <= 0)
+	    {
+	      warn (_("Corrupt unit length (%lx) found in section %s\n"), length, section->name);
+	      return 0;
+	    }
+	}
+
+      if (num_units == 0)
+	{
+	  error (_("No comp units in %s section ?"), section->name);
+	  return 0;
+	}
+
+      /* Then allocate an array to hold the information.  */
+      debug_information = (debug_info *) cmalloc (num_units,
+                                                  sizeof (* debug_information));
+      if (debug_information == NULL)
+	{
+	  error (_("Not enough memory for a debug info array of %u entries"),
+		 num_units);
+	  return 0;
+	}
+    }
+
+  if (!do_loc)
+    {
+      printf (_("Contents of the %s section:\n\n"), section->name);
+
+      load_debug_section (str, file);
+    }
+
+  load_debug_section (abbrev, file);
+  if (debug_displays [abbrev].section.start == NULL)
+    {
+      warn (_("Unable to locate %s section!\n"),
+	    debug_displays [abbrev].section.name);
+      return 0;
+    }
+
+  if (do_loc || collect)
+    {
+      if (!process_debug_info_units (section, start, end, 0, do_loc, collect))
+	return 0;
+    }
+  else
+    {
+      /* Skip the compilation units that end before the first DIE to
+	 display, going by their lengths.  */
+      if (dwarf_start_die != 0)
+	while (start < end)
+	  {
+	    unsigned char *next = next_unit (section, start);
+
+	    if (next == NULL
+		|| (unsigned long) (next - section->start) > dwarf_start_die)
+	      break;
+	    start = next;
+	  }
+
+      if (!display_debug_units (section, start, end,
+				display_debug_info_units))
+	return 0;
+    }
+
   /* Set num_debug_info_entries here so that it can be used to check if
      we need to process .debug_loc and .debug_ranges sections.  */
-  if ((do_loc || do_debug_loc || do_debug_ranges)
-      && num_debug_info_entries == 0)
+  if (collect)
     num_debug_info_entries = num_units;
 
   if (!do_loc)
@@ -2136,6 +2398,9 @@ load_debug_info (void * file)
   return 0;
 }
 
+/* Output a raw dump of the line number programs of SECTION from DATA
+   up to END.  */
+
 static int
 display_debug_lines_raw (struct dwarf_section *section,
 			 unsigned char *data,
@@ -2143,9 +2408,6 @@ display_debug_lines_raw (struct dwarf_section *section,
 {
   unsigned char *start = section->start;
 
-  printf (_("Raw dump of debug contents of section %s:\n\n"),
-          section->name);
-
   while (data < end)
     {
       DWARF2_Internal_LineInfo info;
@@ -2420,16 +2682,14 @@ typedef struct
     unsigned int length;
 } File_Entry;
 
-/* Output a decoded representation of the .debug_line section.  */
+/* Output a decoded representation of the line number programs of
+   SECTION from DATA up to END.  */
 
 static int
 display_debug_lines_decoded (struct dwarf_section *section,
 			     unsigned char *data,
 			     unsigned char *end)
 {
-  printf (_("Decoded dump of debug contents of section %s:\n\n"),
-          section->name);
-
   while (data < end)
     {
       /* This loop amounts to one iteration per compilation unit.  */
@@ -2841,10 +3101,20 @@ display_debug_lines (struct dwarf_section *section, void *file)
     do_debug_lines |= FLAG_DEBUG_LINES_RAW;
 
   if (do_debug_lines & FLAG_DEBUG_LINES_RAW)
-    retValRaw = display_debug_lines_raw (section, data, end);
+    {
+      printf (_("Raw dump of debug contents of section %s:\n\n"),
+	      section->name);
+      retValRaw = display_debug_units (section, data, end,
+				       display_debug_lines_raw);
+    }
 
   if (do_debug_lines & FLAG_DEBUG_LINES_DECODED)
-    retValDecoded = display_debug_lines_decoded (section, data, end);
+    {
+      printf (_("Decoded dump of debug contents of section %s:\n\n"),
+	      section->name);
+      retValDecoded = display_debug_units (section, data, end,
+					   display_debug_lines_decoded);
+    }
 
   if (!retValRaw || !retValDecoded)
     return 0;
@@ -112,6 +112,10 @@ extern int do_debug_macinfo;
 extern int do_debug_str;
 extern int do_debug_loc;
 
+extern int dwarf_cutoff_level;
+extern unsigned long dwarf_start_die;
+extern unsigned int dwarf_threads;
+
 extern void init_dwarf_regnames (unsigned int);
 
 extern int load_debug_section (enum dwarf_section_display_enum,
@@ -53,6 +53,15 @@ struct get_relocs_info
   asymbol **syms;
 };
 
+/* A reloc against a symbol, indexed by the symbol's name.  */
+
+struct reloc_by_name
+{
+  const char *name;
+  unsigned int sec;
+  long reloc;
+};
+
 struct extended_symbol_info
 {
   symbol_info *sinfo;
@@ -785,6 +794,25 @@ get_relocs (bfd *abfd, asection *sec, void *dataarg)
   ++data->relcount;
 }
 
+/* Sort relocs by symbol name, and then by their order in the file.  */
+
+static int
+reloc_by_name_compare (const void *a, const void *b)
+{
+  const struct reloc_by_name *ra = (const struct reloc_by_name *) a;
+  const struct reloc_by_name *rb = (const struct reloc_by_name *) b;
+  int cmp;
+
+  cmp = strcmp (ra->name, rb->name);
+  if (cmp != 0)
+    return cmp;
+  if (ra->sec != rb->sec)
+    return ra->sec < rb->sec ? -1 : 1;
+  if (ra->reloc != rb->reloc)
+    return ra->reloc < rb->reloc ? -1 : 1;
+  return 0;
+}
+
 /* Print a single symbol.  */
 
 static void
@@ -841,7 +869,10 @@ print_symbol (bfd *abfd, asymbol *sym, bfd_vma ssize, bfd *archive_bfd)
 	  static arelent ***relocs;
 	  static long *relcount;
 	  static unsigned int seccount;
+	  static struct reloc_by_name *relnames;
+	  static long relnamecount;
 	  unsigned int i;
+	  long lo, hi;
 	  const char *symname;
 
 	  /* For an undefined symbol, we try to find a reloc for the
@@ -854,9 +885,11 @@ print_symbol (bfd *abfd, asymbol *sym, bfd_vma ssize, bfd *archive_bfd)
 	      free (secs);
 	      free (relocs);
 	      free (relcount);
+	      free (relnames);
 	      secs = NULL;
 	      relocs = NULL;
 	      relcount = NULL;
+	      relnames = NULL;
 	    }
 
 	  if (relocs == NULL)
@@ -875,33 +908,64 @@ print_symbol (bfd *abfd, asymbol *sym, bfd_vma ssize, bfd *archive_bfd)
 	      info.syms = syms;
 	      bfd_map_over_sections (abfd, get_relocs, (void *) &info);
 	      lineno_cache_rel_bfd = abfd;
+
+	      /* Index the relocs by the name of their symbol, so that we
+		 need not look through all of them for every symbol.  */
+	      relnamecount = 0;
+	      for (i = 0; i < seccount; i++)
+		relnamecount += relcount[i];
+	      relnames = (struct reloc_by_name *)
+		  xmalloc ((relnamecount + 1) * sizeof *relnames);
+	      relnamecount = 0;
+	      for (i = 0; i < seccount; i++)
+		{
+		  long j;
+
+		  for (j = 0; j < relcount[i]; j++)
+		    if (relocs[i][j]->sym_ptr_ptr != NULL)
+		      {
+			relnames[relnamecount].name
+			  = bfd_asymbol_name (*relocs[i][j]->sym_ptr_ptr);
+			relnames[relnamecount].sec = i;
+			relnames[relnamecount].reloc = j;
+			relnamecount++;
+		      }
+		}
+	      qsort (relnames, relnamecount, sizeof *relnames,
+		     reloc_by_name_compare);
 	    }
 
+	  /* Find the first reloc against a symbol of this name.  */
 	  symname = bfd_asymbol_name (sym);
-	  for (i = 0; i < seccount; i++)
+	  lo = 0;
+	  hi = relnamecount;
+	  while (lo < hi)
 	    {
-	      long j;
+	      long mid = lo + (hi - lo) / 2;
+
+	      if (strcmp (relnames[mid].name, symname) < 0)
+		lo = mid + 1;
+	      else
+		hi = mid;
+	    }
 
-	      for (j = 0; j < relcount[i]; j++)
+	  for (; lo < relnamecount && strcmp (relnames[lo].name, symname) == 0;
+	       lo++)
+	    {
+	      unsigned int sec = relnames[lo].sec;
+	      arelent *r;
+
+	      r = relocs[sec][relnames[lo].reloc];
+	      if ((*r->sym_ptr_ptr)->section == sym->section
+		  && (*r->sym_ptr_ptr)->value == sym->value
+		  && bfd_find_nearest_line (abfd, secs[sec], syms,
+					    r->address, &filename,
+					    &functionname, &lineno)
+		  && filename != NULL)
 		{
-		  arelent *r;
-
-		  r = relocs[i][j];
-		  if (r->sym_ptr_ptr != NULL
-		      && (*r->sym_ptr_ptr)->section == sym->section
-		      && (*r->sym_ptr_ptr)->value == sym->value
-		      && strcmp (symname,
-				 bfd_asymbol_name (*r->sym_ptr_ptr)) == 0
-		      && bfd_find_nearest_line (abfd, secs[i], syms,
-						r->address, &filename,
-						&functionname, &lineno)
-		      && filename != NULL)
-		    {
-		      /* We only print the first one we find.  */
-		      printf ("\t%s:%u", filename, lineno);
-		      i = seccount;
-		      break;
-		    }
+		  /* We only print the first one we find.  */
+		  printf ("\t%s:%u", filename, lineno);
+		  break;
 		}
 	    }
 	}
@@ -31,6 +31,10 @@
 #include "fnmatch.h"
 #include "elf-bfd.h"
 #include <sys/stat.h>
+#if defined (HAVE_FORK) && defined (HAVE_SYS_WAIT_H)
+#include <sys/wait.h>
+#define OBJCOPY_WORKERS 1
+#endif
 #include "libbfd.h"
 #include "coff/internal.h"
 #include "libcoff.h"
@@ -87,6 +91,7 @@ static int interleave = 4;
 static bfd_boolean verbose;		/* Print file and target names.  */
 static bfd_boolean preserve_dates;	/* Preserve input file timestamp.  */
 static int status = 0;		/* Exit status.  */
+static unsigned int worker_count;	/* --threads */
 
 enum strip_action
   {
@@ -302,7 +307,8 @@ enum command_line_switch
     OPTION_IMAGE_BASE,
     OPTION_SECTION_ALIGNMENT,
     OPTION_STACK,
-    OPTION_SUBSYSTEM
+    OPTION_SUBSYSTEM,
+    OPTION_THREADS
   };
 
 /* Options to handle if running as "strip".  */
@@ -329,6 +335,7 @@ static struct option strip_options[] =
   {"strip-unneeded", no_argument, 0, OPTION_STRIP_UNNEEDED},
   {"strip-symbol", required_argument, 0, 'N'},
   {"target", required_argument, 0, 'F'},
+  {"threads", required_argument, 0, OPTION_THREADS},
   {"verbose", no_argument, 0, 'v'},
   {"version", no_argument, 0, 'V'},
   {"wildcard", no_argument, 0, 'w'},
@@ -409,6 +416,7 @@ static struct option copy_options[] =
   {"strip-symbol", required_argument, 0, 'N'},
   {"strip-symbols", required_argument, 0, OPTION_STRIP_SYMBOLS},
   {"target", required_argument, 0, 'F'},
+  {"threads", required_argument, 0, OPTION_THREADS},
   {"verbose", no_argument, 0, 'v'},
   {"version", no_argument, 0, 'V'},
   {"weaken", no_argument, 0, OPTION_WEAKEN},
@@ -552,6 +560,7 @@ copy_usage (FILE *stream, int exit_status)
                                    <commit>\n\
      --subsystem <name>[:<version>]\n\
                                    Set PE subsystem to <name> [& <version>]\n]\
+     --threads=<count>             Copy archive members in <count> processes\n\
   -v --verbose                     List all object files modified\n\
   @<file>                          Read options from <file>\n\
   -V --version                     Display this program's version number\n\
@@ -586,6 +595,7 @@ strip_usage (FILE *stream, int exit_status)
   -w --wildcard                    Permit wildcard in symbol comparison\n\
   -x --discard-all                 Remove all non-global symbols\n\
   -X --discard-locals              Remove any compiler-generated symbols\n\
+     --threads=<count>             Strip files and members in <count> processes\n\
   -v --verbose                     List all object files modified\n\
   -V --version                     Display this program's version number\n\
   -h --help                        Display this output\n\
@@ -1948,11 +1958,221 @@ copy_object (bfd *ibfd, bfd *obfd)
   return TRUE;
 }
 
+/* Copy the archive element THIS_ELEMENT to the new file OUTPUT_NAME.
+   OUTPUT_TARGET and FORCE_OUTPUT_TARGET are as for copy_archive.  If
+   STAT_STATUS is zero, BUF holds the dates of the element.  Return
+   FALSE, having removed OUTPUT_NAME, if the element is not copied.  */
+
+static bfd_boolean
+copy_archive_element (bfd *this_element, const char *output_name,
+		      const char *output_target,
+		      bfd_boolean force_output_target,
+		      struct stat *buf, int stat_status)
+{
+  bfd *output_bfd;
+  bfd_boolean del = TRUE;
+
+  if (bfd_check_format (this_element, bfd_object))
+    {
+      /* PR binutils/3110: Cope with archives
+	 containing multiple target types.  */
+      if (force_output_target)
+	output_bfd = bfd_openw (output_name, output_target);
+      else
+	output_bfd = bfd_openw (output_name, bfd_get_target (this_element));
+
+      if (output_bfd == NULL)
+	{
+	  bfd_nonfatal_message (output_name, NULL, NULL, NULL);
+	  return FALSE;
+	}
+
+      del = ! copy_object (this_element, output_bfd);
+
+      if (! del
+	  || bfd_get_arch (this_element) != bfd_arch_unknown)
+	{
+	  if (!bfd_close (output_bfd))
+	    {
+	      bfd_nonfatal_message (output_name, NULL, NULL, NULL);
+	      /* Error in new object file. Don't change archive.  */
+	      status = 1;
+	    }
+	}
+      else
+	goto copy_unknown_element;
+    }
+  else
+    {
+      bfd_nonfatal_message (NULL, this_element, NULL,
+			    _("Unable to recognise the format of file"));
+
+      output_bfd = bfd_openw (output_name, output_target);
+copy_unknown_element:
+      del = !copy_unknown_object (this_element, output_bfd);
+      if (!bfd_close_all_done (output_bfd))
+	{
+	  bfd_nonfatal_message (output_name, NULL, NULL, NULL);
+	  /* Error in new object file. Don't change archive.  */
+	  status = 1;
+	}
+    }
+
+  if (del)
+    {
+      unlink (output_name);
+      return FALSE;
+    }
+
+  if (preserve_dates && stat_status == 0)
+    set_times (output_name, buf);
+  return TRUE;
+}
+
+#ifdef OBJCOPY_WORKERS
+
+/* An archive element waiting to be copied by copy_archive_elements.  */
+
+struct archive_element
+{
+  bfd *element;
+  char *output_name;
+  struct stat buf;
+  int stat_status;
+  /* Where to put the BFD of the copy.  */
+  bfd **copy;
+};
+
+/* Write a byte to F for each entry of change_sections, saying whether
+   a worker process used it.  */
+
+static void
+write_used_sections (FILE *f)
+{
+  struct section_list *p;
+
+  for (p = change_sections; p != NULL; p = p->next)
+    putc (p->used ? 1 : 0, f);
+}
+
+/* Mark the entries of change_sections that a worker process used,
+   reading F as written by write_used_sections.  */
+
+static void
+read_used_sections (FILE *f)
+{
+  struct section_list *p;
+
+  for (p = change_sections; p != NULL; p = p->next)
+    {
+      int c = getc (f);
+
+      if (c == EOF)
+	break;
+      if (c)
+	p->used = TRUE;
+    }
+}
+
+/* Copy the COUNT archive elements in ELEMENTS, sharing them out
+   between worker_count processes.  BFD keeps global state, so the
+   elements are copied in separate processes rather than threads;
+   each writes its copies to their files as copy_archive_element
+   does, and tells the parent through a temporary file which entries
+   of change_sections it used, for copy_main's warnings.  Return FALSE
+   if any element is not copied.  */
+
+static bfd_boolean
+copy_archive_elements (struct archive_element *elements, unsigned int count,
+		       const char *output_target,
+		       bfd_boolean force_output_target)
+{
+  pid_t *pids;
+  FILE **used;
+  unsigned int workers;
+  unsigned int w;
+  bfd_boolean ok = TRUE;
+
+  workers = worker_count < count ? worker_count : count;
+  pids = (pid_t *) xmalloc (workers * sizeof (pid_t));
+  used = (FILE **) xmalloc (workers * sizeof (FILE *));
+
+  /* Close the files BFD has open, so that each worker opens its own
+     rather than sharing their file offsets, and flush anything
+     buffered so that it is not written again by each worker.  */
+  bfd_cache_close_all ();
+  fflush (stdout);
+  fflush (stderr);
+
+  for (w = 0; w < workers; w++)
+    {
+      used[w] = tmpfile ();
+      if (used[w] == NULL)
+	{
+	  non_fatal (_("cannot create temporary file: %s"), strerror (errno));
+	  workers = w;
+	  ok = FALSE;
+	  break;
+	}
+
+      pids[w] = fork ();
+      if (pids[w] == 0)
+	{
+	  unsigned int i;
+
+	  for (i = w; i < count && status == 0; i += workers)
+	    if (! copy_archive_element (elements[i].element,
+					elements[i].output_name,
+					output_target, force_output_target,
+					&elements[i].buf,
+					elements[i].stat_status))
+	      status = 1;
+
+	  write_used_sections (used[w]);
+	  if (fflush (used[w]) != 0)
+	    status = 1;
+	  fflush (stdout);
+	  fflush (stderr);
+	  _exit (status);
+	}
+      if (pids[w] < 0)
+	{
+	  non_fatal (_("cannot fork: %s"), strerror (errno));
+	  fclose (used[w]);
+	  workers = w;
+	  ok = FALSE;
+	}
+    }
+
+  for (w = 0; w < workers; w++)
+    {
+      int wstatus;
+
+      if (waitpid (pids[w], &wstatus, 0) != pids[w]
+	  || ! WIFEXITED (wstatus)
+	  || WEXITSTATUS (wstatus) != 0)
+	ok = FALSE;
+      else
+	{
+	  rewind (used[w]);
+	  read_used_sections (used[w]);
+	}
+      fclose (used[w]);
+    }
+
+  free (used);
+  free (pids);
+  return ok;
+}
+
+#endif /* OBJCOPY_WORKERS */
+
 /* Read each archive element in turn from IBFD, copy the
    contents to temp file, and keep the temp file handle.
    If 'force_output_target' is TRUE then make sure that
    all elements in the new archive are of the type
-   'output_target'.  */
+   'output_target'.  With --threads, the elements are all
+   listed first and then copied by copy_archive_elements.  */
 
 static void
 copy_archive (bfd *ibfd, bfd *obfd, const char *output_target,
@@ -1968,6 +2188,12 @@ copy_archive (bfd *ibfd, bfd *obfd, const char *output_target,
   bfd *this_element;
   char *dir;
   const char *filename;
+#ifdef OBJCOPY_WORKERS
+  struct archive_element *elements = NULL;
+  unsigned int element_count = 0;
+  unsigned int element_max = 0;
+  htab_t names = NULL;
+#endif
 
   /* Make a temp directory to hold the contents.  */
   dir = make_tempdir (bfd_get_filename (obfd));
@@ -1989,6 +2215,14 @@ copy_archive (bfd *ibfd, bfd *obfd, const char *output_target,
       return;
     }
 
+#ifdef OBJCOPY_WORKERS
+  /* The files of elements waiting to be copied do not exist yet, so
+     keep their names to spot elements with the same name.  */
+  if (worker_count > 1)
+    names = htab_create_alloc (16, htab_hash_string, eq_string, NULL,
+			       xcalloc, free);
+#endif
+
   while (!status && this_element != NULL)
     {
       char *output_name;
@@ -1996,14 +2230,17 @@ copy_archive (bfd *ibfd, bfd *obfd, const char *output_target,
       bfd *last_element;
       struct stat buf;
       int stat_status = 0;
-      bfd_boolean del = TRUE;
 
       /* Create an output file for this member.  */
       output_name = concat (dir, "/",
 			    bfd_get_filename (this_element), (char *) 0);
 
       /* If the file already exists, make another temp dir.  */
-      if (stat (output_name, &buf) >= 0)
+      if (stat (output_name, &buf) >= 0
+#ifdef OBJCOPY_WORKERS
+	  || (names != NULL && htab_find (names, output_name) != NULL)
+#endif
+	  )
 	{
 	  output_name = make_tempdir (output_name);
 	  if (output_name == NULL)
@@ -2034,63 +2271,35 @@ copy_archive (bfd *ibfd, bfd *obfd, const char *output_target,
       l->obfd = NULL;
       list = l;
 
-      if (bfd_check_format (this_element, bfd_object))
+#ifdef OBJCOPY_WORKERS
+      if (names != NULL)
 	{
-	  /* PR binutils/3110: Cope with archives
-	     containing multiple target types.  */
-	  if (force_output_target)
-	    output_bfd = bfd_openw (output_name, output_target);
-	  else
-	    output_bfd = bfd_openw (output_name, bfd_get_target (this_element));
+	  struct archive_element *e;
 
-	  if (output_bfd == NULL)
+	  if (element_count == element_max)
 	    {
-	      bfd_nonfatal_message (output_name, NULL, NULL, NULL);
-	      status = 1;
-	      return;
-	    }
-
-	  del = ! copy_object (this_element, output_bfd);
-
-	  if (! del
-	      || bfd_get_arch (this_element) != bfd_arch_unknown)
-	    {
-	      if (!bfd_close (output_bfd))
-		{
-		  bfd_nonfatal_message (output_name, NULL, NULL, NULL);
-		  /* Error in new object file. Don't change archive.  */
-		  status = 1;
-		}
-	    }
-	  else
-	    goto copy_unknown_element;
-	}
-      else
-	{
-	  bfd_nonfatal_message (NULL, this_element, NULL,
-				_("Unable to recognise the format of file"));
-
-	  output_bfd = bfd_openw (output_name, output_target);
-copy_unknown_element:
-	  del = !copy_unknown_object (this_element, output_bfd);
-	  if (!bfd_close_all_done (output_bfd))
-	    {
-	      bfd_nonfatal_message (output_name, NULL, NULL, NULL);
-	      /* Error in new object file. Don't change archive.  */
-	      status = 1;
+	      element_max = element_max * 2 + 64;
+	      elements = (struct archive_element *)
+		xrealloc (elements, element_max * sizeof (*elements));
 	    }
+	  e = &elements[element_count++];
+	  e->element = this_element;
+	  e->output_name = output_name;
+	  e->buf = buf;
+	  e->stat_status = stat_status;
+	  e->copy = &l->obfd;
+	  *htab_find_slot (names, output_name, INSERT) = output_name;
+
+	  this_element = bfd_openr_next_archived_file (ibfd, this_element);
+	  continue;
 	}
+#endif
 
-      if (del)
-	{
-	  unlink (output_name);
-	  status = 1;
-	}
+      if (! copy_archive_element (this_element, output_name, output_target,
+				  force_output_target, &buf, stat_status))
+	status = 1;
       else
 	{
-	  if (preserve_dates && stat_status == 0)
-	    set_times (output_name, &buf);
-
 	  /* Open the newly output file and attach to our list.  */
 	  output_bfd = bfd_openr (output_name, output_target);
 
@@ -2106,6 +2315,39 @@ copy_unknown_element:
 	  bfd_close (last_element);
 	}
     }
+
+#ifdef OBJCOPY_WORKERS
+  if (names != NULL)
+    {
+      unsigned int i;
+
+      if (!status
+	  && ! copy_archive_elements (elements, element_count,
+				      output_target, force_output_target))
+	status = 1;
+
+      /* Attach the copies in the original order.  After a failure some
+	 of them will not exist.  */
+      for (i = 0; i < element_count; i++)
+	{
+	  struct stat buf;
+
+	  if (stat (elements[i].output_name, &buf) == 0)
+	    {
+	      bfd *output_bfd = bfd_openr (elements[i].output_name,
+					   output_target);
+
+	      *elements[i].copy = output_bfd;
+	      *ptr = output_bfd;
+	      ptr = &output_bfd->archive_next;
+	    }
+	  bfd_close (elements[i].element);
+	}
+
+      free (elements);
+      htab_delete (names);
+    }
+#endif
   *ptr = NULL;
 
   filename = bfd_get_filename (obfd);
@@ -2625,8 +2867,26 @@ copy_section (bfd *ibfd, sec_ptr isection, void *obfdarg)
   if (bfd_get_section_flags (ibfd, isection) & SEC_HAS_CONTENTS
       && bfd_get_section_flags (obfd, osection) & SEC_HAS_CONTENTS)
     {
-      void *memhunk = xmalloc (size);
+      void *memhunk;
+      const bfd_byte *view = NULL;
+
+      /* Copy straight from the input file if the contents are not
+	 going to be changed.  */
+      if (!reverse_bytes
+	  && copy_byte < 0
+	  && (isection->rawsize == 0 || isection->rawsize >= size))
+	view = bfd_section_contents_view (ibfd, isection);
+      if (view != NULL)
+	{
+	  if (!bfd_set_section_contents (obfd, osection, view, 0, size))
+	    {
+	      status = 1;
+	      bfd_nonfatal_message (NULL, obfd, osection, NULL);
+	    }
+	  return;
+	}
 
+      memhunk = xmalloc (size);
       if (!bfd_get_section_contents (ibfd, isection, memhunk, 0, size))
 	{
 	  status = 1;
@@ -2866,6 +3126,213 @@ write_debugging_info (bfd *obfd, void *dhandle,
   return FALSE;
 }
 
+/* Strip the file FILENAME, into OUTPUT_FILE if that is not NULL.
+   Return the resulting status, which is also left in `status'.  */
+
+static int
+strip_file (const char *filename, const char *output_file,
+	    const char *input_target, const char *output_target)
+{
+  struct stat statbuf;
+  char *tempfile = NULL;
+  const char *tmpname;
+
+  if (get_file_size (filename) < 1)
+    {
+      status = 1;
+      return status;
+    }
+
+  if (preserve_dates)
+    /* No need to check the return value of stat().
+       It has already been checked in get_file_size().  */
+    stat (filename, &statbuf);
+
+  if (output_file == NULL || strcmp (filename, output_file) == 0)
+    tmpname = tempfile = make_tempname (filename);
+  else
+    tmpname = output_file;
+
+  if (tmpname == NULL)
+    {
+      bfd_nonfatal_message (filename, NULL, NULL,
+			    _("could not create temporary file to hold stripped copy"));
+      status = 1;
+      return status;
+    }
+
+  status = 0;
+  copy_file (filename, tmpname, input_target, output_target);
+  if (status == 0)
+    {
+      if (preserve_dates)
+	set_times (tmpname, &statbuf);
+      if (output_file != tmpname)
+	status = (smart_rename (tmpname,
+				output_file ? output_file : filename,
+				preserve_dates) != 0);
+    }
+  else
+    unlink_if_ordinary (tmpname);
+  if (tempfile != NULL)
+    free (tempfile);
+
+  return status;
+}
+
+#ifdef OBJCOPY_WORKERS
+
+/* With --threads, each worker process strips a batch of up to this
+   many consecutive input files, so that what BFD learns from one file,
+   such as which target recognizes it, is used for the rest.  */
+#define STRIP_BATCH_FILES 32
+
+/* With --threads, no more workers are started while the largest input
+   files of the batches being stripped add up to more than this many
+   bytes, unless none is running.  */
+#define STRIP_MEMORY_BUDGET ((off_t) 512 * 1024 * 1024)
+
+/* A batch of input files being stripped by a worker process.  */
+
+struct strip_batch
+{
+  pid_t pid;
+  off_t size;
+  /* The files stripped, from FILES[FIRST] up to FILES[END].  */
+  int first;
+  int end;
+};
+
+/* Strip FILES[FIRST] up to FILES[END] in this process, one at a time.  */
+
+static void
+strip_file_range (char **files, int first, int end,
+		  const char *input_target, const char *output_target)
+{
+  int i;
+
+  for (i = first; i < end; i++)
+    {
+      int hold_status = status;
+
+      if (strip_file (files[i], NULL, input_target, output_target) == 0)
+	status = hold_status;
+    }
+}
+
+/* Strip the COUNT input FILES in worker_count processes at once.  A
+   batch whose worker cannot be started, or is killed, is stripped
+   here instead.  Each file is only replaced once it has been stripped
+   in full, so a batch that was partly done can be stripped again.  */
+
+static void
+strip_files (char **files, int count, const char *input_target,
+	     const char *output_target)
+{
+  struct strip_batch *running;
+  unsigned int nrunning = 0;
+  off_t in_flight = 0;
+  int next = 0;
+  int batch_end = 0;
+  off_t batch_size = 0;
+
+  running = (struct strip_batch *) xmalloc (worker_count
+					    * sizeof (struct strip_batch));
+
+  /* Flush anything buffered, so that it is not written again by each
+     worker.  */
+  fflush (stdout);
+  fflush (stderr);
+
+  while (next < count || nrunning > 0)
+    {
+      pid_t pid;
+      int wstatus;
+      unsigned int w;
+
+      /* Size up the next batch.  */
+      if (next < count && batch_end == next)
+	{
+	  batch_size = 0;
+	  for (; batch_end < count && batch_end - next < STRIP_BATCH_FILES;
+	       batch_end++)
+	    {
+	      struct stat buf;
+
+	      if (stat (files[batch_end], &buf) == 0
+		  && buf.st_size > batch_size)
+		batch_size = buf.st_size;
+	    }
+	}
+
+      if (next < count
+	  && nrunning < worker_count
+	  && (nrunning == 0
+	      || in_flight + batch_size <= STRIP_MEMORY_BUDGET))
+	{
+	  pid = fork ();
+	  if (pid == 0)
+	    {
+	      strip_file_range (files, next, batch_end, input_target,
+				output_target);
+	      fflush (stdout);
+	      fflush (stderr);
+	      _exit (status);
+	    }
+
+	  if (pid < 0)
+	    {
+	      non_fatal (_("cannot fork: %s"), strerror (errno));
+	      strip_file_range (files, next, batch_end, input_target,
+				output_target);
+	      fflush (stdout);
+	      next = batch_end;
+	      continue;
+	    }
+
+	  running[nrunning].pid = pid;
+	  running[nrunning].size = batch_size;
+	  running[nrunning].first = next;
+	  running[nrunning].end = batch_end;
+	  nrunning++;
+	  in_flight += batch_size;
+	  next = batch_end;
+	  continue;
+	}
+
+      /* Wait for a batch to be done.  */
+      pid = waitpid (-1, &wstatus, 0);
+      if (pid < 0)
+	{
+	  non_fatal (_("waitpid failed: %s"), strerror (errno));
+	  status = 1;
+	  break;
+	}
+      for (w = 0; w < nrunning; w++)
+	if (running[w].pid == pid)
+	  break;
+      if (w == nrunning)
+	continue;
+
+      in_flight -= running[w].size;
+      if (WIFSIGNALED (wstatus))
+	{
+	  non_fatal (_("process stripping %s was killed by signal %d"),
+		     files[running[w].first], WTERMSIG (wstatus));
+	  strip_file_range (files, running[w].first, running[w].end,
+			    input_target, output_target);
+	  fflush (stdout);
+	}
+      else if (! WIFEXITED (wstatus) || WEXITSTATUS (wstatus) != 0)
+	status = 1;
+      running[w] = running[--nrunning];
+    }
+
+  free (running);
+}
+
+#endif /* OBJCOPY_WORKERS */
+
 static int
 strip_main (int argc, char *argv[])
 {
@@ -2941,6 +3408,9 @@ strip_main (int argc, char *argv[])
 	case OPTION_KEEP_FILE_SYMBOLS:
 	  keep_file_symbols = 1;
 	  break;
+	case OPTION_THREADS:
+	  worker_count = parse_thread_count (optarg, "--threads");
+	  break;
 	case 0:
 	  /* We've been given a long option.  */
 	  break;
@@ -2978,53 +3448,20 @@ strip_main (int argc, char *argv[])
       || (output_file != NULL && (i + 1) < argc))
     strip_usage (stderr, 1);
 
+#ifdef OBJCOPY_WORKERS
+  if (worker_count > 1 && argc - i > 1)
+    {
+      strip_files (argv + i, argc - i, input_target, output_target);
+      return status;
+    }
+#endif
+
   for (; i < argc; i++)
     {
       int hold_status = status;
-      struct stat statbuf;
-      char *tmpname;
-
-      if (get_file_size (argv[i]) < 1)
-	{
-	  status = 1;
-	  continue;
-	}
 
-      if (preserve_dates)
-	/* No need to check the return value of stat().
-	   It has already been checked in get_file_size().  */
-	stat (argv[i], &statbuf);
-
-      if (output_file == NULL || strcmp (argv[i], output_file) == 0)
-	tmpname = make_tempname (argv[i]);
-      else
-	tmpname = output_file;
-
-      if (tmpname == NULL)
-	{
-	  bfd_nonfatal_message (argv[i], NULL, NULL,
-				_("could not create temporary file to hold stripped copy"));
-	  status = 1;
-	  continue;
-	}
-
-      status = 0;
-      copy_file (argv[i], tmpname, input_target, output_target);
-      if (status == 0)
-	{
-	  if (preserve_dates)
-	    set_times (tmpname, &statbuf);
-	  if (output_file != tmpname)
-	    status = (smart_rename (tmpname,
-				    output_file ? output_file : argv[i],
-				    preserve_dates) != 0);
-	  if (status == 0)
-	    status = hold_status;
-	}
-      else
-	unlink_if_ordinary (tmpname);
-      if (output_file != tmpname)
-	free (tmpname);
+      if (strip_file (argv[i], output_file, input_target, output_target) == 0)
+	status = hold_status;
     }
 
   return status;
@@ -3288,6 +3725,10 @@ copy_main (int argc, char *argv[])
 	  formats_info = TRUE;
 	  break;
 
+	case OPTION_THREADS:
+	  worker_count = parse_thread_count (optarg, "--threads");
+	  break;
+
 	case OPTION_WEAKEN:
 	  weaken = TRUE;
 	  break;
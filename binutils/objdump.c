@@ -69,6 +69,11 @@
 #include <sys/mman.h>
 #endif
 
+#if defined (HAVE_PTHREAD_H) && defined (HAVE_OPEN_MEMSTREAM)
+#include <pthread.h>
+#define OBJDUMP_THREADS 1
+#endif
+
 #include <sys/stat.h>
 
 /* Internal headers for the ELF .stab-dump code - sorry.  */
@@ -114,6 +119,7 @@ static bfd_vma adjust_section_vma = 0;	/* --adjust-vma */
 static int file_start_context = 0;      /* --file-start-context */
 static bfd_boolean display_file_offsets;/* -F */
 static const char *prefix;		/* --prefix */
+static unsigned int thread_count;	/* --threads */
 static int prefix_strip;		/* --prefix-strip */
 static size_t prefix_length;
 
@@ -163,6 +169,17 @@ static asymbol **sorted_syms;
 /* Number of symbols in `sorted_syms'.  */
 static long sorted_symcount = 0;
 
+/* Indices in `sorted_syms' of the symbols the disassembler accepts,
+   in ascending order.  */
+static long *valid_syms;
+
+/* Number of entries in `valid_syms'.  */
+static long valid_symcount;
+
+/* The entries of `valid_syms' ordered by section, so that the symbols
+   of each section form one run, still in ascending order.  */
+static long *section_syms;
+
 /* The dynamic symbol table.  */
 static asymbol **dynsyms;
 
@@ -241,6 +258,9 @@ usage (FILE *stream, int status)
       --special-syms             Include special symbols in symbol dumps\n\
       --prefix=PREFIX            Add PREFIX to absolute paths for -S\n\
       --prefix-strip=LEVEL       Strip initial directory names for -S\n\
+      --dwarf-depth=N            Do not display DIEs at depth N or greater\n\
+      --dwarf-start=N            Do not display DIEs before offset N\n\
+      --threads=COUNT            Disassemble or dump DWARF on COUNT threads\n\
 \n"));
       list_supported_targets (program_name, stream);
       list_supported_architectures (program_name, stream);
@@ -262,7 +282,10 @@ enum option_values
     OPTION_PREFIX,
     OPTION_PREFIX_STRIP,
     OPTION_INSN_WIDTH,
-    OPTION_ADJUST_VMA
+    OPTION_ADJUST_VMA,
+    OPTION_THREADS,
+    OPTION_DWARF_DEPTH,
+    OPTION_DWARF_START
   };
 
 static struct option long_options[]=
@@ -300,6 +323,8 @@ static struct option long_options[]=
   {"special-syms", no_argument, &dump_special_syms, 1},
   {"include", required_argument, NULL, 'I'},
   {"dwarf", optional_argument, NULL, OPTION_DWARF},
+  {"dwarf-depth", required_argument, NULL, OPTION_DWARF_DEPTH},
+  {"dwarf-start", required_argument, NULL, OPTION_DWARF_START},
   {"stabs", no_argument, NULL, 'G'},
   {"start-address", required_argument, NULL, OPTION_START_ADDRESS},
   {"stop-address", required_argument, NULL, OPTION_STOP_ADDRESS},
@@ -310,6 +335,7 @@ static struct option long_options[]=
   {"prefix", required_argument, NULL, OPTION_PREFIX},
   {"prefix-strip", required_argument, NULL, OPTION_PREFIX_STRIP},
   {"insn-width", required_argument, NULL, OPTION_INSN_WIDTH},
+  {"threads", required_argument, NULL, OPTION_THREADS},
   {0, no_argument, 0, 0}
 };
 
@@ -715,6 +741,134 @@ objdump_print_symname (bfd *abfd, struct disassemble_info *info,
     free (alloc);
 }
 
+/* Sort indices in `sorted_syms' by section, keeping the symbols of each
+   section in value order.  */
+
+static int
+compare_section_syms (const void *ap, const void *bp)
+{
+  long a = * (const long *) ap;
+  long b = * (const long *) bp;
+
+  if (sorted_syms[a]->section > sorted_syms[b]->section)
+    return 1;
+  else if (sorted_syms[a]->section < sorted_syms[b]->section)
+    return -1;
+
+  if (a > b)
+    return 1;
+  else if (a < b)
+    return -1;
+  return 0;
+}
+
+/* Build the indices find_symbol_for_address searches, once `sorted_syms'
+   has been sorted.  Whether the disassembler accepts a symbol depends
+   only on the symbol, so INFO->symbol_is_valid is asked here once for
+   each symbol rather than on every lookup.  */
+
+static void
+build_symbol_index (struct disassemble_info *info)
+{
+  long i;
+
+  valid_syms = (long *) xmalloc ((sorted_symcount + 1) * sizeof (long));
+  section_syms = (long *) xmalloc ((sorted_symcount + 1) * sizeof (long));
+
+  valid_symcount = 0;
+  for (i = 0; i < sorted_symcount; i++)
+    if (info->symbol_is_valid (sorted_syms[i], info))
+      valid_syms[valid_symcount++] = i;
+
+  memcpy (section_syms, valid_syms, valid_symcount * sizeof (long));
+  qsort (section_syms, valid_symcount, sizeof (long), compare_section_syms);
+}
+
+static void
+free_symbol_index (void)
+{
+  free (valid_syms);
+  free (section_syms);
+  valid_syms = NULL;
+  section_syms = NULL;
+  valid_symcount = 0;
+}
+
+/* Return the index of the first symbol in `sorted_syms' whose value is
+   not less than VMA, or greater than VMA if AFTER is TRUE.  */
+
+static long
+sorted_syms_place (bfd_vma vma, bfd_boolean after)
+{
+  long min = 0;
+  long max = sorted_symcount;
+
+  while (min < max)
+    {
+      long thisplace = min + (max - min) / 2;
+      bfd_vma value = bfd_asymbol_value (sorted_syms[thisplace]);
+
+      if (value < vma || (after && value == vma))
+	min = thisplace + 1;
+      else
+	max = thisplace;
+    }
+
+  return min;
+}
+
+/* Return the position of the first entry of LIST between MIN and MAX
+   (exclusive) that is not less than PLACE.  */
+
+static long
+symbol_index_place (const long *list, long min, long max, long place)
+{
+  while (min < max)
+    {
+      long thisplace = min + (max - min) / 2;
+
+      if (list[thisplace] < place)
+	min = thisplace + 1;
+      else
+	max = thisplace;
+    }
+
+  return min;
+}
+
+/* Set *MIN and *MAX to the run of `section_syms' holding the symbols
+   of SEC.  */
+
+static void
+section_syms_run (asection *sec, long *min, long *max)
+{
+  long lo = 0;
+  long hi = valid_symcount;
+
+  while (lo < hi)
+    {
+      long thisplace = lo + (hi - lo) / 2;
+
+      if (sorted_syms[section_syms[thisplace]]->section < sec)
+	lo = thisplace + 1;
+      else
+	hi = thisplace;
+    }
+  *min = lo;
+
+  hi = valid_symcount;
+  while (lo < hi)
+    {
+      long thisplace = lo + (hi - lo) / 2;
+
+      if (sorted_syms[section_syms[thisplace]]->section == sec)
+	lo = thisplace + 1;
+      else
+	hi = thisplace;
+    }
+  *max = lo;
+}
+
 /* Locate a symbol given a bfd and a section (from INFO->application_data),
    and a VMA.  If INFO->application_data->require_sec is TRUE, then always
    require the symbol to be in the section.  Returns NULL if there is no
@@ -726,15 +880,17 @@ find_symbol_for_address (bfd_vma vma,
 			 struct disassemble_info *info,
 			 long *place)
 {
-  /* @@ Would it speed things up to cache the last two symbols returned,
-     and maybe their address ranges?  For many processors, only one memory
-     operand can be present at a time, so the 2-entry cache wouldn't be
-     constantly churned by code doing heavy memory accesses.  */
-
   /* Indices in `sorted_syms'.  */
-  long min = 0;
-  long max = sorted_symcount;
+  long first;
+  long end;
   long thisplace;
+  /* Positions in `section_syms' or `valid_syms'.  */
+  long sec_min;
+  long sec_max;
+  long min;
+  long max;
+  long i;
+  const long *list;
   struct objdump_disasm_info *aux;
   bfd *abfd;
   asection *sec;
@@ -749,54 +905,32 @@ find_symbol_for_address (bfd_vma vma,
   sec = aux->sec;
   opb = info->octets_per_byte;
 
-  /* Perform a binary search looking for the closest symbol to the
-     required value.  We are searching the range (min, max].  */
-  while (min + 1 < max)
+  /* Find the symbols with the closest value not above VMA; they are
+     FIRST up to END.  If every symbol lies above VMA, only the first
+     one is considered.  */
+  end = sorted_syms_place (vma, TRUE);
+  if (end == 0)
     {
-      asymbol *sym;
-
-      thisplace = (max + min) / 2;
-      sym = sorted_syms[thisplace];
-
-      if (bfd_asymbol_value (sym) > vma)
-	max = thisplace;
-      else if (bfd_asymbol_value (sym) < vma)
-	min = thisplace;
-      else
-	{
-	  min = thisplace;
-	  break;
-	}
+      first = 0;
+      end = 1;
     }
-
-  /* The symbol we want is now in min, the low end of the range we
-     were searching.  If there are several symbols with the same
-     value, we want the first one.  */
-  thisplace = min;
-  while (thisplace > 0
-	 && (bfd_asymbol_value (sorted_syms[thisplace])
-	     == bfd_asymbol_value (sorted_syms[thisplace - 1])))
-    --thisplace;
+  else
+    first = sorted_syms_place (bfd_asymbol_value (sorted_syms[end - 1]),
+			       FALSE);
 
   /* Prefer a symbol in the current section if we have multple symbols
      with the same value, as can occur with overlays or zero size
      sections.  */
-  min = thisplace;
-  while (min < max
-	 && (bfd_asymbol_value (sorted_syms[min])
-	     == bfd_asymbol_value (sorted_syms[thisplace])))
+  section_syms_run (sec, &sec_min, &sec_max);
+  i = symbol_index_place (section_syms, sec_min, sec_max, first);
+  if (i < sec_max && section_syms[i] < end)
     {
-      if (sorted_syms[min]->section == sec
-	  && info->symbol_is_valid (sorted_syms[min], info))
-	{
-	  thisplace = min;
+      thisplace = section_syms[i];
 
-	  if (place != NULL)
-	    *place = thisplace;
+      if (place != NULL)
+	*place = thisplace;
 
-	  return sorted_syms[thisplace];
-	}
-      ++min;
+      return sorted_syms[thisplace];
     }
 
   /* If the file is relocatable, and the symbol could be from this
@@ -814,49 +948,38 @@ find_symbol_for_address (bfd_vma vma,
 		      && vma >= bfd_get_section_vma (abfd, sec)
 		      && vma < (bfd_get_section_vma (abfd, sec)
 				+ bfd_section_size (abfd, sec) / opb)));
-  if ((sorted_syms[thisplace]->section != sec && want_section)
-      || !info->symbol_is_valid (sorted_syms[thisplace], info))
+  if (want_section)
+    {
+      list = section_syms;
+      min = sec_min;
+      max = sec_max;
+    }
+  else
     {
-      long i;
-      long newplace = sorted_symcount;
+      list = valid_syms;
+      min = 0;
+      max = valid_symcount;
+    }
 
-      for (i = min - 1; i >= 0; i--)
+  /* Keep the first of the symbols found above if it is suitable.
+     Otherwise take the first suitable symbol with the nearest smaller
+     value, or failing that the first suitable symbol after them.  */
+  i = symbol_index_place (list, min, max, first);
+  if (i < max && list[i] == first)
+    thisplace = first;
+  else
+    {
+      i = symbol_index_place (list, i, max, end);
+      if (i > min)
 	{
-	  if ((sorted_syms[i]->section == sec || !want_section)
-	      && info->symbol_is_valid (sorted_syms[i], info))
-	    {
-	      if (newplace == sorted_symcount)
-		newplace = i;
-
-	      if (bfd_asymbol_value (sorted_syms[i])
-		  != bfd_asymbol_value (sorted_syms[newplace]))
-		break;
+	  bfd_vma value = bfd_asymbol_value (sorted_syms[list[i - 1]]);
 
-	      /* Remember this symbol and keep searching until we reach
-		 an earlier address.  */
-	      newplace = i;
-	    }
+	  first = sorted_syms_place (value, FALSE);
+	  thisplace = list[symbol_index_place (list, min, i, first)];
 	}
-
-      if (newplace != sorted_symcount)
-	thisplace = newplace;
+      else if (i < max)
+	thisplace = list[i];
       else
-	{
-	  /* We didn't find a good symbol with a smaller value.
-	     Look for one with a larger value.  */
-	  for (i = thisplace + 1; i < sorted_symcount; i++)
-	    {
-	      if ((sorted_syms[i]->section == sec || !want_section)
-		  && info->symbol_is_valid (sorted_syms[i], info))
-		{
-		  thisplace = i;
-		  break;
-		}
-	    }
-	}
-
-      if ((sorted_syms[thisplace]->section != sec && want_section)
-	  || !info->symbol_is_valid (sorted_syms[thisplace], info))
 	/* There is no suitable symbol.  */
 	return NULL;
     }
@@ -989,6 +1112,9 @@ objdump_symbol_at_address (bfd_vma vma, struct disassemble_info * info)
 static char *prev_functionname;
 static unsigned int prev_line;
 
+/* The number of threads to disassemble the current file on.  */
+static unsigned int disassemble_threads;
+
 /* We keep a list of all files that we have seen when doing a
    disassembly with source, so that we know how much of the file to
    display.  This can be important for inlined functions.  */
@@ -1414,6 +1540,7 @@ disassemble_bytes (struct disassemble_info * info,
   unsigned int skip_zeroes_at_end = info->skip_zeroes_at_end;
   int octets = opb;
   SFILE sfile;
+  FILE *out = (FILE *) info->stream;
 
   aux = (struct objdump_disasm_info *) info->application_data;
   section = aux->sec;
@@ -1493,12 +1620,13 @@ disassemble_bytes (struct disassemble_info * info,
 	     file offsets, then tell the user how many zeroes we skip
 	     and the file offset from where we resume dumping.  */
 	  if (display_file_offsets && ((addr_offset + (octets / opb)) < stop_offset))
-	    printf ("\t... (skipping %d zeroes, resuming at file offset: 0x%lx)\n",
-		    octets / opb,
-		    (unsigned long) (section->filepos
-				     + (addr_offset + (octets / opb))));
+	    fprintf (out, "\t... (skipping %d zeroes, "
+		     "resuming at file offset: 0x%lx)\n",
+		     octets / opb,
+		     (unsigned long) (section->filepos
+				      + (addr_offset + (octets / opb))));
 	  else
-	    printf ("\t...\n");
+	    fprintf (out, "\t...\n");
 	}
       else
 	{
@@ -1520,14 +1648,14 @@ disassemble_bytes (struct disassemble_info * info,
 		*s = ' ';
 	      if (*s == '\0')
 		*--s = '0';
-	      printf ("%s:\t", buf + skip_addr_chars);
+	      fprintf (out, "%s:\t", buf + skip_addr_chars);
 	    }
 	  else
 	    {
 	      aux->require_sec = TRUE;
 	      objdump_print_address (section->vma + addr_offset, info);
 	      aux->require_sec = FALSE;
-	      putchar (' ');
+	      putc (' ', out);
 	    }
 
 	  if (insns)
@@ -1575,13 +1703,13 @@ disassemble_bytes (struct disassemble_info * info,
 
 	      octets = (*disassemble_fn) (section->vma + addr_offset, info);
 	      info->fprintf_func = (fprintf_ftype) fprintf;
-	      info->stream = stdout;
+	      info->stream = out;
 	      if (insn_width == 0 && info->bytes_per_line != 0)
 		octets_per_line = info->bytes_per_line;
 	      if (octets < 0)
 		{
 		  if (sfile.pos)
-		    printf ("%s\n", sfile.buffer);
+		    fprintf (out, "%s\n", sfile.buffer);
 		  break;
 		}
 	    }
@@ -1627,14 +1755,14 @@ disassemble_bytes (struct disassemble_info * info,
 		  if (bpc > 1 && info->display_endian == BFD_ENDIAN_LITTLE)
 		    {
 		      for (k = bpc - 1; k >= 0; k--)
-			printf ("%02x", (unsigned) data[j + k]);
-		      putchar (' ');
+			fprintf (out, "%02x", (unsigned) data[j + k]);
+		      putc (' ', out);
 		    }
 		  else
 		    {
 		      for (k = 0; k < bpc; k++)
-			printf ("%02x", (unsigned) data[j + k]);
-		      putchar (' ');
+			fprintf (out, "%02x", (unsigned) data[j + k]);
+		      putc (' ', out);
 		    }
 		}
 
@@ -1643,21 +1771,21 @@ disassemble_bytes (struct disassemble_info * info,
 		  int k;
 
 		  for (k = 0; k < bpc; k++)
-		    printf ("  ");
-		  putchar (' ');
+		    fprintf (out, "  ");
+		  putc (' ', out);
 		}
 
 	      /* Separate raw data from instruction by extra space.  */
 	      if (insns)
-		putchar ('\t');
+		putc ('\t', out);
 	      else
-		printf ("    ");
+		fprintf (out, "    ");
 	    }
 
 	  if (! insns)
-	    printf ("%s", buf);
+	    fprintf (out, "%s", buf);
 	  else if (sfile.pos)
-	    printf ("%s", sfile.buffer);
+	    fprintf (out, "%s", sfile.buffer);
 
 	  if (prefix_addresses
 	      ? show_raw_insn > 0
@@ -1668,7 +1796,7 @@ disassemble_bytes (struct disassemble_info * info,
 		  bfd_vma j;
 		  char *s;
 
-		  putchar ('\n');
+		  putc ('\n', out);
 		  j = addr_offset * opb + pb;
 
 		  bfd_sprintf_vma (aux->abfd, buf, section->vma + j / opb);
@@ -1676,7 +1804,7 @@ disassemble_bytes (struct disassemble_info * info,
 		    *s = ' ';
 		  if (*s == '\0')
 		    *--s = '0';
-		  printf ("%s:\t", buf + skip_addr_chars);
+		  fprintf (out, "%s:\t", buf + skip_addr_chars);
 
 		  pb += octets_per_line;
 		  if (pb > octets)
@@ -1688,21 +1816,21 @@ disassemble_bytes (struct disassemble_info * info,
 		      if (bpc > 1 && info->display_endian == BFD_ENDIAN_LITTLE)
 			{
 			  for (k = bpc - 1; k >= 0; k--)
-			    printf ("%02x", (unsigned) data[j + k]);
-			  putchar (' ');
+			    fprintf (out, "%02x", (unsigned) data[j + k]);
+			  putc (' ', out);
 			}
 		      else
 			{
 			  for (k = 0; k < bpc; k++)
-			    printf ("%02x", (unsigned) data[j + k]);
-			  putchar (' ');
+			    fprintf (out, "%02x", (unsigned) data[j + k]);
+			  putc (' ', out);
 			}
 		    }
 		}
 	    }
 
 	  if (!wide_output)
-	    putchar ('\n');
+	    putc ('\n', out);
 	  else
 	    need_nl = TRUE;
 	}
@@ -1717,22 +1845,22 @@ disassemble_bytes (struct disassemble_info * info,
 	      q = **relppp;
 
 	      if (wide_output)
-		putchar ('\t');
+		putc ('\t', out);
 	      else
-		printf ("\t\t\t");
+		fprintf (out, "\t\t\t");
 
 	      objdump_print_value (section->vma - rel_offset + q->address,
 				   info, TRUE);
 
 	      if (q->howto == NULL)
-		printf (": *unknown*\t");
+		fprintf (out, ": *unknown*\t");
 	      else if (q->howto->name)
-		printf (": %s\t", q->howto->name);
+		fprintf (out, ": %s\t", q->howto->name);
 	      else
-		printf (": %d\t", q->howto->type);
+		fprintf (out, ": %d\t", q->howto->type);
 
 	      if (q->sym_ptr_ptr == NULL || *q->sym_ptr_ptr == NULL)
-		printf ("*unknown*");
+		fprintf (out, "*unknown*");
 	      else
 		{
 		  const char *sym_name;
@@ -1748,24 +1876,24 @@ disassemble_bytes (struct disassemble_info * info,
 		      sym_name = bfd_get_section_name (aux->abfd, sym_sec);
 		      if (sym_name == NULL || *sym_name == '\0')
 			sym_name = "*unknown*";
-		      printf ("%s", sym_name);
+		      fprintf (out, "%s", sym_name);
 		    }
 		}
 
 	      if (q->addend)
 		{
-		  printf ("+0x");
+		  fprintf (out, "+0x");
 		  objdump_print_value (q->addend, info, TRUE);
 		}
 
-	      printf ("\n");
+	      fprintf (out, "\n");
 	      need_nl = FALSE;
 	    }
 	  ++(*relppp);
 	}
 
       if (need_nl)
-	printf ("\n");
+	fprintf (out, "\n");
 
       addr_offset += octets / opb;
     }
@@ -1773,6 +1901,292 @@ disassemble_bytes (struct disassemble_info * info,
   free (sfile.buffer);
 }
 
+/* A stretch of a section from one symbol to the next, disassembled
+   by one call to disassemble_bytes.  */
+
+struct disassemble_block
+{
+  /* The symbol labelling the stretch, and its address.  */
+  asymbol *sym;
+  bfd_vma addr;
+  /* The offsets in the section of the start and end of the stretch.  */
+  unsigned long start_offset;
+  unsigned long stop_offset;
+  /* The symbols to pass on to the disassembler.  */
+  asymbol **symbols;
+  int num_symbols;
+  int symtab_pos;
+  /* Whether the stretch holds instructions rather than data.  */
+  bfd_boolean insns;
+};
+
+/* Print the label of BLOCK, and disassemble it from DATA.  Relocs are
+   used as for disassemble_bytes.  */
+
+static void
+disassemble_block (struct disassemble_info *pinfo,
+		   struct disassemble_block *block, bfd_byte *data,
+		   bfd_vma rel_offset, arelent ***relppp, arelent **relppend)
+{
+  struct objdump_disasm_info *paux;
+
+  paux = (struct objdump_disasm_info *) pinfo->application_data;
+  pinfo->symbols = block->symbols;
+  pinfo->num_symbols = block->num_symbols;
+  pinfo->symtab_pos = block->symtab_pos;
+
+  if (! prefix_addresses)
+    {
+      pinfo->fprintf_func (pinfo->stream, "\n");
+      objdump_print_addr_with_sym (paux->abfd, paux->sec, block->sym,
+				   block->addr, pinfo, FALSE);
+      pinfo->fprintf_func (pinfo->stream, ":\n");
+    }
+
+  disassemble_bytes (pinfo, paux->disassemble_fn, block->insns, data,
+		     block->start_offset, block->stop_offset,
+		     rel_offset, relppp, relppend);
+}
+
+#ifdef OBJDUMP_THREADS
+
+/* With --threads, the blocks of a large section are grouped into
+   chunks of about this many octets, which worker threads disassemble
+   into memory.  The main thread prints the chunks in order.  */
+#define DISASSEMBLE_CHUNK_SIZE (64 * 1024)
+
+struct disassemble_chunk
+{
+  struct disassemble_block *blocks;
+  size_t count;
+  /* The index of the first reloc the chunk looks at, and of the first
+     reloc it left for the next chunk.  */
+  long rel_start;
+  long rel_end;
+  /* What the chunk printed, once it is done.  */
+  char *output;
+  size_t size;
+  bfd_boolean done;
+};
+
+struct disassemble_work
+{
+  struct disassemble_info *pinfo;
+  bfd_byte *data;
+  bfd_vma rel_offset;
+  arelent **relpp;
+  arelent **relppend;
+  struct disassemble_chunk *chunks;
+  size_t count;
+  /* The next chunk to disassemble, and the number printed.  */
+  size_t next;
+  size_t printed;
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+};
+
+/* Disassemble chunks of WORK until there are none left.  */
+
+static void *
+disassemble_worker (void *arg)
+{
+  struct disassemble_work *work = (struct disassemble_work *) arg;
+  struct disassemble_info info;
+  struct objdump_disasm_info aux;
+
+  /* Each thread needs its own copy of the state disassemble_bytes
+     changes as it goes.  */
+  info = *work->pinfo;
+  aux = *(struct objdump_disasm_info *) info.application_data;
+  info.application_data = &aux;
+
+  pthread_mutex_lock (&work->lock);
+  for (;;)
+    {
+      struct disassemble_chunk *chunk;
+      FILE *out;
+
+      /* Don't run too far ahead of the chunks printed.  */
+      while (work->next < work->count
+	     && work->next >= work->printed + 4 * disassemble_threads)
+	pthread_cond_wait (&work->cond, &work->lock);
+      if (work->next >= work->count)
+	break;
+      chunk = &work->chunks[work->next++];
+      pthread_mutex_unlock (&work->lock);
+
+      out = open_memstream (&chunk->output, &chunk->size);
+      if (out != NULL)
+	{
+	  arelent **relpp = work->relpp + chunk->rel_start;
+	  size_t i;
+
+	  info.stream = out;
+	  for (i = 0; i < chunk->count; i++)
+	    disassemble_block (&info, &chunk->blocks[i], work->data,
+			       work->rel_offset, &relpp, work->relppend);
+	  chunk->rel_end = relpp - work->relpp;
+	  fclose (out);
+	}
+
+      pthread_mutex_lock (&work->lock);
+      chunk->done = TRUE;
+      pthread_cond_broadcast (&work->cond);
+    }
+  pthread_mutex_unlock (&work->lock);
+  return NULL;
+}
+
+/* Disassemble the COUNT BLOCKS of a section on several threads, and
+   print them in order.  The arguments are as for disassemble_block.  */
+
+static void
+disassemble_blocks (struct disassemble_info *pinfo,
+		    struct disassemble_block *blocks, size_t count,
+		    bfd_byte *data, bfd_vma rel_offset,
+		    arelent ***relppp, arelent **relppend)
+{
+  struct objdump_disasm_info *paux;
+  struct disassemble_work work;
+  struct disassemble_chunk *chunk;
+  pthread_t *threads;
+  unsigned int nthreads;
+  arelent **scan;
+  size_t i, j;
+  long rel;
+  SFILE sfile;
+
+  /* Group the blocks into chunks.  Each chunk starts with the first
+     reloc at or after its start, which is where the chunk before it
+     will usually have left off.  */
+  work.chunks = (struct disassemble_chunk *)
+      xmalloc (count * sizeof (*work.chunks));
+  work.count = 0;
+  scan = *relppp;
+  for (i = 0; i < count; i = j)
+    {
+      unsigned long size = 0;
+
+      for (j = i; j < count && size < DISASSEMBLE_CHUNK_SIZE; j++)
+	size += ((blocks[j].stop_offset - blocks[j].start_offset)
+		 * pinfo->octets_per_byte);
+      while (scan < relppend
+	     && (*scan)->address < rel_offset + blocks[i].start_offset)
+	++scan;
+
+      chunk = &work.chunks[work.count++];
+      chunk->blocks = blocks + i;
+      chunk->count = j - i;
+      chunk->rel_start = scan - *relppp;
+      chunk->rel_end = chunk->rel_start;
+      chunk->output = NULL;
+      chunk->size = 0;
+      chunk->done = FALSE;
+    }
+
+  work.pinfo = pinfo;
+  work.data = data;
+  work.rel_offset = rel_offset;
+  work.relpp = *relppp;
+  work.relppend = relppend;
+  work.next = 0;
+  work.printed = 0;
+  pthread_mutex_init (&work.lock, NULL);
+  pthread_cond_init (&work.cond, NULL);
+
+  /* Let the disassembler set up whatever it sets up on first use
+     before several threads call it at once.  */
+  paux = (struct objdump_disasm_info *) pinfo->application_data;
+  sfile.alloc = 120;
+  sfile.buffer = (char *) xmalloc (sfile.alloc);
+  sfile.pos = 0;
+  pinfo->fprintf_func = (fprintf_ftype) objdump_sprintf;
+  pinfo->stream = &sfile;
+  paux->reloc = NULL;
+  (*paux->disassemble_fn) (pinfo->buffer_vma + blocks[0].start_offset, pinfo);
+  pinfo->fprintf_func = (fprintf_ftype) fprintf;
+  pinfo->stream = stdout;
+  free (sfile.buffer);
+
+  nthreads = disassemble_threads;
+  if (nthreads > work.count)
+    nthreads = work.count;
+  threads = (pthread_t *) xmalloc (nthreads * sizeof (*threads));
+  for (i = 0; i < nthreads; i++)
+    if (pthread_create (&threads[i], NULL, disassemble_worker, &work) != 0)
+      break;
+  nthreads = i;
+
+  rel = 0;
+  for (i = 0; i < work.count; i++)
+    {
+      chunk = &work.chunks[i];
+
+      pthread_mutex_lock (&work.lock);
+      while (nthreads != 0 && ! chunk->done)
+	pthread_cond_wait (&work.cond, &work.lock);
+      pthread_mutex_unlock (&work.lock);
+
+      if (chunk->done && chunk->output != NULL && chunk->rel_start == rel)
+	{
+	  fwrite (chunk->output, 1, chunk->size, stdout);
+	  rel = chunk->rel_end;
+	}
+      else
+	{
+	  /* The chunk was not disassembled, or the chunk before it left
+	     off at another reloc, so disassemble it again here.  */
+	  arelent **relpp = work.relpp + rel;
+
+	  for (j = 0; j < chunk->count; j++)
+	    disassemble_block (pinfo, &chunk->blocks[j], data, rel_offset,
+			       &relpp, relppend);
+	  rel = relpp - work.relpp;
+	}
+      free (chunk->output);
+      chunk->output = NULL;
+
+      pthread_mutex_lock (&work.lock);
+      work.printed = i + 1;
+      pthread_cond_broadcast (&work.cond);
+      pthread_mutex_unlock (&work.lock);
+    }
+
+  for (i = 0; i < nthreads; i++)
+    pthread_join (threads[i], NULL);
+  free (threads);
+  pthread_cond_destroy (&work.cond);
+  pthread_mutex_destroy (&work.lock);
+  free (work.chunks);
+
+  *relppp = work.relpp + rel;
+}
+
+#endif /* OBJDUMP_THREADS */
+
+/* Return the DATASIZE bytes of contents of SECTION, for reading only.
+   If they had to be copied, the copy is returned in *BUF too, for the
+   caller to free; otherwise *BUF is set to NULL.  */
+
+static bfd_byte *
+get_section_data (bfd *abfd, asection *section, bfd_size_type datasize,
+		  bfd_byte **buf)
+{
+  const bfd_byte *view = NULL;
+
+  if (section->rawsize == 0 || section->rawsize >= datasize)
+    view = bfd_section_contents_view (abfd, section);
+  if (view != NULL)
+    {
+      *buf = NULL;
+      return (bfd_byte *) view;
+    }
+
+  *buf = (bfd_byte *) xmalloc (datasize);
+  bfd_get_section_contents (abfd, section, *buf, 0, datasize);
+  return *buf;
+}
+
 static void
 disassemble_section (bfd *abfd, asection *section, void *info)
 {
@@ -1782,6 +2196,7 @@ disassemble_section (bfd *abfd, asection *section, void *info)
   struct objdump_disasm_info * paux;
   unsigned int                 opb = pinfo->octets_per_byte;
   bfd_byte *                   data = NULL;
+  bfd_byte *                   data_buf;
   bfd_size_type                datasize = 0;
   arelent **                   rel_pp = NULL;
   arelent **                   rel_ppstart = NULL;
@@ -1792,6 +2207,11 @@ disassemble_section (bfd *abfd, asection *section, void *info)
   long                         rel_count;
   bfd_vma                      rel_offset;
   unsigned long                addr_offset;
+#ifdef OBJDUMP_THREADS
+  struct disassemble_block *   blocks = NULL;
+  size_t                       block_count = 0;
+  size_t                       blocks_size = 0;
+#endif
 
   /* Sections that do not contain machine
      code are not normally disassembled.  */
@@ -1848,9 +2268,7 @@ disassemble_section (bfd *abfd, asection *section, void *info)
     }
   rel_ppend = rel_pp + rel_count;
 
-  data = (bfd_byte *) xmalloc (datasize);
-
-  bfd_get_section_contents (abfd, section, data, 0, datasize);
+  data = get_section_data (abfd, section, datasize, &data_buf);
 
   paux->sec = section;
   pinfo->buffer = data;
@@ -1900,6 +2318,17 @@ disassemble_section (bfd *abfd, asection *section, void *info)
       && bed->sign_extend_vma)
     sign_adjust = (bfd_vma) 1 << (bed->s->arch_size - 1);
 
+#ifdef OBJDUMP_THREADS
+  /* Only share a large section out between threads.  */
+  if (disassemble_threads > 1
+      && stop_offset - addr_offset >= 2 * DISASSEMBLE_CHUNK_SIZE / opb)
+    {
+      blocks_size = 64;
+      blocks = (struct disassemble_block *)
+	  xmalloc (blocks_size * sizeof (*blocks));
+    }
+#endif
+
   /* Disassemble a block of instructions up to the address associated with
      the symbol we have just found.  Then print the symbol and find the
      next symbol on.  Repeat until we have disassembled the entire section
@@ -1909,7 +2338,7 @@ disassemble_section (bfd *abfd, asection *section, void *info)
       bfd_vma addr;
       asymbol *nextsym;
       unsigned long nextstop_offset;
-      bfd_boolean insns;
+      struct disassemble_block block;
 
       addr = section->vma + addr_offset;
       addr = ((addr & ((sign_adjust << 1) - 1)) ^ sign_adjust) - sign_adjust;
@@ -1924,23 +2353,15 @@ disassemble_section (bfd *abfd, asection *section, void *info)
 	       ++x)
 	    continue;
 
-	  pinfo->symbols = sorted_syms + place;
-	  pinfo->num_symbols = x - place;
-	  pinfo->symtab_pos = place;
+	  block.symbols = sorted_syms + place;
+	  block.num_symbols = x - place;
+	  block.symtab_pos = place;
 	}
       else
 	{
-	  pinfo->symbols = NULL;
-	  pinfo->num_symbols = 0;
-	  pinfo->symtab_pos = -1;
-	}
-
-      if (! prefix_addresses)
-	{
-	  pinfo->fprintf_func (pinfo->stream, "\n");
-	  objdump_print_addr_with_sym (abfd, section, sym, addr,
-				       pinfo, FALSE);
-	  pinfo->fprintf_func (pinfo->stream, ":\n");
+	  block.symbols = NULL;
+	  block.num_symbols = 0;
+	  block.symtab_pos = -1;
 	}
 
       if (sym != NULL && bfd_asymbol_value (sym) > addr)
@@ -1992,19 +2413,45 @@ disassemble_section (bfd *abfd, asection *section, void *info)
 	      && (strstr (bfd_asymbol_name (sym), "gcc2_compiled")
 		  == NULL))
 	  || (sym->flags & BSF_FUNCTION) != 0)
-	insns = TRUE;
+	block.insns = TRUE;
       else
-	insns = FALSE;
+	block.insns = FALSE;
+
+      block.sym = sym;
+      block.addr = addr;
+      block.start_offset = addr_offset;
+      block.stop_offset = nextstop_offset;
+#ifdef OBJDUMP_THREADS
+      if (blocks != NULL)
+	{
+	  if (block_count == blocks_size)
+	    {
+	      blocks_size *= 2;
+	      blocks = (struct disassemble_block *)
+		  xrealloc (blocks, blocks_size * sizeof (*blocks));
+	    }
+	  blocks[block_count++] = block;
+	}
+      else
+#endif
+	disassemble_block (pinfo, &block, data, rel_offset,
+			   &rel_pp, rel_ppend);
 
-      disassemble_bytes (pinfo, paux->disassemble_fn, insns, data,
-			 addr_offset, nextstop_offset,
-			 rel_offset, &rel_pp, rel_ppend);
-      
       addr_offset = nextstop_offset;
       sym = nextsym;
     }
 
-  free (data);
+#ifdef OBJDUMP_THREADS
+  if (blocks != NULL)
+    {
+      disassemble_blocks (pinfo, blocks, block_count, data,
+			  rel_offset, &rel_pp, rel_ppend);
+      free (blocks);
+    }
+#endif
+
+  if (data_buf != NULL)
+    free (data_buf);
 
   if (rel_ppstart != NULL)
     free (rel_ppstart);
@@ -2105,6 +2552,8 @@ disassemble_data (bfd *abfd)
   /* Allow the target to customize the info structure.  */
   disassemble_init_for_target (& disasm_info);
 
+  build_symbol_index (&disasm_info);
+
   /* Pre-load the dynamic relocs if we are going
      to be dumping them along with the disassembly.  */
   if (dump_dynamic_reloc_info)
@@ -2131,10 +2580,22 @@ disassemble_data (bfd *abfd)
   disasm_info.symtab = sorted_syms;
   disasm_info.symtab_size = sorted_symcount;
 
+  /* Only disassemble on several threads for targets whose disassembler
+     keeps no state of its own after its first call, and not when
+     reading line numbers, which BFD caches as it goes.  */
+  disassemble_threads = 1;
+  if (thread_count > 1
+      && ! with_line_numbers
+      && ! with_source_code
+      && (bfd_get_arch (abfd) == bfd_arch_powerpc
+	  || bfd_get_arch (abfd) == bfd_arch_spu))
+    disassemble_threads = thread_count;
+
   bfd_map_over_sections (abfd, disassemble_section, & disasm_info);
 
   if (aux.dynrelbuf != NULL)
     free (aux.dynrelbuf);
+  free_symbol_index ();
   free (sorted_syms);
 }
 
@@ -2530,6 +2991,7 @@ static void
 dump_section (bfd *abfd, asection *section, void *dummy ATTRIBUTE_UNUSED)
 {
   bfd_byte *data = 0;
+  bfd_byte *data_buf;
   bfd_size_type datasize;
   bfd_size_type addr_offset;
   bfd_size_type start_offset;
@@ -2579,9 +3041,7 @@ dump_section (bfd *abfd, asection *section, void *dummy ATTRIBUTE_UNUSED)
 	    (unsigned long) (section->filepos + start_offset));
   printf ("\n");
 
-  data = (bfd_byte *) xmalloc (datasize);
-
-  bfd_get_section_contents (abfd, section, data, 0, datasize);
+  data = get_section_data (abfd, section, datasize, &data_buf);
 
   width = 4;
 
@@ -2648,7 +3108,8 @@ dump_section (bfd *abfd, asection *section, void *dummy ATTRIBUTE_UNUSED)
 	}
       putchar ('\n');
     }
-  free (data);
+  if (data_buf != NULL)
+    free (data_buf);
 }
 
 /* Actually display the various requested regions.  */
@@ -3270,6 +3731,36 @@ main (int argc, char **argv)
 	  if (insn_width <= 0)
 	    fatal (_("error: instruction width must be positive"));
 	  break;
+	case OPTION_THREADS:
+	  thread_count = parse_thread_count (optarg, "--threads");
+	  dwarf_threads = thread_count;
+	  break;
+	case OPTION_DWARF_DEPTH:
+	  {
+	    char *cp;
+
+	    dwarf_cutoff_level = strtoul (optarg, & cp, 0);
+	    if (*cp != 0)
+	      {
+		non_fatal (_("invalid DIE depth: %s"), optarg);
+		usage (stderr, 1);
+	      }
+	    if (dwarf_cutoff_level == 0)
+	      dwarf_cutoff_level = -1;
+	  }
+	  break;
+	case OPTION_DWARF_START:
+	  {
+	    char *cp;
+
+	    dwarf_start_die = strtoul (optarg, & cp, 0);
+	    if (*cp != 0)
+	      {
+		non_fatal (_("invalid DIE offset: %s"), optarg);
+		usage (stderr, 1);
+	      }
+	  }
+	  break;
 	case 'E':
 	  if (strcmp (optarg, "B") == 0)
 	    endian = BFD_ENDIAN_BIG;
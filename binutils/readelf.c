@@ -49,6 +49,15 @@
 #ifdef HAVE_ZLIB_H
 #include <zlib.h>
 #endif
+#if defined (HAVE_MMAP) && defined (HAVE_SYS_MMAN_H)
+#include <sys/mman.h>
+#if !defined (MAP_ANONYMOUS) && defined (MAP_ANON)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#ifdef MAP_ANONYMOUS
+#define USE_FILE_MAP 1
+#endif
+#endif
 
 #if __GNUC__ >= 2
 /* Define BFD64 here, even if our default architecture is 32 bit ELF
@@ -152,6 +161,13 @@ char * program_name = "readelf";
 int do_wide;
 static long archive_file_offset;
 static unsigned long archive_file_size;
+/* The file being dumped, when it has been mapped into memory.  The
+   first FILE_MAP_SIZE bytes at FILE_MAP are the contents of
+   MAPPED_FILE, and they are followed by at least one zero byte.  */
+static FILE * mapped_file;
+static unsigned char * file_map;
+static size_t file_map_size;
+static size_t file_map_length;
 static unsigned long dynamic_addr;
 static bfd_size_type dynamic_size;
 static unsigned int dynamic_nent;
@@ -283,6 +299,71 @@ static void (* byte_put) (unsigned char *, bfd_vma, int);
 #define strneq(a,b,n)	  (strncmp ((a), (b), (n)) == 0)
 #define const_strneq(a,b) (strncmp ((a), (b), sizeof (b) - 1) == 0)
 
+/* Map FILE, which is SIZE bytes long, into memory.  The map is
+   private and writable, but callers that change the contents must
+   work on a copy, because get_data hands out the same bytes again.  */
+
+static void
+map_input_file (FILE * file, off_t size)
+{
+#ifdef USE_FILE_MAP
+  size_t pagesize = getpagesize ();
+  size_t length;
+  void * map;
+
+  if (size <= 0 || (off_t) (size_t) size != size
+      || (size_t) size > ~(size_t) 0 - pagesize)
+    return;
+
+  /* Reserve a zero page past the end of the file, so that a string
+     table at the very end of it is still terminated.  */
+  length = ((size_t) size + pagesize) & ~(pagesize - 1);
+  map = mmap (NULL, length, PROT_READ | PROT_WRITE,
+	      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (map == MAP_FAILED)
+    return;
+  if (mmap (map, (size_t) size, PROT_READ | PROT_WRITE,
+	    MAP_PRIVATE | MAP_FIXED, fileno (file), 0) == MAP_FAILED)
+    {
+      munmap (map, length);
+      return;
+    }
+
+  mapped_file = file;
+  file_map = (unsigned char *) map;
+  file_map_size = size;
+  file_map_length = length;
+#endif
+}
+
+static void
+unmap_input_file (void)
+{
+#ifdef USE_FILE_MAP
+  if (file_map != NULL)
+    munmap (file_map, file_map_length);
+#endif
+  mapped_file = NULL;
+  file_map = NULL;
+  file_map_size = 0;
+  file_map_length = 0;
+}
+
+/* Return TRUE if DATA points into the file map.  */
+
+static bfd_boolean
+in_file_map (const void * data)
+{
+  return (file_map != NULL
+	  && (const unsigned char *) data >= file_map
+	  && (const unsigned char *) data < file_map + file_map_length);
+}
+
+/* Read NMEMB items of SIZE bytes at OFFSET in FILE, into VAR if that
+   is not NULL.  Otherwise, return a pointer into the file map when
+   the data lies within it, or else a malloc'ed buffer with a NUL
+   after the data.  Release the result with free_data.  */
+
 static void *
 get_data (void * var, FILE * file, long offset, size_t size, size_t nmemb,
 	  const char * reason)
@@ -292,6 +373,19 @@ get_data (void * var, FILE * file, long offset, size_t size, size_t nmemb,
   if (size == 0 || nmemb == 0)
     return NULL;
 
+  if (file == mapped_file
+      && archive_file_offset + offset >= 0
+      && nmemb < (~(size_t) 0 - 1) / size
+      && (size_t) (archive_file_offset + offset) <= file_map_size
+      && size * nmemb <= file_map_size - (archive_file_offset + offset))
+    {
+      mvar = file_map + archive_file_offset + offset;
+      if (var == NULL)
+	return mvar;
+      memcpy (var, mvar, size * nmemb);
+      return var;
+    }
+
   if (fseek (file, archive_file_offset + offset, SEEK_SET))
     {
       error (_("Unable to seek to 0x%lx for %s\n"),
@@ -329,6 +423,62 @@ get_data (void * var, FILE * file, long offset, size_t size, size_t nmemb,
   return mvar;
 }
 
+/* Release DATA, which came from get_data.  */
+
+static void
+free_data (void * data)
+{
+  if (! in_file_map (data))
+    free (data);
+}
+
+/* Return a malloc'ed copy of the SIZE bytes at DATA, followed by a
+   NUL.  */
+
+static void *
+copy_data (const void * data, size_t size, const char * reason)
+{
+  char * copy;
+
+  copy = (char *) malloc (size + 1);
+  if (copy == NULL)
+    {
+      error (_("Out of memory allocating 0x%lx bytes for %s\n"),
+	     (unsigned long) size, reason);
+      return NULL;
+    }
+  memcpy (copy, data, size);
+  copy[size] = '\0';
+  return copy;
+}
+
+/* Like get_data, for SIZE bytes that are read as strings or other
+   terminated items: the byte after the data is always a NUL.  */
+
+static void *
+get_string_data (FILE * file, long offset, size_t size, const char * reason)
+{
+  char * data;
+
+  data = (char *) get_data (NULL, file, offset, 1, size, reason);
+  if (data == NULL || ! in_file_map (data) || data[size] == '\0')
+    return data;
+
+  return copy_data (data, size, reason);
+}
+
+/* Return DATA, SIZE bytes from get_data or get_string_data, in memory
+   that the caller may change.  Data in the file map is copied.  */
+
+static void *
+unshare_data (void * data, size_t size, const char * reason)
+{
+  if (! in_file_map (data))
+    return data;
+
+  return copy_data (data, size, reason);
+}
+
 static void
 byte_put_little_endian (unsigned char * field, bfd_vma value, int size)
 {
@@ -674,7 +824,7 @@ slurp_rela_relocs (FILE * file,
 
       if (relas == NULL)
 	{
-	  free (erelas);
+	  free_data (erelas);
 	  error (_("out of memory parsing relocs\n"));
 	  return 0;
 	}
@@ -686,7 +836,7 @@ slurp_rela_relocs (FILE * file,
 	  relas[i].r_addend = BYTE_GET (erelas[i].r_addend);
 	}
 
-      free (erelas);
+      free_data (erelas);
     }
   else
     {
@@ -704,7 +854,7 @@ slurp_rela_relocs (FILE * file,
 
       if (relas == NULL)
 	{
-	  free (erelas);
+	  free_data (erelas);
 	  error (_("out of memory parsing relocs\n"));
 	  return 0;
 	}
@@ -738,7 +888,7 @@ slurp_rela_relocs (FILE * file,
 #endif /* BFD64 */
 	}
 
-      free (erelas);
+      free_data (erelas);
     }
   *relasp = relas;
   *nrelasp = nrelas;
@@ -771,7 +921,7 @@ slurp_rel_relocs (FILE * file,
 
       if (rels == NULL)
 	{
-	  free (erels);
+	  free_data (erels);
 	  error (_("out of memory parsing relocs\n"));
 	  return 0;
 	}
@@ -783,7 +933,7 @@ slurp_rel_relocs (FILE * file,
 	  rels[i].r_addend = 0;
 	}
 
-      free (erels);
+      free_data (erels);
     }
   else
     {
@@ -800,7 +950,7 @@ slurp_rel_relocs (FILE * file,
 
       if (rels == NULL)
 	{
-	  free (erels);
+	  free_data (erels);
 	  error (_("out of memory parsing relocs\n"));
 	  return 0;
 	}
@@ -834,7 +984,7 @@ slurp_rel_relocs (FILE * file,
 #endif /* BFD64 */
 	}
 
-      free (erels);
+      free_data (erels);
     }
   *relsp = rels;
   *nrelsp = nrels;
@@ -2847,6 +2997,9 @@ get_section_type_name (unsigned int sh_type)
 }
 
 #define OPTION_DEBUG_DUMP	512
+#define OPTION_DWARF_DEPTH	513
+#define OPTION_DWARF_START	514
+#define OPTION_THREADS		515
 
 static struct option options[] =
 {
@@ -2878,6 +3031,9 @@ static struct option options[] =
   {"instruction-dump", required_argument, 0, 'i'},
 #endif
   {"debug-dump",       optional_argument, 0, OPTION_DEBUG_DUMP},
+  {"dwarf-depth",      required_argument, 0, OPTION_DWARF_DEPTH},
+  {"dwarf-start",      required_argument, 0, OPTION_DWARF_START},
+  {"threads",          required_argument, 0, OPTION_THREADS},
 
   {"version",	       no_argument, 0, 'v'},
   {"wide",	       no_argument, 0, 'W'},
@@ -2918,7 +3074,10 @@ usage (FILE * stream)
                          Dump the contents of section <number|name> as relocated bytes\n\
   -w[lLiaprmfFsoR] or\n\
   --debug-dump[=rawline,=decodedline,=info,=abbrev,=pubnames,=aranges,=macro,=frames,=str,=loc,=Ranges]\n\
-                         Display the contents of DWARF2 debug sections\n"));
+                         Display the contents of DWARF2 debug sections\n\
+  --dwarf-depth=N        Do not display DIEs at depth N or greater\n\
+  --dwarf-start=N        Do not display DIEs before offset N\n\
+  --threads=N            Display .debug_info and .debug_line in N processes\n"));
 #ifdef SUPPORT_DISASSEMBLY
   fprintf (stream, _("\
   -i --instruction-dump=<number|name>\n\
@@ -3125,6 +3284,46 @@ parse_args (int argc, char ** argv)
 	      dwarf_select_sections_by_names (optarg);
 	    }
 	  break;
+	case OPTION_DWARF_DEPTH:
+	  {
+	    char *cp;
+
+	    dwarf_cutoff_level = strtoul (optarg, & cp, 0);
+	    if (*cp != 0)
+	      {
+		error (_("Invalid DIE depth: %s\n"), optarg);
+		usage (stderr);
+	      }
+	    if (dwarf_cutoff_level == 0)
+	      dwarf_cutoff_level = -1;
+	  }
+	  break;
+	case OPTION_DWARF_START:
+	  {
+	    char *cp;
+
+	    dwarf_start_die = strtoul (optarg, & cp, 0);
+	    if (*cp != 0)
+	      {
+		error (_("Invalid DIE offset: %s\n"), optarg);
+		usage (stderr);
+	      }
+	  }
+	  break;
+	case OPTION_THREADS:
+	  {
+	    char *cp;
+	    unsigned long count;
+
+	    count = strtoul (optarg, & cp, 0);
+	    if (*cp != 0 || count == 0 || count > MAX_THREAD_COUNT)
+	      {
+		error (_("Invalid thread count: %s\n"), optarg);
+		usage (stderr);
+	      }
+	    dwarf_threads = count;
+	  }
+	  break;
 #ifdef SUPPORT_DISASSEMBLY
 	case 'i':
 	  request_dump (DISASS_DUMP);
@@ -3320,7 +3519,7 @@ get_32bit_program_headers (FILE * file, Elf_Internal_Phdr * program_headers)
       internal->p_align  = BYTE_GET (external->p_align);
     }
 
-  free (phdrs);
+  free_data (phdrs);
 
   return 1;
 }
@@ -3354,7 +3553,7 @@ get_64bit_program_headers (FILE * file, Elf_Internal_Phdr * program_headers)
       internal->p_align  = BYTE_GET (external->p_align);
     }
 
-  free (phdrs);
+  free_data (phdrs);
 
   return 1;
 }
@@ -3695,7 +3894,7 @@ get_32bit_section_headers (FILE * file, unsigned int num)
       internal->sh_entsize   = BYTE_GET (shdrs[i].sh_entsize);
     }
 
-  free (shdrs);
+  free_data (shdrs);
 
   return 1;
 }
@@ -3738,7 +3937,7 @@ get_64bit_section_headers (FILE * file, unsigned int num)
       internal->sh_addralign = BYTE_GET (shdrs[i].sh_addralign);
     }
 
-  free (shdrs);
+  free_data (shdrs);
 
   return 1;
 }
@@ -3769,7 +3968,7 @@ get_32bit_elf_symbols (FILE * file, Elf_Internal_Shdr * section)
                                                    _("symtab shndx"));
       if (!shndx)
 	{
-	  free (esyms);
+	  free_data (esyms);
 	  return NULL;
 	}
     }
@@ -3781,8 +3980,8 @@ get_32bit_elf_symbols (FILE * file, Elf_Internal_Shdr * section)
     {
       error (_("Out of memory\n"));
       if (shndx)
-	free (shndx);
-      free (esyms);
+	free_data (shndx);
+      free_data (esyms);
       return NULL;
     }
 
@@ -3804,8 +4003,8 @@ get_32bit_elf_symbols (FILE * file, Elf_Internal_Shdr * section)
     }
 
   if (shndx)
-    free (shndx);
-  free (esyms);
+    free_data (shndx);
+  free_data (esyms);
 
   return isyms;
 }
@@ -3836,7 +4035,7 @@ get_64bit_elf_symbols (FILE * file, Elf_Internal_Shdr * section)
                                                    _("symtab shndx"));
       if (!shndx)
 	{
-	  free (esyms);
+	  free_data (esyms);
 	  return NULL;
 	}
     }
@@ -3848,8 +4047,8 @@ get_64bit_elf_symbols (FILE * file, Elf_Internal_Shdr * section)
     {
       error (_("Out of memory\n"));
       if (shndx)
-	free (shndx);
-      free (esyms);
+	free_data (shndx);
+      free_data (esyms);
       return NULL;
     }
 
@@ -3871,8 +4070,8 @@ get_64bit_elf_symbols (FILE * file, Elf_Internal_Shdr * section)
     }
 
   if (shndx)
-    free (shndx);
-  free (esyms);
+    free_data (shndx);
+  free_data (esyms);
 
   return isyms;
 }
@@ -4134,9 +4333,9 @@ process_section_headers (FILE * file)
 
       if (section->sh_size != 0)
 	{
-	  string_table = (char *) get_data (NULL, file, section->sh_offset,
-                                            1, section->sh_size,
-                                            _("string table"));
+	  string_table = (char *) get_string_data (file, section->sh_offset,
+                                                   section->sh_size,
+                                                   _("string table"));
 
 	  string_table_length = string_table != NULL ? section->sh_size : 0;
 	}
@@ -4240,9 +4439,9 @@ process_section_headers (FILE * file)
 	      continue;
 	    }
 
-	  dynamic_strings = (char *) get_data (NULL, file, section->sh_offset,
-                                               1, section->sh_size,
-                                               _("dynamic strings"));
+	  dynamic_strings = (char *) get_string_data (file, section->sh_offset,
+                                                      section->sh_size,
+                                                      _("dynamic strings"));
 	  dynamic_strings_length = section->sh_size;
 	}
       else if (section->sh_type == SHT_SYMTAB_SHNDX)
@@ -4650,7 +4849,7 @@ process_section_groups (FILE * file)
 	      group_name = SECTION_NAME (section_headers + sym->st_shndx);
 	      strtab_sec = NULL;
 	      if (strtab)
-		free (strtab);
+		free_data (strtab);
 	      strtab = NULL;
 	      strtab_size = 0;
 	    }
@@ -4661,7 +4860,7 @@ process_section_groups (FILE * file)
 		{
 		  strtab_sec = NULL;
 		  if (strtab)
-		    free (strtab);
+		    free_data (strtab);
 		  strtab = NULL;
 		  strtab_size = 0;
 		}
@@ -4670,10 +4869,11 @@ process_section_groups (FILE * file)
 		{
 		  strtab_sec = sec;
 		  if (strtab)
-		    free (strtab);
-		  strtab = (char *) get_data (NULL, file, strtab_sec->sh_offset,
-                                              1, strtab_sec->sh_size,
-                                              _("string table"));
+		    free_data (strtab);
+		  strtab = (char *) get_string_data (file,
+						     strtab_sec->sh_offset,
+						     strtab_sec->sh_size,
+						     _("string table"));
 		  strtab_size = strtab != NULL ? strtab_sec->sh_size : 0;
 		}
 	      group_name = sym->st_name < strtab_size
@@ -4752,7 +4952,7 @@ process_section_groups (FILE * file)
 	    }
 
 	  if (start)
-	    free (start);
+	    free_data (start);
 
 	  group++;
 	}
@@ -4761,7 +4961,7 @@ process_section_groups (FILE * file)
   if (symtab)
     free (symtab);
   if (strtab)
-    free (strtab);
+    free_data (strtab);
   return 1;
 }
 
@@ -4898,16 +5098,17 @@ process_relocs (FILE * file)
 		    {
 		      strsec = section_headers + symsec->sh_link;
 
-		      strtab = (char *) get_data (NULL, file, strsec->sh_offset,
-                                                  1, strsec->sh_size,
-                                                  _("string table"));
+		      strtab = (char *) get_string_data (file,
+							 strsec->sh_offset,
+							 strsec->sh_size,
+							 _("string table"));
 		      strtablen = strtab == NULL ? 0 : strsec->sh_size;
 		    }
 
 		  dump_relocations (file, rel_offset, rel_size,
 				    symtab, nsyms, strtab, strtablen, is_rela);
 		  if (strtab)
-		    free (strtab);
+		    free_data (strtab);
 		  free (symtab);
 		}
 	      else
@@ -5123,7 +5324,7 @@ slurp_ia64_unwind_table (FILE * file,
       tep->end.offset   += aux->seg_base;
       tep->info.offset  += aux->seg_base;
     }
-  free (table);
+  free_data (table);
 
   /* Third, apply any relocations to the unwind table:  */
   for (relsec = section_headers;
@@ -5198,9 +5399,9 @@ ia64_process_unwind (FILE * file)
 	  aux.symtab = GET_ELF_SYMBOLS (file, sec);
 
 	  strsec = section_headers + sec->sh_link;
-	  aux.strtab = (char *) get_data (NULL, file, strsec->sh_offset,
-                                          1, strsec->sh_size,
-                                          _("string table"));
+	  aux.strtab = (char *) get_string_data (file, strsec->sh_offset,
+                                                 strsec->sh_size,
+                                                 _("string table"));
 	  aux.strtab_size = aux.strtab != NULL ? strsec->sh_size : 0;
 	}
       else if (sec->sh_type == SHT_IA_64_UNWIND)
@@ -5282,9 +5483,9 @@ ia64_process_unwind (FILE * file)
 	{
 	  aux.info_size = sec->sh_size;
 	  aux.info_addr = sec->sh_addr;
-	  aux.info = (unsigned char *) get_data (NULL, file, sec->sh_offset, 1,
-                                                 aux.info_size,
-                                                 _("unwind info"));
+	  aux.info = (unsigned char *) get_string_data (file, sec->sh_offset,
+                                                        aux.info_size,
+                                                        _("unwind info"));
 
 	  printf (_("\nUnwind section "));
 
@@ -5305,7 +5506,7 @@ ia64_process_unwind (FILE * file)
 	  if (aux.table)
 	    free ((char *) aux.table);
 	  if (aux.info)
-	    free ((char *) aux.info);
+	    free_data ((char *) aux.info);
 	  aux.table = NULL;
 	  aux.info = NULL;
 	}
@@ -5314,7 +5515,7 @@ ia64_process_unwind (FILE * file)
   if (aux.symtab)
     free (aux.symtab);
   if (aux.strtab)
-    free ((char *) aux.strtab);
+    free_data ((char *) aux.strtab);
 
   return 1;
 }
@@ -5535,7 +5736,7 @@ slurp_hppa_unwind_table (FILE * file,
       tep->reserved4 = (tmp2 >> 27) & 0x1;
       tep->Total_frame_size = tmp2 & 0x7ffffff;
     }
-  free (table);
+  free_data (table);
 
   /* Third, apply any relocations to the unwind table.  */
   for (relsec = section_headers;
@@ -5611,9 +5812,9 @@ hppa_process_unwind (FILE * file)
 	  aux.symtab = GET_ELF_SYMBOLS (file, sec);
 
 	  strsec = section_headers + sec->sh_link;
-	  aux.strtab = (char *) get_data (NULL, file, strsec->sh_offset,
-                                          1, strsec->sh_size,
-                                          _("string table"));
+	  aux.strtab = (char *) get_string_data (file, strsec->sh_offset,
+                                                 strsec->sh_size,
+                                                 _("string table"));
 	  aux.strtab_size = aux.strtab != NULL ? strsec->sh_size : 0;
 	}
       else if (streq (SECTION_NAME (sec), ".PARISC.unwind"))
@@ -5647,7 +5848,7 @@ hppa_process_unwind (FILE * file)
   if (aux.symtab)
     free (aux.symtab);
   if (aux.strtab)
-    free ((char *) aux.strtab);
+    free_data ((char *) aux.strtab);
 
   return 1;
 }
@@ -5861,7 +6062,7 @@ get_32bit_dynamic_section (FILE * file)
   if (dynamic_section == NULL)
     {
       error (_("Out of memory\n"));
-      free (edyn);
+      free_data (edyn);
       return 0;
     }
 
@@ -5873,7 +6074,7 @@ get_32bit_dynamic_section (FILE * file)
       entry->d_un.d_val = BYTE_GET (ext->d_un.d_val);
     }
 
-  free (edyn);
+  free_data (edyn);
 
   return 1;
 }
@@ -5907,7 +6108,7 @@ get_64bit_dynamic_section (FILE * file)
   if (dynamic_section == NULL)
     {
       error (_("Out of memory\n"));
-      free (edyn);
+      free_data (edyn);
       return 0;
     }
 
@@ -5919,7 +6120,7 @@ get_64bit_dynamic_section (FILE * file)
       entry->d_un.d_val = BYTE_GET (ext->d_un.d_val);
     }
 
-  free (edyn);
+  free_data (edyn);
 
   return 1;
 }
@@ -6061,9 +6262,9 @@ process_dynamic_section (FILE * file)
 	      continue;
 	    }
 
-	  dynamic_strings = (char *) get_data (NULL, file, offset, 1,
-                                               str_tab_len,
-                                               _("dynamic string table"));
+	  dynamic_strings
+	    = (char *) get_string_data (file, offset, str_tab_len,
+					_("dynamic string table"));
 	  dynamic_strings_length = str_tab_len;
 	  break;
 	}
@@ -6120,7 +6321,7 @@ process_dynamic_section (FILE * file)
 	      syminfo->si_flags = BYTE_GET (extsym->si_flags);
 	    }
 
-	  free (extsyminfo);
+	  free_data (extsyminfo);
 	}
     }
 
@@ -6669,7 +6870,7 @@ process_version_sections (FILE * file)
 	    if (cnt < section->sh_info)
 	      printf (_("  Version definition past end of section\n"));
 
-	    free (edefs);
+	    free_data (edefs);
 	  }
 	  break;
 
@@ -6768,7 +6969,7 @@ process_version_sections (FILE * file)
 	    if (cnt < section->sh_info)
 	      printf (_("  Version need past end of section\n"));
 
-	    free (eneed);
+	    free_data (eneed);
 	  }
 	  break;
 
@@ -6799,9 +7000,9 @@ process_version_sections (FILE * file)
 
 	    string_sec = section_headers + link_section->sh_link;
 
-	    strtab = (char *) get_data (NULL, file, string_sec->sh_offset, 1,
-                                        string_sec->sh_size,
-                                        _("version string table"));
+	    strtab = (char *) get_string_data (file, string_sec->sh_offset,
+                                               string_sec->sh_size,
+                                               _("version string table"));
 	    if (!strtab)
 	      break;
 
@@ -6822,7 +7023,7 @@ process_version_sections (FILE * file)
                                                 _("version symbol data"));
 	    if (!edata)
 	      {
-		free (strtab);
+		free_data (strtab);
 		break;
 	      }
 
@@ -6832,7 +7033,7 @@ process_version_sections (FILE * file)
 	      data[cnt] = byte_get (edata + cnt * sizeof (short),
 				    sizeof (short));
 
-	    free (edata);
+	    free_data (edata);
 
 	    for (cnt = 0; cnt < total; cnt += 4)
 	      {
@@ -6985,7 +7186,7 @@ process_version_sections (FILE * file)
 	      }
 
 	    free (data);
-	    free (strtab);
+	    free_data (strtab);
 	    free (symbols);
 	  }
 	  break;
@@ -7516,9 +7717,9 @@ process_symbol_table (FILE * file)
 
 	      string_sec = section_headers + section->sh_link;
 
-	      strtab = (char *) get_data (NULL, file, string_sec->sh_offset,
-                                          1, string_sec->sh_size,
-                                          _("string table"));
+	      strtab = (char *) get_string_data (file, string_sec->sh_offset,
+                                                 string_sec->sh_size,
+                                                 _("string table"));
 	      strtab_size = strtab != NULL ? string_sec->sh_size : 0;
 	    }
 
@@ -7684,7 +7885,7 @@ process_symbol_table (FILE * file)
 
 	  free (symtab);
 	  if (strtab != string_table)
-	    free (strtab);
+	    free_data (strtab);
 	}
     }
   else if (do_syms)
@@ -8472,8 +8673,8 @@ get_section_contents (Elf_Internal_Shdr * section, FILE * file)
       return NULL;
     }
 
-  return  (char *) get_data (NULL, file, section->sh_offset, 1, num_bytes,
-                             _("section contents"));
+  return  (char *) get_string_data (file, section->sh_offset, num_bytes,
+                                    _("section contents"));
 }
 
 		      
@@ -8542,7 +8743,7 @@ dump_section_as_strings (Elf_Internal_Shdr * section, FILE * file)
   if (! some_strings_shown)
     printf (_("  No strings found in this section."));
 
-  free (start);
+  free_data (start);
 
   putchar ('\n');
 }
@@ -8566,6 +8767,10 @@ dump_section_as_bytes (Elf_Internal_Shdr * section,
 
   if (relocate)
     {
+      start = (unsigned char *) unshare_data (start, section->sh_size,
+					       _("section contents"));
+      if (start == NULL)
+	return;
       apply_relocations (file, section, start);
     }
   else
@@ -8632,7 +8837,7 @@ dump_section_as_bytes (Elf_Internal_Shdr * section,
       bytes -= lbytes;
     }
 
-  free (start);
+  free_data (start);
 
   putchar ('\n');
 }
@@ -8699,7 +8904,7 @@ uncompress_section_contents (unsigned char ** buffer, dwarf_size_type * size)
       || strm.avail_out != 0)
     goto fail;
 
-  free (compressed_buffer);
+  free_data (compressed_buffer);
   *buffer = uncompressed_buffer;
   *size = uncompressed_size;
   return 1;
@@ -8727,9 +8932,9 @@ load_specific_debug_section (enum dwarf_section_display_enum debug,
   snprintf (buf, sizeof (buf), _("%s section data"), section->name);
   section->address = sec->sh_addr;
   section->size = sec->sh_size;
-  section->start = (unsigned char *) get_data (NULL, (FILE *) file,
-                                               sec->sh_offset, 1,
-                                               sec->sh_size, buf);
+  section->start = (unsigned char *) get_string_data ((FILE *) file,
+                                                      sec->sh_offset,
+                                                      sec->sh_size, buf);
   if (section->start == NULL)
     return 0;
 
@@ -8737,8 +8942,19 @@ load_specific_debug_section (enum dwarf_section_display_enum debug,
     if (! uncompress_section_contents (&section->start, &section->size))
       return 0;
 
-  if (debug_displays [debug].relocate)
-    apply_relocations ((FILE *) file, sec, section->start);
+  if (debug_displays [debug].relocate && elf_header.e_type == ET_REL)
+    {
+      /* Relocating changes the contents, and the section may be
+	 loaded again.  */
+      unsigned char * start;
+
+      start = (unsigned char *) unshare_data (section->start, section->size,
+					       buf);
+      if (start == NULL)
+	return 0;
+      section->start = start;
+      apply_relocations ((FILE *) file, sec, section->start);
+    }
 
   return 1;
 }
@@ -8773,7 +8989,7 @@ free_debug_section (enum dwarf_section_display_enum debug)
   if (section->start == NULL)
     return;
 
-  free ((char *) section->start);
+  free_data ((char *) section->start);
   section->start = NULL;
   section->address = 0;
   section->size = 0;
@@ -9417,8 +9633,9 @@ process_attributes (FILE * file,
       if (sect->sh_type != proc_type && sect->sh_type != SHT_GNU_ATTRIBUTES)
 	continue;
 
-      contents = (unsigned char *) get_data (NULL, file, sect->sh_offset, 1,
-                                             sect->sh_size, _("attributes"));
+      contents = (unsigned char *) get_string_data (file, sect->sh_offset,
+						    sect->sh_size,
+						    _("attributes"));
       if (contents == NULL)
 	continue;
 
@@ -9531,7 +9748,7 @@ process_attributes (FILE * file,
       else
 	printf (_("Unknown format '%c'\n"), *p);
 
-      free (contents);
+      free_data (contents);
     }
   return 1;
 }
@@ -9752,7 +9969,7 @@ process_mips_specific (FILE * file)
 		}
 	    }
 
-	  free (elib);
+	  free_data (elib);
 	}
     }
 
@@ -9951,7 +10168,7 @@ process_mips_specific (FILE * file)
 	      ++option;
 	    }
 
-	  free (eopt);
+	  free_data (eopt);
 	}
     }
 
@@ -9986,7 +10203,7 @@ process_mips_specific (FILE * file)
 	  for (cnt = 0; cnt < conflictsno; ++cnt)
 	    iconf[cnt] = BYTE_GET (econf32[cnt]);
 
-	  free (econf32);
+	  free_data (econf32);
 	}
       else
 	{
@@ -10001,7 +10218,7 @@ process_mips_specific (FILE * file)
 	  for (cnt = 0; cnt < conflictsno; ++cnt)
 	    iconf[cnt] = BYTE_GET (econf64[cnt]);
 
-	  free (econf64);
+	  free_data (econf64);
 	}
 
       printf (_("\nSection '.conflict' contains %lu entries:\n"),
@@ -10105,7 +10322,7 @@ process_mips_specific (FILE * file)
 	}
 
       if (data)
-	free (data);
+	free_data (data);
     }
 
   if (mips_pltgot != 0 && jmprel != 0 && pltrel != 0 && pltrelsz != 0)
@@ -10172,7 +10389,7 @@ process_mips_specific (FILE * file)
       printf ("\n");
 
       if (data)
-	free (data);
+	free_data (data);
       free (rels);
     }
 
@@ -10211,15 +10428,15 @@ process_gnu_liblist (FILE * file)
 	    break;
 	  string_sec = section_headers + section->sh_link;
 
-	  strtab = (char *) get_data (NULL, file, string_sec->sh_offset, 1,
-                                      string_sec->sh_size,
-                                      _("liblist string table"));
+	  strtab = (char *) get_string_data (file, string_sec->sh_offset,
+                                             string_sec->sh_size,
+                                             _("liblist string table"));
 	  strtab_size = string_sec->sh_size;
 
 	  if (strtab == NULL
 	      || section->sh_entsize != sizeof (Elf32_External_Lib))
 	    {
-	      free (elib);
+	      free_data (elib);
 	      break;
 	    }
 
@@ -10260,7 +10477,7 @@ process_gnu_liblist (FILE * file)
 		      liblist.l_version, liblist.l_flags);
 	    }
 
-	  free (elib);
+	  free_data (elib);
 	}
     }
 
@@ -10457,8 +10674,8 @@ process_corefile_note_segment (FILE * file, bfd_vma offset, bfd_vma length)
   if (length <= 0)
     return 0;
 
-  pnotes = (Elf_External_Note *) get_data (NULL, file, offset, 1, length,
-                                           _("notes"));
+  pnotes = (Elf_External_Note *) get_string_data (file, offset, length,
+                                                  _("notes"));
   if (!pnotes)
     return 0;
 
@@ -10525,7 +10742,7 @@ process_corefile_note_segment (FILE * file, bfd_vma offset, bfd_vma length)
 	}
     }
 
-  free (pnotes);
+  free_data (pnotes);
 
   return res;
 }
@@ -10803,14 +11020,14 @@ process_object (char * file_name, FILE * file)
 
   if (string_table)
     {
-      free (string_table);
+      free_data (string_table);
       string_table = NULL;
       string_table_length = 0;
     }
 
   if (dynamic_strings)
     {
-      free (dynamic_strings);
+      free_data (dynamic_strings);
       dynamic_strings = NULL;
       dynamic_strings_length = 0;
     }
@@ -11525,6 +11742,8 @@ process_file (char * file_name)
       return 1;
     }
 
+  map_input_file (file, statbuf.st_size);
+
   if (memcmp (armag, ARMAG, SARMAG) == 0)
     ret = process_archive (file_name, file, FALSE);
   else if (memcmp (armag, ARMAGT, SARMAG) == 0)
@@ -11540,6 +11759,7 @@ process_file (char * file_name)
       ret = process_object (file_name, file);
     }
 
+  unmap_input_file ();
   fclose (file);
 
   return ret;
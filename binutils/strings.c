@@ -80,6 +80,14 @@ extern int errno;
 /* The BFD section flags that identify an initialized data section.  */
 #define DATA_FLAGS (SEC_ALLOC | SEC_LOAD | SEC_HAS_CONTENTS)
 
+/* The number of bytes read from a file at a time.  */
+#define STRINGS_BLOCK_SIZE (64 * 1024)
+
+/* A word with only the lowest bit, and with only the highest bit,
+   set in each byte.  */
+#define WORD_ONES (~(unsigned long) 0 / 0xff)
+#define WORD_HIGHS (WORD_ONES * 0x80)
+
 #ifdef HAVE_FOPEN64
 typedef off64_t file_off;
 #define file_open(s,m) fopen64(s, m)
@@ -142,12 +150,35 @@ typedef struct
   bfd_size_type filesize;
 } filename_and_size_t;
 
+/* The state of a search for strings.  */
+
+struct string_scan
+{
+  const char *filename;
+  /* The address of the next character.  */
+  file_off address;
+  int stop_point;
+  /* The address and length of the run of graphic characters being
+     looked at, and its first `string_min' characters.  */
+  file_off start;
+  int run;
+  char *buf;
+  /* TRUE once the run is long enough to be printed.  */
+  bfd_boolean printing;
+  /* TRUE once STOP_POINT has been reached.  */
+  bfd_boolean stopped;
+};
+
 static void strings_a_section (bfd *, asection *, void *);
 static bfd_boolean strings_object_file (const char *);
 static bfd_boolean strings_file (char *file);
 static void print_strings (const char *, FILE *, file_off, int, int, char *);
 static void usage (FILE *, int);
-static long get_char (FILE *, file_off *, int *, char **);
+static long get_char (const unsigned char *);
+static unsigned long graphic_bytes (const unsigned char *);
+static void print_string_start (struct string_scan *);
+static size_t scan_strings (struct string_scan *, const unsigned char *,
+			    size_t);
 
 int main (int, char **);
 
@@ -455,204 +486,282 @@ strings_file (char *file)
   return TRUE;
 }
 
-/* Read the next character, return EOF if none available.
-   Assume that STREAM is positioned so that the next byte read
-   is at address ADDRESS in the file.
-
-   If STREAM is NULL, do not read from it.
-   The caller can supply a buffer of characters
-   to be processed before the data in STREAM.
-   MAGIC is the address of the buffer and
-   MAGICCOUNT is how many characters are in it.  */
+/* Return the character whose ENCODING_BYTES bytes are at P.  */
 
 static long
-get_char (FILE *stream, file_off *address, int *magiccount, char **magic)
+get_char (const unsigned char *p)
 {
-  int c, i;
-  long r = EOF;
-  unsigned char buf[4];
-
-  for (i = 0; i < encoding_bytes; i++)
-    {
-      if (*magiccount)
-	{
-	  (*magiccount)--;
-	  c = *(*magic)++;
-	}
-      else
-	{
-	  if (stream == NULL)
-	    return EOF;
-
-	  /* Only use getc_unlocked if we found a declaration for it.
-	     Otherwise, libc is not thread safe by default, and we
-	     should not use it.  */
-
-#if defined(HAVE_GETC_UNLOCKED) && HAVE_DECL_GETC_UNLOCKED
-	  c = getc_unlocked (stream);
-#else
-	  c = getc (stream);
-#endif
-	  if (c == EOF)
-	    return EOF;
-	}
-
-      (*address)++;
-      buf[i] = c;
-    }
-
   switch (encoding)
     {
-    case 'S':
-    case 's':
-      r = buf[0];
-      break;
     case 'b':
-      r = (buf[0] << 8) | buf[1];
-      break;
+      return (p[0] << 8) | p[1];
     case 'l':
-      r = buf[0] | (buf[1] << 8);
-      break;
+      return p[0] | (p[1] << 8);
     case 'B':
-      r = ((long) buf[0] << 24) | ((long) buf[1] << 16) |
-	((long) buf[2] << 8) | buf[3];
-      break;
+      return ((long) p[0] << 24) | ((long) p[1] << 16) |
+	((long) p[2] << 8) | p[3];
     case 'L':
-      r = buf[0] | ((long) buf[1] << 8) | ((long) buf[2] << 16) |
-	((long) buf[3] << 24);
-      break;
+      return p[0] | ((long) p[1] << 8) | ((long) p[2] << 16) |
+	((long) p[3] << 24);
+    default:
+      return p[0];
     }
-
-  if (r == EOF)
-    return 0;
-
-  return r;
 }
-
-/* Find the strings in file FILENAME, read from STREAM.
-   Assume that STREAM is positioned so that the next byte read
-   is at address ADDRESS in the file.
-   Stop reading at address STOP_POINT in the file, if nonzero.
 
-   If STREAM is NULL, do not read from it.
-   The caller can supply a buffer of characters
-   to be processed before the data in STREAM.
-   MAGIC is the address of the buffer and
-   MAGICCOUNT is how many characters are in it.
-   Those characters come at address ADDRESS and the data in STREAM follow.  */
+/* Return a word with the top bit set in each byte of the word at P
+   that is a graphic character in a single byte encoding, and with
+   all other bits clear.  */
 
-static void
-print_strings (const char *filename, FILE *stream, file_off address,
-	       int stop_point, int magiccount, char *magic)
+static unsigned long
+graphic_bytes (const unsigned char *p)
 {
-  char *buf = (char *) xmalloc (sizeof (char) * (string_min + 1));
+  unsigned long word, low, tab, graphic;
 
-  while (1)
-    {
-      file_off start;
-      int i;
-      long c;
+  memcpy (&word, p, sizeof (word));
 
-      /* See if the next `string_min' chars are all graphic chars.  */
-    tryline:
-      if (stop_point && address >= stop_point)
-	break;
-      start = address;
-      for (i = 0; i < string_min; i++)
-	{
-	  c = get_char (stream, &address, &magiccount, &magic);
-	  if (c == EOF)
-	    return;
-	  if (! STRING_ISGRAPHIC (c))
-	    /* Found a non-graphic.  Try again starting with next char.  */
-	    goto tryline;
-	  buf[i] = c;
-	}
+  /* Adding to the low seven bits of a byte does not carry into the
+     next byte.  A byte is printable if its top bit is clear and its
+     low bits are at least ' ' but below 0x7f.  */
+  low = word & ~WORD_HIGHS;
+  graphic = ((low + WORD_ONES * (0x80 - ' ')) & ~(low + WORD_ONES)
+	     & ~word & WORD_HIGHS);
 
-      /* We found a run of `string_min' graphic characters.  Print up
-	 to the next non-graphic character.  */
+  /* Find the tabs: the bytes that are zero after xoring with '\t'.  */
+  tab = word ^ (WORD_ONES * '\t');
+  graphic |= ~(((tab & ~WORD_HIGHS) + ~WORD_HIGHS) | tab | ~WORD_HIGHS);
 
-      if (print_filenames)
-	printf ("%s: ", filename);
-      if (print_addresses)
-	switch (address_radix)
-	  {
-	  case 8:
+  if (encoding == 'S')
+    graphic |= word & WORD_HIGHS;
+  return graphic;
+}
+
+/* Print the start of the string that SCAN has found: the file name
+   and address if wanted, and its first STRING_MIN characters.  */
+
+static void
+print_string_start (struct string_scan *scan)
+{
+  file_off start = scan->start;
+
+  if (print_filenames)
+    printf ("%s: ", scan->filename);
+  if (print_addresses)
+    switch (address_radix)
+      {
+      case 8:
 #if __STDC_VERSION__ >= 199901L || (defined(__GNUC__) && __GNUC__ >= 2)
-	    if (sizeof (start) > sizeof (long))
-	      {
+	if (sizeof (start) > sizeof (long))
+	  {
 #ifndef __MSVCRT__
-	        printf ("%7llo ", (unsigned long long) start);
+	    printf ("%7llo ", (unsigned long long) start);
 #else
-	        printf ("%7I64o ", (unsigned long long) start);
+	    printf ("%7I64o ", (unsigned long long) start);
 #endif
-	      }
-	    else
+	  }
+	else
 #elif !BFD_HOST_64BIT_LONG
-	    if (start != (unsigned long) start)
-	      printf ("++%7lo ", (unsigned long) start);
-	    else
+	if (start != (unsigned long) start)
+	  printf ("++%7lo ", (unsigned long) start);
+	else
 #endif
-	      printf ("%7lo ", (unsigned long) start);
-	    break;
+	  printf ("%7lo ", (unsigned long) start);
+	break;
 
-	  case 10:
+      case 10:
 #if __STDC_VERSION__ >= 199901L || (defined(__GNUC__) && __GNUC__ >= 2)
-	    if (sizeof (start) > sizeof (long))
-	      {
+	if (sizeof (start) > sizeof (long))
+	  {
 #ifndef __MSVCRT__
-	        printf ("%7lld ", (unsigned long long) start);
+	    printf ("%7lld ", (unsigned long long) start);
 #else
-	        printf ("%7I64d ", (unsigned long long) start);
+	    printf ("%7I64d ", (unsigned long long) start);
 #endif
-	      }
-	    else
+	  }
+	else
 #elif !BFD_HOST_64BIT_LONG
-	    if (start != (unsigned long) start)
-	      printf ("++%7ld ", (unsigned long) start);
-	    else
+	if (start != (unsigned long) start)
+	  printf ("++%7ld ", (unsigned long) start);
+	else
 #endif
-	      printf ("%7ld ", (long) start);
-	    break;
+	  printf ("%7ld ", (long) start);
+	break;
 
-	  case 16:
+      case 16:
 #if __STDC_VERSION__ >= 199901L || (defined(__GNUC__) && __GNUC__ >= 2)
-	    if (sizeof (start) > sizeof (long))
-	      {
+	if (sizeof (start) > sizeof (long))
+	  {
 #ifndef __MSVCRT__
-	        printf ("%7llx ", (unsigned long long) start);
+	    printf ("%7llx ", (unsigned long long) start);
 #else
-	        printf ("%7I64x ", (unsigned long long) start);
+	    printf ("%7I64x ", (unsigned long long) start);
 #endif
-	      }
-	    else
+	  }
+	else
 #elif !BFD_HOST_64BIT_LONG
-	    if (start != (unsigned long) start)
-	      printf ("%lx%8.8lx ", (unsigned long) (start >> 32),
-		      (unsigned long) (start & 0xffffffff));
-	    else
+	if (start != (unsigned long) start)
+	  printf ("%lx%8.8lx ", (unsigned long) (start >> 32),
+		  (unsigned long) (start & 0xffffffff));
+	else
 #endif
-	      printf ("%7lx ", (unsigned long) start);
+	  printf ("%7lx ", (unsigned long) start);
+	break;
+      }
+
+  scan->buf[string_min] = '\0';
+  fputs (scan->buf, stdout);
+}
+
+/* Find the strings in the LENGTH bytes at DATA, which follow the data
+   SCAN has already seen.  Return the number of bytes used, which is
+   less than LENGTH if DATA ends with part of a character.  */
+
+static size_t
+scan_strings (struct string_scan *scan, const unsigned char *data,
+	      size_t length)
+{
+  const unsigned char *p = data;
+  const unsigned char *end = data + length - length % encoding_bytes;
+
+  while (p < end)
+    {
+      long c;
+
+      /* Single byte characters can be looked at a word at a time,
+	 while they are all graphic in a string that is being printed,
+	 or all not graphic between strings.  */
+      if (encoding_bytes == 1 && scan->stop_point == 0)
+	{
+	  const unsigned char *q = p;
+
+	  if (scan->printing)
+	    {
+	      while ((size_t) (end - q) >= sizeof (unsigned long)
+		     && graphic_bytes (q) == WORD_HIGHS)
+		q += sizeof (unsigned long);
+	      fwrite (p, 1, q - p, stdout);
+	    }
+	  else if (scan->run == 0)
+	    while ((size_t) (end - q) >= sizeof (unsigned long)
+		   && graphic_bytes (q) == 0)
+	      q += sizeof (unsigned long);
+
+	  scan->address += q - p;
+	  p = q;
+	  if (p == end)
 	    break;
-	  }
+	}
+
+      if (scan->run == 0
+	  && scan->stop_point
+	  && scan->address >= scan->stop_point)
+	{
+	  scan->stopped = TRUE;
+	  break;
+	}
+
+      c = get_char (p);
+      if (! STRING_ISGRAPHIC (c))
+	{
+	  /* End the string, if there is one, and look for another
+	     after this character.  */
+	  if (scan->printing)
+	    putchar ('\n');
+	  scan->printing = FALSE;
+	  scan->run = 0;
+	}
+      else if (scan->printing)
+	putchar (c);
+      else
+	{
+	  /* See if the next `string_min' chars are all graphic chars.  */
+	  if (scan->run == 0)
+	    scan->start = scan->address;
+	  scan->buf[scan->run++] = c;
+	  if (scan->run == string_min)
+	    {
+	      print_string_start (scan);
+	      scan->printing = TRUE;
+	    }
+	}
+
+      p += encoding_bytes;
+      scan->address += encoding_bytes;
+    }
+
+  return p - data;
+}
+
+/* Find the strings in file FILENAME, read from STREAM.
+   Assume that STREAM is positioned so that the next byte read
+   is at address ADDRESS in the file.
+   Stop reading at address STOP_POINT in the file, if nonzero.
+
+   If STREAM is NULL, do not read from it.
+   The caller can supply a buffer of characters
+   to be processed before the data in STREAM.
+   MAGIC is the address of the buffer and
+   MAGICCOUNT is how many characters are in it.
+   Those characters come at address ADDRESS and the data in STREAM follow.
+
+   STREAM is read in large blocks, and a string is printed once
+   `string_min' graphic characters in a row have been seen, up to the
+   next character that is not graphic.  */
+
+static void
+print_strings (const char *filename, FILE *stream, file_off address,
+	       int stop_point, int magiccount, char *magic)
+{
+  struct string_scan scan;
+  size_t used = 0;
+  size_t carry = 0;
+
+  scan.filename = filename;
+  scan.address = address;
+  scan.stop_point = stop_point;
+  scan.run = 0;
+  scan.buf = (char *) xmalloc (sizeof (char) * (string_min + 1));
+  scan.printing = FALSE;
+  scan.stopped = FALSE;
+
+  if (magiccount > 0)
+    {
+      used = scan_strings (&scan, (unsigned char *) magic, magiccount);
+      carry = magiccount - used;
+    }
 
-      buf[i] = '\0';
-      fputs (buf, stdout);
+  if (stream != NULL && !scan.stopped)
+    {
+      unsigned char *block;
 
+      /* Keep any part of a character left over from MAGIC at the
+	 start of the block, and likewise from one block to the next.  */
+      block = (unsigned char *) xmalloc (STRINGS_BLOCK_SIZE);
+      if (carry != 0)
+	memcpy (block, magic + used, carry);
       while (1)
 	{
-	  c = get_char (stream, &address, &magiccount, &magic);
-	  if (c == EOF)
+	  size_t got;
+
+	  got = fread (block + carry, 1, STRINGS_BLOCK_SIZE - carry, stream);
+	  if (got == 0)
 	    break;
-	  if (! STRING_ISGRAPHIC (c))
+	  carry += got;
+	  used = scan_strings (&scan, block, carry);
+	  if (scan.stopped)
 	    break;
-	  putchar (c);
+	  carry -= used;
+	  memmove (block, block + used, carry);
 	}
-
-      putchar ('\n');
+      free (block);
     }
+
+  /* A string that runs to the end of the data ends there.  */
+  if (scan.printing)
+    putchar ('\n');
+
+  free (scan.buf);
 }
-
+
 static void
 usage (FILE *stream, int status)
 {
@@ -0,0 +1,175 @@
+#!/bin/sh
+
+# strings_benchmark.sh -- time strings on synthesized input files
+
+# Copyright 2010 Free Software Foundation, Inc.
+
+# This file is part of GNU Binutils.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# This script generates input files, runs strings over each of them
+# with the options listed below, and prints the best wall time of
+# several runs in milliseconds.  If a second strings program is
+# given, such as one built from an older tree, it is timed too and
+# the script fails if the two print anything different.
+# This is not run by "make check"; use "make strings-benchmark".
+#
+# The workloads are:
+#   zeros        a file of zero bytes, with -a
+#   zeros-L      the same file, with -a -e L
+#   mixed        runs of random bytes, text and UTF-16 text, with -a
+#   mixed-S      the same file, with -a -e S
+#   mixed-l      the same file, with -a -e l
+#   lines        short lines of text, with -a
+#
+# The generator is deterministic, so files of the same size are the
+# same from one run to the next.
+
+usage()
+{
+    echo "usage: $0 [-m MEGABYTES] [-r RUNS] STRINGS [OLD-STRINGS]" 1>&2
+    exit 1
+}
+
+megabytes=16
+runs=3
+
+while getopts m:r: opt; do
+    case $opt in
+    m) megabytes=$OPTARG ;;
+    r) runs=$OPTARG ;;
+    *) usage ;;
+    esac
+done
+shift `expr $OPTIND - 1`
+if [ $# -lt 1 -o $# -gt 2 ]; then
+    usage
+fi
+STRINGS=$1
+OLD_STRINGS=$2
+
+# The generator writes bytes with printf "%c", which must not be
+# turned into multibyte characters.
+LC_ALL=C
+export LC_ALL
+
+dir=strings_benchmark.d
+rm -rf $dir
+mkdir $dir || exit 1
+
+size=`expr $megabytes \* 1048576`
+
+# Write SIZE bytes of the KIND of data to stdout.  awk cannot print a
+# zero byte portably, so 0x01 stands for it and tr puts it back.
+generate()
+{
+    awk -v kind=$1 -v size=$2 'BEGIN {
+	srand (1);
+	for (i = 1; i < 256; i++)
+	    chr[i] = sprintf ("%c", i);
+	letters = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 ";
+	n = 0;
+	while (n < size) {
+	    r = rand ();
+	    s = "";
+	    if (kind == "lines" || r < 0.3) {
+		# A line of text.
+		len = 4 + int (rand () * (kind == "lines" ? 40 : 80));
+		for (i = 0; i < len; i++)
+		    s = s substr (letters, 1 + int (rand () * 63), 1);
+		s = s "\n";
+	    } else if (r < 0.4) {
+		# UTF-16LE text.
+		len = 4 + int (rand () * 30);
+		for (i = 0; i < len; i++)
+		    s = s substr (letters, 1 + int (rand () * 63), 1) chr[1];
+	    } else if (r < 0.5) {
+		# A run of zeros, as found between sections.
+		len = 16 + int (rand () * 2000);
+		for (i = 0; i < len; i++)
+		    s = s chr[1];
+	    } else {
+		# Random bytes, with more small values as in code.
+		len = 1 + int (rand () * 64);
+		for (i = 0; i < len; i++) {
+		    c = int (rand () * 255) + 1;
+		    if (rand () < 0.5)
+			c = int (c / 16) + 1;
+		    s = s chr[c];
+		}
+	    }
+	    printf "%s", s;
+	    n += length (s);
+	}
+    }' | tr '\001' '\000'
+}
+
+dd if=/dev/zero of=$dir/zeros bs=1048576 count=$megabytes 2> /dev/null \
+    || exit 1
+generate mixed $size > $dir/mixed || exit 1
+generate lines $size > $dir/lines || exit 1
+
+# Print the best wall time in milliseconds of RUNS runs of PROGRAM
+# with ARGS, writing its output to OUT.
+best_time()
+{
+    out=$1
+    shift
+    best=
+    i=0
+    while [ $i -lt $runs ]; do
+	start=`date +%s%N`
+	"$@" > $out || exit 1
+	end=`date +%s%N`
+	t=`expr \( $end - $start \) / 1000000`
+	if [ -z "$best" ] || [ $t -lt $best ]; then
+	    best=$t
+	fi
+	i=`expr $i + 1`
+    done
+    echo $best
+}
+
+status=0
+
+run()
+{
+    name=$1
+    file=$2
+    shift 2
+    new=`best_time $dir/$name.new $STRINGS "$@" $dir/$file` || exit 1
+    if [ -z "$OLD_STRINGS" ]; then
+	echo "$name: ${new}ms"
+	return
+    fi
+    old=`best_time $dir/$name.old $OLD_STRINGS "$@" $dir/$file` || exit 1
+    if cmp -s $dir/$name.old $dir/$name.new; then
+	echo "$name: ${old}ms -> ${new}ms"
+    else
+	echo "$name: output differs"
+	status=1
+    fi
+}
+
+run zeros zeros -a
+run zeros-L zeros -a -e L
+run mixed mixed -a
+run mixed-S mixed -a -e S
+run mixed-l mixed -a -e l
+run lines lines -a
+
+exit $status
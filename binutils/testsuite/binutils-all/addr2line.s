@@ -0,0 +1,15 @@
+# Line numbers for addr2line.exp.  The .loc directives make gas write
+# a .debug_line section, so no compiler is needed.
+
+	.file	1 "a2l.c"
+	.text
+	.globl	a2l_func
+a2l_func:
+	.loc	1 10 0
+	.long	0
+	.loc	1 20 0
+	.long	0
+	.loc	1 30 0
+	.long	0
+	.loc	1 40 0
+	.long	0
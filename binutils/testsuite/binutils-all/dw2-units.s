@@ -0,0 +1,87 @@
+# Test displaying .debug_info units on several threads, and with
+# --dwarf-start.  There are four compilation units of the same size,
+# each with one child.  The compilation unit DIEs are at offsets 0xb,
+# 0x28, 0x45 and 0x62.
+
+	.section	.debug_info,"",%progbits
+	.4byte	cu1E - cu1S	;# Length of Compilation Unit Info
+cu1S:
+	.short	0x2	;# DWARF version number
+	.4byte	abbrev0	;# Offset Into Abbrev. Section
+	.byte	0x4	;# Pointer Size (in bytes)
+
+	.uleb128 0x1	;# DW_TAG_compile_unit
+	.ascii "unit1.c\0"	;# DW_AT_name
+
+	.uleb128 0x2	;# DW_TAG_base_type
+	.ascii "type1\0"	;# DW_AT_name
+	.byte	0x4	;# DW_AT_byte_size
+	.byte	0x0	;# end of children of DW_TAG_compile_unit
+cu1E:
+
+	.4byte	cu2E - cu2S	;# Length of Compilation Unit Info
+cu2S:
+	.short	0x2	;# DWARF version number
+	.4byte	abbrev0	;# Offset Into Abbrev. Section
+	.byte	0x4	;# Pointer Size (in bytes)
+
+	.uleb128 0x1	;# DW_TAG_compile_unit
+	.ascii "unit2.c\0"	;# DW_AT_name
+
+	.uleb128 0x2	;# DW_TAG_base_type
+	.ascii "type2\0"	;# DW_AT_name
+	.byte	0x4	;# DW_AT_byte_size
+	.byte	0x0	;# end of children of DW_TAG_compile_unit
+cu2E:
+
+	.4byte	cu3E - cu3S	;# Length of Compilation Unit Info
+cu3S:
+	.short	0x2	;# DWARF version number
+	.4byte	abbrev0	;# Offset Into Abbrev. Section
+	.byte	0x4	;# Pointer Size (in bytes)
+
+	.uleb128 0x1	;# DW_TAG_compile_unit
+	.ascii "unit3.c\0"	;# DW_AT_name
+
+	.uleb128 0x2	;# DW_TAG_base_type
+	.ascii "type3\0"	;# DW_AT_name
+	.byte	0x4	;# DW_AT_byte_size
+	.byte	0x0	;# end of children of DW_TAG_compile_unit
+cu3E:
+
+	.4byte	cu4E - cu4S	;# Length of Compilation Unit Info
+cu4S:
+	.short	0x2	;# DWARF version number
+	.4byte	abbrev0	;# Offset Into Abbrev. Section
+	.byte	0x4	;# Pointer Size (in bytes)
+
+	.uleb128 0x1	;# DW_TAG_compile_unit
+	.ascii "unit4.c\0"	;# DW_AT_name
+
+	.uleb128 0x2	;# DW_TAG_base_type
+	.ascii "type4\0"	;# DW_AT_name
+	.byte	0x4	;# DW_AT_byte_size
+	.byte	0x0	;# end of children of DW_TAG_compile_unit
+cu4E:
+
+	.section	.debug_abbrev,"",%progbits
+abbrev0:
+	.uleb128 0x1	;# (abbrev code)
+	.uleb128 0x11	;# (TAG: DW_TAG_compile_unit)
+	.byte	0x1	;# DW_children_yes
+	.uleb128 0x3	;# (DW_AT_name)
+	.uleb128 0x8	;# (DW_FORM_string)
+	.byte	0x0
+	.byte	0x0
+
+	.uleb128 0x2	;# (abbrev code)
+	.uleb128 0x24	;# (TAG: DW_TAG_base_type)
+	.byte	0x0	;# DW_children_no
+	.uleb128 0x3	;# (DW_AT_name)
+	.uleb128 0x8	;# (DW_FORM_string)
+	.uleb128 0xb	;# (DW_AT_byte_size)
+	.uleb128 0xb	;# (DW_FORM_data1)
+	.byte	0x0
+	.byte	0x0
+
+	.byte	0x0
@@ -0,0 +1,30 @@
+# Many small functions with relocations, making a .text section of
+# several of the chunks objdump --threads disassembles at once.
+
+	.macro	func
+	.globl	func\@
+	.type	func\@,@function
+func\@:
+	mflr	0
+	stw	0,4(1)
+	stwu	1,-16(1)
+	lis	3,data@ha
+	addi	3,3,data@l
+	lwz	4,0(3)
+	bl	ext
+	addi	4,4,\@
+	lwz	0,20(1)
+	addi	1,1,16
+	mtlr	0
+	blr
+	.size	func\@,.-func\@
+	.endm
+
+	.text
+	.rept	4000
+	func
+	.endr
+
+	.data
+data:
+	.long	1
@@ -139,6 +139,21 @@ class Archive
   static void
   print_stats();
 
+  // Return the number of archives seen.
+  static unsigned int
+  get_total_archives()
+  { return Archive::total_archives; }
+
+  // Return the number of archive members seen.
+  static unsigned int
+  get_total_members()
+  { return Archive::total_members; }
+
+  // Return the number of archive members loaded.
+  static unsigned int
+  get_total_members_loaded()
+  { return Archive::total_members_loaded; }
+
   // Return the number of members in the archive.
   size_t
   count_members();
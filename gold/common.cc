@@ -42,6 +42,8 @@ namespace gold
 Task_token*
 Allocate_commons_task::is_runnable()
 {
+  if (this->scan_blocker_ != NULL && this->scan_blocker_->is_blocked())
+    return this->scan_blocker_;
   if (!this->symtab_lock_->is_writable())
     return this->symtab_lock_;
   return NULL;
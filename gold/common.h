@@ -35,10 +35,14 @@ class Symbol_table;
 class Allocate_commons_task : public Task
 {
  public:
+  // If SCAN_BLOCKER is not NULL, we wait for it to be unblocked
+  // before running.
   Allocate_commons_task(Symbol_table* symtab, Layout* layout, Mapfile* mapfile,
-			Task_token* symtab_lock, Task_token* blocker)
+			Task_token* symtab_lock, Task_token* blocker,
+			Task_token* scan_blocker = NULL)
     : symtab_(symtab), layout_(layout), mapfile_(mapfile),
-      symtab_lock_(symtab_lock), blocker_(blocker)
+      symtab_lock_(symtab_lock), blocker_(blocker),
+      scan_blocker_(scan_blocker)
   { }
 
   // The standard Task methods.
@@ -62,6 +66,7 @@ class Allocate_commons_task : public Task
   Mapfile* mapfile_;
   Task_token* symtab_lock_;
   Task_token* blocker_;
+  Task_token* scan_blocker_;
 };
 
 } // End namespace gold.
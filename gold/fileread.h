@@ -200,6 +200,16 @@ class File_read
   static void
   print_stats();
 
+  // Return the total number of bytes mapped for reading.
+  static unsigned long long
+  get_total_mapped_bytes()
+  { return File_read::total_mapped_bytes; }
+
+  // Return the maximum number of bytes mapped at one time.
+  static unsigned long long
+  get_maximum_mapped_bytes()
+  { return File_read::maximum_mapped_bytes; }
+
   // Return the open file descriptor (for plugins).
   int
   descriptor()
@@ -44,6 +44,7 @@
 #include "gc.h"
 #include "icf.h"
 #include "incremental.h"
+#include "timer.h"
 
 namespace gold
 {
@@ -300,6 +301,10 @@ queue_middle_tasks(const General_options& options,
 		   Workqueue* workqueue,
 		   Mapfile* mapfile)
 {
+  Timer* timer = parameters->timer();
+  if (timer != NULL)
+    timer->stamp(Timer::INITIAL_PASS);
+
   // Add any symbols named with -u options to the symbol table.
   symtab->add_undefined_symbols_from_command_line();
 
@@ -475,6 +480,15 @@ queue_middle_tasks(const General_options& options,
   Task_token* blocker = new Task_token(true);
   Task_token* symtab_lock = new Task_token(false);
 
+  // If the target defers reloc scanning, the Scan_relocs tasks do not
+  // lock the symbol table and only record the relocs which need work.
+  // They unblock SCAN_BLOCKER, and a single Scan_deferred_relocs task
+  // then processes the recorded relocs.
+  Task_token* scan_blocker = blocker;
+  if (!parameters->options().relocatable()
+      && parameters->target().defer_reloc_scan())
+    scan_blocker = new Task_token(true);
+
   // If doing garbage collection, the relocations have already been read.
   // Otherwise, read and scan the relocations.
   if (parameters->options().gc_sections()
@@ -484,9 +498,10 @@ queue_middle_tasks(const General_options& options,
            p != input_objects->relobj_end();
            ++p)
         {
-          blocker->add_blocker();
+          scan_blocker->add_blocker();
           workqueue->queue(new Scan_relocs(options, symtab, layout, *p, 
-                           (*p)->get_relocs_data(),symtab_lock, blocker));
+                           (*p)->get_relocs_data(),symtab_lock,
+                           scan_blocker));
         }
     }
   else
@@ -511,19 +526,33 @@ queue_middle_tasks(const General_options& options,
           // So we queue up a task for each object to read the
           // relocations.  That task will in turn queue a task to wait
           // until it can write to the symbol table.
-          blocker->add_blocker();
+          scan_blocker->add_blocker();
           workqueue->queue(new Read_relocs(options, symtab, layout, *p,
-                   symtab_lock, blocker));
+                   symtab_lock, scan_blocker));
         }
     }
 
+  if (scan_blocker != blocker)
+    {
+      blocker->add_blocker();
+      workqueue->queue(new Scan_deferred_relocs(options, input_objects,
+						symtab, layout, scan_blocker,
+						symtab_lock, blocker));
+    }
+
   // Allocate common symbols.  This requires write access to the
   // symbol table, but is independent of the relocation processing.
+  // When the reloc scan is deferred, the symbols must not change
+  // while the objects are being scanned without the symbol table
+  // lock, so we wait for SCAN_BLOCKER.
   if (parameters->options().define_common())
     {
       blocker->add_blocker();
       workqueue->queue(new Allocate_commons_task(symtab, layout, mapfile,
-						 symtab_lock, blocker));
+						 symtab_lock, blocker,
+						 (scan_blocker != blocker
+						  ? scan_blocker
+						  : NULL)));
     }
 
   // When all those tasks are complete, we can start laying out the
@@ -551,6 +580,10 @@ queue_final_tasks(const General_options& options,
 		  Workqueue* workqueue,
 		  Output_file* of)
 {
+  Timer* timer = parameters->timer();
+  if (timer != NULL)
+    timer->stamp(Timer::MIDDLE_PASS);
+
   int thread_count = options.thread_count_final();
   if (thread_count == 0)
     thread_count = std::max(2, input_objects->number_of_input_objects());
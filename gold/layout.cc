@@ -598,6 +598,19 @@ Layout::layout(Sized_relobj<size, big_endian>* object, unsigned int shndx,
 	  || is_prefix_of(".fini_array.", name)))
     os->set_must_sort_attached_input_sections();
 
+  // With --section-ordering-file we keep track of every executable
+  // input section, so that the ones named in the file can be moved to
+  // the front of the output section in the given order.
+  if (parameters->options().section_ordering_file() != NULL
+      && !this->script_options_->saw_sections_clause()
+      && (shdr.get_sh_flags() & elfcpp::SHF_EXECINSTR) != 0)
+    {
+      os->set_input_section_order_specified();
+      unsigned int index = parameters->options().section_order_index(name);
+      if (index != 0)
+	os->set_input_section_order_index(object, shndx, index);
+    }
+
   // FIXME: Handle SHF_LINK_ORDER somewhere.
 
   *off = os->add_input_section(object, shndx, name, shdr, reloc_shndx,
@@ -2568,6 +2581,12 @@ Layout::create_symtab_sections(const Input_objects* input_objects,
   off += symsize;
   unsigned int local_symbol_index = 1;
 
+  // Collect the section symbol requests made while scanning relocs.
+  for (Input_objects::Relobj_iterator p = input_objects->relobj_begin();
+       p != input_objects->relobj_end();
+       ++p)
+    (*p)->update_output_section_symtab_indexes();
+
   // Add STT_SECTION symbols for each Output section which needs one.
   for (Section_list::iterator p = this->section_list_.begin();
        p != this->section_list_.end();
@@ -3736,6 +3755,17 @@ Layout::print_stats() const
     (*p)->print_merge_stats();
 }
 
+// Collect the merged string counts from all output sections.
+
+void
+Layout::merge_string_stats(size_t* input_count, size_t* output_count) const
+{
+  for (Section_list::const_iterator p = this->section_list_.begin();
+       p != this->section_list_.end();
+       ++p)
+    (*p)->merge_string_stats(input_count, output_count);
+}
+
 // Write_sections_task methods.
 
 // We can always run this task.
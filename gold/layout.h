@@ -557,6 +557,12 @@ class Layout
   void
   print_stats() const;
 
+  // Add the number of input strings and of distinct output strings in
+  // merged string sections to *INPUT_COUNT and *OUTPUT_COUNT.  This
+  // is used for --stats.
+  void
+  merge_string_stats(size_t* input_count, size_t* output_count) const;
+
   // A list of segments.
 
   typedef std::vector<Output_segment*> Segment_list;
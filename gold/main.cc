@@ -46,6 +46,7 @@
 #include "gc.h"
 #include "icf.h"
 #include "incremental.h"
+#include "timer.h"
 
 using namespace gold;
 
@@ -130,6 +131,111 @@ write_debug_script(std::string, const char*, const char*)
 
 #endif // !defined(DEBUG)
 
+// Print a time measurement for --stats.
+
+static void
+print_pass_time(const char* name, const Timer::TimeStats& t)
+{
+  fprintf(stderr,
+	  _("%s: %s run time: (user: %ld.%06ld sys: %ld.%06ld "
+	    "wall: %ld.%06ld)\n"),
+	  program_name, name,
+	  t.user / 1000000, t.user % 1000000,
+	  t.sys / 1000000, t.sys % 1000000,
+	  t.wall / 1000000, t.wall % 1000000);
+}
+
+// Print a time measurement as a JSON object.
+
+static void
+print_json_time(const Timer::TimeStats& t)
+{
+  fprintf(stderr, "{\"user\": %ld.%06ld, \"sys\": %ld.%06ld, "
+	  "\"wall\": %ld.%06ld}",
+	  t.user / 1000000, t.user % 1000000,
+	  t.sys / 1000000, t.sys % 1000000,
+	  t.wall / 1000000, t.wall % 1000000);
+}
+
+// Print S as a JSON string, escaping the characters JSON does not
+// allow to appear literally.
+
+static void
+print_json_string(const char* s)
+{
+  putc('"', stderr);
+  for (; *s != '\0'; ++s)
+    {
+      unsigned char c = *s;
+      if (c == '"' || c == '\\')
+	fprintf(stderr, "\\%c", c);
+      else if (c < 0x20)
+	fprintf(stderr, "\\u%04x", c);
+      else
+	putc(c, stderr);
+    }
+  putc('"', stderr);
+}
+
+// Print the statistics for --stats=json to stderr, as a single JSON
+// object on one line, so that the output of many links can be
+// collected and compared by scripts.
+
+static void
+print_stats_json(const Timer& timer, const Input_objects& input_objects,
+		 const Symbol_table& symtab, const Layout& layout)
+{
+  fprintf(stderr, "{\"program\": ");
+  print_json_string(program_name);
+  fprintf(stderr, ", \"phases\": {");
+  for (int i = 0; i < Timer::NUM_PASSES; ++i)
+    {
+      Timer::Pass pass = static_cast<Timer::Pass>(i);
+      if (i != 0)
+	fprintf(stderr, ", ");
+      print_json_string(Timer::pass_name(pass));
+      fprintf(stderr, ": ");
+      print_json_time(timer.get_pass_time(pass));
+    }
+  fprintf(stderr, "}, \"total\": ");
+  print_json_time(timer.get_elapsed_time());
+
+  fprintf(stderr, ", \"peak_rss\": %llu", Timer::get_peak_rss());
+#ifdef HAVE_MALLINFO
+  struct mallinfo m = mallinfo();
+  fprintf(stderr, ", \"malloc_arena\": %d", m.arena);
+#endif
+  fprintf(stderr, ", \"bytes_mapped\": %llu, \"max_bytes_mapped\": %llu",
+	  File_read::get_total_mapped_bytes(),
+	  File_read::get_maximum_mapped_bytes());
+  fprintf(stderr, ", \"archives\": %u, \"archive_members\": %u, "
+	  "\"archive_members_loaded\": %u",
+	  Archive::get_total_archives(), Archive::get_total_members(),
+	  Archive::get_total_members_loaded());
+  fprintf(stderr, ", \"input_objects\": %d",
+	  input_objects.number_of_input_objects());
+
+  size_t reloc_count = 0;
+  for (Input_objects::Relobj_iterator p = input_objects.relobj_begin();
+       p != input_objects.relobj_end();
+       ++p)
+    reloc_count += (*p)->reloc_count();
+  fprintf(stderr, ", \"symbols\": %zu, \"relocations\": %zu",
+	  symtab.symbol_count(), reloc_count);
+  fprintf(stderr, ", \"symbol_bytes\": %zu, \"symbol_extras\": %zu",
+	  symtab.symbol_bytes(), Symbol::get_extra_count());
+
+  size_t merge_input_count = 0;
+  size_t merge_output_count = 0;
+  layout.merge_string_stats(&merge_input_count, &merge_output_count);
+  fprintf(stderr, ", \"merged_strings\": {\"input\": %zu, "
+	  "\"output\": %zu}",
+	  merge_input_count, merge_output_count);
+
+  fprintf(stderr, ", \"output_file_size\": %lld}\n",
+	  static_cast<long long>(layout.output_file_size()));
+}
+
 
 int
 main(int argc, char** argv)
@@ -161,9 +267,13 @@ main(int argc, char** argv)
   Command_line command_line;
   command_line.process(argc - 1, const_cast<const char**>(argv + 1));
 
-  long start_time = 0;
-  if (command_line.options().stats())
-    start_time = get_run_time();
+  // The timer used for --stats.
+  Timer timer;
+  if (command_line.options().user_set_stats())
+    {
+      timer.start();
+      set_parameters_timer(&timer);
+    }
 
   // Store some options in the globally accessible parameters.
   set_parameters_options(&command_line.options());
@@ -245,11 +355,26 @@ main(int argc, char** argv)
   // Run the main task processing loop.
   workqueue.process(0);
 
-  if (command_line.options().stats())
+  if (command_line.options().user_set_stats())
+    timer.stamp(Timer::FINAL_PASS);
+
+  if (command_line.options().user_set_stats()
+      && strcmp(command_line.options().stats(), "json") == 0)
+    print_stats_json(timer, input_objects, symtab, layout);
+  else if (command_line.options().user_set_stats())
     {
-      long run_time = get_run_time() - start_time;
+      print_pass_time(_("initial tasks"),
+		      timer.get_pass_time(Timer::INITIAL_PASS));
+      print_pass_time(_("middle tasks"),
+		      timer.get_pass_time(Timer::MIDDLE_PASS));
+      print_pass_time(_("final tasks"),
+		      timer.get_pass_time(Timer::FINAL_PASS));
+      Timer::TimeStats total = timer.get_elapsed_time();
+      long run_time = total.user + total.sys;
       fprintf(stderr, _("%s: total run time: %ld.%06ld seconds\n"),
 	      program_name, run_time / 1000000, run_time % 1000000);
+      fprintf(stderr, _("%s: peak resident set size: %llu bytes\n"),
+	      program_name, Timer::get_peak_rss());
 #ifdef HAVE_MALLINFO
       struct mallinfo m = mallinfo();
       fprintf(stderr, _("%s: total space allocated by malloc: %d bytes\n"),
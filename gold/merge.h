@@ -425,6 +425,14 @@ class Output_merge_string : public Output_merge_base
   void
   do_print_merge_stats(const char* section_name);
 
+  // Collect merged string statistics.
+  void
+  do_merge_string_stats(size_t* input_count, size_t* output_count) const
+  {
+    *input_count += this->input_count_;
+    *output_count += this->stringpool_.string_count();
+  }
+
   // Writes the stringpool to a buffer.
   void
   stringpool_to_buffer(unsigned char* buffer, section_size_type buffer_size)
@@ -323,6 +323,50 @@ Relobj::is_section_name_included(const char* name)
   return false;
 }
 
+// Pass on the symbol table index requests recorded while scanning
+// relocs for a relocatable link.
+
+void
+Relobj::update_output_section_symtab_indexes()
+{
+  const unsigned int count = this->output_sections_needing_symtab_index_.size();
+  for (unsigned int shndx = 0; shndx < count; ++shndx)
+    {
+      if (!this->output_sections_needing_symtab_index_[shndx])
+	continue;
+      Output_section* os = this->output_section(shndx);
+      gold_assert(os != NULL);
+      os->set_needs_symtab_index();
+    }
+  this->output_sections_needing_symtab_index_.clear();
+}
+
+// Return the structure used to record deferred relocs.  This is only
+// called while scanning the relocs of this object, when the object is
+// locked, so there is no race in creating it.
+
+Deferred_relocs*
+Relobj::deferred_relocs()
+{
+  if (this->deferred_relocs_ == NULL)
+    this->deferred_relocs_ = new Deferred_relocs();
+  return this->deferred_relocs_;
+}
+
+// Scan the deferred relocs for this object, if there are any.
+
+void
+Relobj::scan_deferred_relocs(const General_options& options,
+			     Symbol_table* symtab, Layout* layout)
+{
+  if (this->deferred_relocs_ == NULL)
+    return;
+  this->do_scan_deferred_relocs(options, symtab, layout,
+				this->deferred_relocs_);
+  delete this->deferred_relocs_;
+  this->deferred_relocs_ = NULL;
+}
+
 // Class Sized_relobj.
 
 template<int size, bool big_endian>
@@ -46,6 +46,7 @@ class Pluginobj;
 class Dynobj;
 class Object_merge_map;
 class Relocatable_relocs;
+class Deferred_relocs;
 class Symbols_data;
 
 template<typename Stringpool_char>
@@ -631,6 +632,9 @@ class Relobj : public Object
       map_to_relocatable_relocs_(NULL),
       object_merge_map_(NULL),
       relocs_must_follow_section_writes_(false),
+      reloc_count_(0),
+      output_sections_needing_symtab_index_(),
+      deferred_relocs_(NULL),
       sd_(NULL)
   { }
 
@@ -686,6 +690,17 @@ class Relobj : public Object
 	      Layout* layout, Read_relocs_data* rd)
   { return this->do_scan_relocs(options, symtab, layout, rd); }
 
+  // Return the structure used to record relocs for a later scan when
+  // the target defers reloc scanning, creating it if necessary.
+  Deferred_relocs*
+  deferred_relocs();
+
+  // Pass the relocs recorded by the target while scanning relocs back
+  // to the target, and then free them.
+  void
+  scan_deferred_relocs(const General_options& options, Symbol_table* symtab,
+		       Layout* layout);
+
   // The number of local symbols in the input symbol table.
   virtual unsigned int
   local_symbol_count() const
@@ -760,6 +775,12 @@ class Relobj : public Object
   relocs_must_follow_section_writes() const
   { return this->relocs_must_follow_section_writes_; }
 
+  // Return the number of relocations read from this object.  This is
+  // used for --stats.
+  size_t
+  reloc_count() const
+  { return this->reloc_count_; }
+
   // Return the object merge map.
   Object_merge_map*
   merge_map() const
@@ -789,6 +810,27 @@ class Relobj : public Object
     return (*this->map_to_relocatable_relocs_)[reloc_shndx];
   }
 
+  // Record that the output section for input section SHNDX needs a
+  // section symbol in the output symbol table.  When generating a
+  // relocatable object the relocs of different objects are scanned
+  // in parallel, so we only note the request here and pass it on to
+  // the shared Output_section later in
+  // update_output_section_symtab_indexes.
+  void
+  set_output_section_needs_symtab_index(unsigned int shndx)
+  {
+    gold_assert(shndx < this->shnum());
+    if (this->output_sections_needing_symtab_index_.empty())
+      this->output_sections_needing_symtab_index_.resize(this->shnum());
+    this->output_sections_needing_symtab_index_[shndx] = true;
+  }
+
+  // Mark the output sections recorded by
+  // set_output_section_needs_symtab_index.  This must be called after
+  // all relocs have been scanned, from a single thread.
+  void
+  update_output_section_symtab_indexes();
+
   // Layout sections whose layout was deferred while waiting for
   // input files from a plugin.
   void
@@ -815,6 +857,11 @@ class Relobj : public Object
   do_scan_relocs(const General_options&, Symbol_table*, Layout*,
 		 Read_relocs_data*) = 0;
 
+  // Scan the deferred relocs--implemented by child class.
+  virtual void
+  do_scan_deferred_relocs(const General_options&, Symbol_table*, Layout*,
+			  const Deferred_relocs*) = 0;
+
   // Return the number of local symbols--implemented by child class.
   virtual unsigned int
   do_local_symbol_count() const = 0;
@@ -880,6 +927,11 @@ class Relobj : public Object
   set_relocs_must_follow_section_writes()
   { this->relocs_must_follow_section_writes_ = true; }
 
+  // Add to the number of relocations read from this object.
+  void
+  add_reloc_count(size_t count)
+  { this->reloc_count_ += count; }
+
  private:
   // Mapping from input sections to output section.
   Output_sections output_sections_;
@@ -892,6 +944,14 @@ class Relobj : public Object
   // Whether we need to wait for output sections to be written before
   // we can apply relocations.
   bool relocs_must_follow_section_writes_;
+  // The number of relocations read from this object.
+  size_t reloc_count_;
+  // Input sections whose output section needs a symbol table index,
+  // recorded while scanning relocs for a relocatable link.
+  std::vector<bool> output_sections_needing_symtab_index_;
+  // Relocs recorded for a later scan when the target defers reloc
+  // scanning.
+  Deferred_relocs* deferred_relocs_;
   // Used to store the relocs data computed by the Read_relocs pass. 
   // Used during garbage collection of unused sections.
   Read_relocs_data* rd_;
@@ -1527,6 +1587,11 @@ class Sized_relobj : public Relobj
   do_scan_relocs(const General_options&, Symbol_table*, Layout*,
 		 Read_relocs_data*);
 
+  // Scan the relocs recorded for a later scan.
+  void
+  do_scan_deferred_relocs(const General_options&, Symbol_table*, Layout*,
+			  const Deferred_relocs*);
+
   // Count the local symbols.
   void
   do_count_local_symbols(Stringpool_template<char>*,
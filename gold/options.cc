@@ -189,7 +189,7 @@ parse_uint(const char* option_name, const char* arg, int* retval)
 {
   char* endptr;
   *retval = strtol(arg, &endptr, 0);
-  if (*endptr != '\0' || retval < 0)
+  if (*endptr != '\0' || *retval < 0)
     gold_fatal(_("%s: invalid option value (expected an integer): %s"),
                option_name, arg);
 }
@@ -991,6 +991,32 @@ General_options::finalize()
         }
     }
 
+  // Parse the contents of --section-ordering-file into a map from
+  // section name to its position in the file.  Blank lines and lines
+  // starting with '#' are ignored, as are leading and trailing
+  // blanks.  If a section is listed more than once the first entry
+  // wins.
+  if (this->section_ordering_file())
+    {
+      std::ifstream in;
+      in.open(this->section_ordering_file());
+      if (!in)
+        gold_fatal(_("unable to open --section-ordering-file file %s: %s"),
+                   this->section_ordering_file(), strerror(errno));
+      unsigned int position = 1;
+      std::string line;
+      while (std::getline(in, line))
+        {
+          size_t start = line.find_first_not_of(" \t\r");
+          if (start == std::string::npos || line[start] == '#')
+            continue;
+          size_t end = line.find_last_not_of(" \t\r");
+          std::string name(line, start, end - start + 1);
+          if (this->section_order_.insert(std::make_pair(name, position)).second)
+            ++position;
+        }
+    }
+
   if (this->shared() && !this->user_set_allow_shlib_undefined())
     this->set_allow_shlib_undefined(true);
 
@@ -998,6 +1024,11 @@ General_options::finalize()
   // in the path, as appropriate.
   this->add_sysroot();
 
+  if (this->user_set_stats()
+      && strcmp(this->stats(), "text") != 0
+      && strcmp(this->stats(), "json") != 0)
+    gold_fatal(_("unrecognized --stats format: %s"), this->stats());
+
   // Now that we've normalized the options, check for contradictory ones.
   if (this->shared() && this->is_static())
     gold_fatal(_("-shared and -static are incompatible"));
@@ -819,6 +819,10 @@ class General_options
                  N_("Add DIR to link time shared library search path"),
                  N_("DIR"));
 
+  DEFINE_string(section_ordering_file, options::TWO_DASHES, '\0', NULL,
+		N_("Layout sections in the order specified"),
+		N_("FILENAME"));
+
   DEFINE_bool(strip_all, options::TWO_DASHES, 's', false,
               N_("Strip all symbols"), NULL);
   DEFINE_bool(strip_debug, options::TWO_DASHES, 'S', false,
@@ -880,8 +884,10 @@ class General_options
               N_("List removed unused sections on stderr"),
               N_("Do not list removed unused sections"));
 
-  DEFINE_bool(stats, options::TWO_DASHES, '\0', false,
-              N_("Print resource usage statistics"), NULL);
+  DEFINE_optional_string(stats, options::TWO_DASHES, '\0', "text",
+			 N_("Print resource usage statistics; FORMAT is "
+			    "text (default) or json"),
+			 N_("[=FORMAT]"));
 
   DEFINE_string(sysroot, options::TWO_DASHES, '\0', "",
                 N_("Set target system root directory"), N_("DIR"));
@@ -1075,6 +1081,19 @@ class General_options
       return symbols_to_retain_.find(symbol_name) != symbols_to_retain_.end();
     }
 
+  // Return the position of the section SECTION_NAME in the
+  // --section-ordering-file, counting from 1, or 0 if it is not
+  // listed there.
+  unsigned int
+  section_order_index(const char* section_name) const
+  {
+    if (this->section_order_.empty())
+      return 0;
+    Section_order_map::const_iterator p =
+      this->section_order_.find(section_name);
+    return p == this->section_order_.end() ? 0 : p->second;
+  }
+
   // These are the best way to get access to the execstack state,
   // not execstack() and noexecstack() which are hard to use properly.
   bool
@@ -1214,6 +1233,9 @@ class General_options
   Unordered_set<std::string> excluded_libs_;
   // List of symbol-names to keep, via -retain-symbol-info.
   Unordered_set<std::string> symbols_to_retain_;
+  // Map from section name to position, via --section-ordering-file.
+  typedef Unordered_map<std::string, unsigned int> Section_order_map;
+  Section_order_map section_order_;
 };
 
 // The position-dependent options.  We use this to store the state of
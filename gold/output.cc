@@ -1796,6 +1796,7 @@ Output_section::Output_section(const char* name, elfcpp::Elf_Word type,
     may_sort_attached_input_sections_(false),
     must_sort_attached_input_sections_(false),
     attached_input_sections_are_sorted_(false),
+    input_section_order_specified_(false),
     is_relro_(false),
     is_relro_local_(false),
     is_small_section_(false),
@@ -1808,7 +1809,8 @@ Output_section::Output_section(const char* name, elfcpp::Elf_Word type,
     merge_section_map_(),
     merge_section_by_properties_map_(),
     relaxed_input_section_map_(),
-    is_relaxed_input_section_map_valid_(true)
+    is_relaxed_input_section_map_valid_(true),
+    input_section_order_()
 {
   // An unallocated section has no address.  Forcing this means that
   // we don't need special treatment for symbols defined in debug
@@ -1943,6 +1945,7 @@ Output_section::add_input_section(Sized_relobj<size, big_endian>* object,
       || !this->input_sections_.empty()
       || this->may_sort_attached_input_sections()
       || this->must_sort_attached_input_sections()
+      || this->input_section_order_specified()
       || parameters->options().user_set_Map()
       || parameters->target().may_relax())
     this->input_sections_.push_back(Input_section(object, shndx,
@@ -2428,6 +2431,8 @@ Output_section::set_final_data_size()
 
   if (this->must_sort_attached_input_sections())
     this->sort_attached_input_sections();
+  else if (this->input_section_order_specified())
+    this->sort_input_sections_by_order();
 
   uint64_t address = this->address();
   off_t startoff = this->offset();
@@ -2698,6 +2703,63 @@ Output_section::sort_attached_input_sections()
   this->attached_input_sections_are_sorted_ = true;
 }
 
+// Sort the input sections attached to an output section according to
+// the --section-ordering-file.  The sections named in the file form
+// the hot region at the start of the output section, in the order in
+// which they are listed.  All other sections form the cold region
+// after them, in input order.  The positions were recorded in
+// Layout::layout, so this needs only a hash lookup per section.
+
+void
+Output_section::sort_input_sections_by_order()
+{
+  if (this->attached_input_sections_are_sorted_)
+    return;
+
+  if (this->checkpoint_ != NULL
+      && !this->checkpoint_->input_sections_saved())
+    this->checkpoint_->save_input_sections();
+
+  // Each entry holds the sort key and the index in input_sections_.
+  // Unlisted sections get a key which sorts after every listed one.
+  typedef std::pair<unsigned int, unsigned int> Sort_key;
+  std::vector<Sort_key> sort_list;
+  sort_list.reserve(this->input_sections_.size());
+
+  unsigned int i = 0;
+  for (Input_section_list::const_iterator p = this->input_sections_.begin();
+       p != this->input_sections_.end();
+       ++p, ++i)
+    {
+      unsigned int key = -1U;
+      if (p->is_input_section() || p->is_relaxed_input_section())
+	{
+	  const Relobj* obj = (p->is_input_section()
+			       ? p->relobj()
+			       : p->relaxed_input_section()->relobj());
+	  Input_section_specifier iss(obj, p->shndx());
+	  Input_section_order_map::const_iterator q =
+	    this->input_section_order_.find(iss);
+	  if (q != this->input_section_order_.end())
+	    key = q->second;
+	}
+      sort_list.push_back(Sort_key(key, i));
+    }
+
+  // The index makes the sort stable.
+  std::sort(sort_list.begin(), sort_list.end());
+
+  Input_section_list sorted;
+  sorted.reserve(this->input_sections_.size());
+  for (std::vector<Sort_key>::const_iterator p = sort_list.begin();
+       p != sort_list.end();
+       ++p)
+    sorted.push_back(this->input_sections_[p->second]);
+  this->input_sections_.swap(sorted);
+
+  this->attached_input_sections_are_sorted_ = true;
+}
+
 // Write the section header to *OSHDR.
 
 template<int size, bool big_endian>
@@ -3023,6 +3085,18 @@ Output_section::print_merge_stats()
     p->print_merge_stats(this->name_);
 }
 
+// Collect the merged string counts for this section.
+
+void
+Output_section::merge_string_stats(size_t* input_count,
+				   size_t* output_count) const
+{
+  for (Input_section_list::const_iterator p = this->input_sections_.begin();
+       p != this->input_sections_.end();
+       ++p)
+    p->merge_string_stats(input_count, output_count);
+}
+
 // Output segment methods.
 
 Output_segment::Output_segment(elfcpp::Elf_Word type, elfcpp::Elf_Word flags)
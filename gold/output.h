@@ -707,6 +707,13 @@ class Output_section_data : public Output_data
   print_merge_stats(const char* section_name)
   { this->do_print_merge_stats(section_name); }
 
+  // Add the number of input strings and of distinct output strings to
+  // *INPUT_COUNT and *OUTPUT_COUNT.  This does nothing except for
+  // merged string sections.
+  void
+  merge_string_stats(size_t* input_count, size_t* output_count) const
+  { this->do_merge_string_stats(input_count, output_count); }
+
  protected:
   // The child class must implement do_write.
 
@@ -745,6 +752,11 @@ class Output_section_data : public Output_data
   do_print_merge_stats(const char*)
   { gold_unreachable(); }
 
+  // Collect merged string statistics.
+  virtual void
+  do_merge_string_stats(size_t*, size_t*) const
+  { }
+
   // Return the required alignment.
   uint64_t
   do_addralign() const
@@ -2332,6 +2344,30 @@ class Output_section : public Output_data
   set_must_sort_attached_input_sections()
   { this->must_sort_attached_input_sections_ = true; }
 
+  // Return whether the input sections attached to this output section
+  // are ordered by --section-ordering-file.
+  bool
+  input_section_order_specified() const
+  { return this->input_section_order_specified_; }
+
+  // Record that the input sections attached to this output section
+  // are ordered by --section-ordering-file.  This must be called
+  // before any input sections are attached.
+  void
+  set_input_section_order_specified()
+  { this->input_section_order_specified_ = true; }
+
+  // Record that input section SHNDX in OBJECT appears at position
+  // INDEX, counting from 1, in the --section-ordering-file.
+  void
+  set_input_section_order_index(const Relobj* object, unsigned int shndx,
+				unsigned int index)
+  {
+    gold_assert(index != 0);
+    Input_section_specifier iss(object, shndx);
+    this->input_section_order_[iss] = index;
+  }
+
   // Return whether this section holds relro data--data which has
   // dynamic relocations but which may be marked read-only after the
   // dynamic relocations have been completed.
@@ -2610,6 +2646,10 @@ class Output_section : public Output_data
   void
   print_merge_stats();
 
+  // Collect merged string statistics.
+  void
+  merge_string_stats(size_t* input_count, size_t* output_count) const;
+
  protected:
   // Return the output section--i.e., the object itself.
   Output_section*
@@ -2946,6 +2986,14 @@ class Output_section : public Output_data
 	this->u2_.posd->print_merge_stats(section_name);
     }
 
+    // Collect statistics about merged string sections.
+    void
+    merge_string_stats(size_t* input_count, size_t* output_count) const
+    {
+      if (this->shndx_ == MERGE_STRING_SECTION_CODE)
+	this->u2_.posd->merge_string_stats(input_count, output_count);
+    }
+
    private:
     // Code values which appear in shndx_.  If the value is not one of
     // these codes, it is the input section index in the object file.
@@ -3202,6 +3250,13 @@ class Output_section : public Output_data
 			Input_section_specifier::equal_to>
     Relaxation_map;
 
+  // Map from an input section to its position in the
+  // --section-ordering-file.
+  typedef Unordered_map<Input_section_specifier, unsigned int,
+			Input_section_specifier::hash,
+			Input_section_specifier::equal_to>
+    Input_section_order_map;
+
   // Add a new output section by Input_section.
   void
   add_output_section_data(Input_section*);
@@ -3224,6 +3279,10 @@ class Output_section : public Output_data
   void
   sort_attached_input_sections();
 
+  // Sort the attached input sections by --section-ordering-file.
+  void
+  sort_input_sections_by_order();
+
   // Find the merge section into which an input section with index SHNDX in
   // OBJECT has been added.  Return NULL if none found.
   Output_section_data*
@@ -3340,6 +3399,9 @@ class Output_section : public Output_data
   // True if the input sections attached to this output section have
   // already been sorted.
   bool attached_input_sections_are_sorted_ : 1;
+  // True if the input sections attached to this output section are
+  // ordered by --section-ordering-file.
+  bool input_section_order_specified_ : 1;
   // True if this section holds relro data.
   bool is_relro_ : 1;
   // True if this section holds relro local data.
@@ -3370,6 +3432,9 @@ class Output_section : public Output_data
   mutable Output_section_data_by_input_section_map relaxed_input_section_map_;
   // Whether relaxed_input_section_map_ is valid.
   mutable bool is_relaxed_input_section_map_valid_;
+  // Positions of the input sections named in the
+  // --section-ordering-file.
+  Input_section_order_map input_section_order_;
 };
 
 // An output segment.  PT_LOAD segments are built from collections of
@@ -37,6 +37,13 @@ Parameters::set_errors(Errors* errors)
   this->errors_ = errors;
 }
 
+void
+Parameters::set_timer(Timer* timer)
+{
+  gold_assert(this->timer_ == NULL);
+  this->timer_ = timer;
+}
+
 void
 Parameters::set_options(const General_options* options)
 {
@@ -135,6 +142,10 @@ void
 set_parameters_errors(Errors* errors)
 { static_parameters.set_errors(errors); }
 
+void
+set_parameters_timer(Timer* timer)
+{ static_parameters.set_timer(timer); }
+
 void
 set_parameters_options(const General_options* options)
 { static_parameters.set_options(options); }
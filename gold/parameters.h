@@ -29,6 +29,7 @@ namespace gold
 class General_options;
 class Errors;
 class Target;
+class Timer;
 template<int size, bool big_endian>
 class Sized_target;
 
@@ -45,12 +46,13 @@ class Sized_target;
 //    4) Whether we're doing a static link or not.  This is set
 //       after all inputs have been read and we know if any is a
 //       dynamic library.
+//    5) A Timer, if we are collecting --stats.
 
 class Parameters
 {
  public:
   Parameters()
-    : errors_(NULL), options_(NULL), target_(NULL),
+    : errors_(NULL), timer_(NULL), options_(NULL), target_(NULL),
       doing_static_link_valid_(false), doing_static_link_(false),
       debug_(0)
   { }
@@ -59,6 +61,9 @@ class Parameters
   void
   set_errors(Errors* errors);
 
+  void
+  set_timer(Timer* timer);
+
   void
   set_options(const General_options* options);
 
@@ -73,6 +78,11 @@ class Parameters
   errors() const
   { return this->errors_; }
 
+  // Return the timer object.  This is NULL unless --stats was used.
+  Timer*
+  timer() const
+  { return this->timer_; }
+
   // Whether the options are valid.  This should not normally be
   // called, but it is needed by gold_exit.
   bool
@@ -151,6 +161,7 @@ class Parameters
 
  private:
   Errors* errors_;
+  Timer* timer_;
   const General_options* options_;
   Target* target_;
   bool doing_static_link_valid_;
@@ -167,6 +178,9 @@ extern const Parameters* parameters;
 extern void
 set_parameters_errors(Errors* errors);
 
+extern void
+set_parameters_timer(Timer* timer);
+
 extern void
 set_parameters_options(const General_options* options);
 
@@ -143,7 +143,8 @@ Gc_process_relocs::get_name() const
 Task_token*
 Scan_relocs::is_runnable()
 {
-  if (!this->symtab_lock_->is_writable())
+  if (this->needs_symtab_lock()
+      && !this->symtab_lock_->is_writable())
     return this->symtab_lock_;
   if (this->object_->is_locked())
     return this->object_->token();
@@ -157,10 +158,27 @@ void
 Scan_relocs::locks(Task_locker* tl)
 {
   tl->add(this, this->object_->token());
-  tl->add(this, this->symtab_lock_);
+  if (this->needs_symtab_lock())
+    tl->add(this, this->symtab_lock_);
   tl->add(this, this->blocker_);
 }
 
+// Return whether we need to lock the symbol table while scanning.
+// When generating a relocatable object, scanning only records a
+// strategy for each input reloc in the object's own
+// Relocatable_relocs structures; it never creates GOT or PLT entries
+// or otherwise touches the symbol table.  Any output section which
+// needs a section symbol is recorded in the object and applied later
+// by Layout::create_symtab_sections.  So in that case the objects
+// may be scanned in parallel.
+
+bool
+Scan_relocs::needs_symtab_lock() const
+{
+  return (!parameters->options().relocatable()
+	  && !parameters->target().defer_reloc_scan());
+}
+
 // Scan the relocs.
 
 void
@@ -181,6 +199,88 @@ Scan_relocs::get_name() const
   return "Scan_relocs " + this->object_->name();
 }
 
+// Scan_deferred_relocs methods.
+
+// We must wait until all the objects have been scanned, and we need
+// to lock the symbol table.
+
+Task_token*
+Scan_deferred_relocs::is_runnable()
+{
+  if (this->scan_blocker_->is_blocked())
+    return this->scan_blocker_;
+  if (!this->symtab_lock_->is_writable())
+    return this->symtab_lock_;
+  return NULL;
+}
+
+// Return the locks we hold: one on the symbol table and one blocker.
+
+void
+Scan_deferred_relocs::locks(Task_locker* tl)
+{
+  tl->add(this, this->symtab_lock_);
+  tl->add(this, this->blocker_);
+}
+
+// Pass the recorded relocs to the target.  We walk the objects in
+// input order, which is also the order in which they are scanned when
+// not using threads.
+
+void
+Scan_deferred_relocs::run(Workqueue*)
+{
+  for (Input_objects::Relobj_iterator p = this->input_objects_->relobj_begin();
+       p != this->input_objects_->relobj_end();
+       ++p)
+    (*p)->scan_deferred_relocs(this->options_, this->symtab_, this->layout_);
+}
+
+// Class Deferred_relocs.
+
+// Start recording the relocs for a new input reloc section.  If the
+// previous section did not record anything, we reuse it.
+
+void
+Deferred_relocs::start_section(unsigned int data_shndx, unsigned int sh_type,
+			       Output_section* output_section)
+{
+  if (!this->sections_.empty() && this->sections_.back().symbols.empty())
+    this->sections_.pop_back();
+  this->sections_.push_back(Deferred_reloc_section(data_shndx, sh_type,
+						   output_section));
+}
+
+// Record a reloc.
+
+void
+Deferred_relocs::add(Scan_kind kind, const unsigned char* preloc,
+		     int reloc_size, unsigned int r_type, Symbol* gsym,
+		     unsigned int r_sym, const unsigned char* plsym,
+		     int sym_size)
+{
+  if (kind == SCAN_NONE)
+    return;
+
+  if (kind == SCAN_ONCE)
+    {
+      uint64_t key = r_type;
+      if (gsym == NULL)
+	key |= static_cast<uint64_t>(r_sym) << 32;
+      if (!this->once_.insert(std::make_pair(gsym, key)).second)
+	return;
+    }
+
+  gold_assert(!this->sections_.empty());
+  Deferred_reloc_section& section(this->sections_.back());
+  section.relocs.insert(section.relocs.end(), preloc, preloc + reloc_size);
+  section.symbols.push_back(gsym);
+  if (gsym == NULL)
+    section.local_symbols.insert(section.local_symbols.end(), plsym,
+				 plsym + sym_size);
+  ++this->reloc_count_;
+}
+
 // Relocate_task methods.
 
 // We may have to wait for the output sections to be written.
@@ -331,6 +431,7 @@ Sized_relobj<size, big_endian>::do_read_relocs(Read_relocs_data* rd)
 					   true, true);
       sr.sh_type = sh_type;
       sr.reloc_count = reloc_count;
+      this->add_reloc_count(reloc_count);
       sr.output_section = os;
       sr.needs_special_offset_handling = out_offsets[shndx] == invalid_address;
       sr.is_data_section_allocated = is_section_allocated;
@@ -470,6 +571,29 @@ Sized_relobj<size, big_endian>::do_scan_relocs(const General_options& options,
     }
 }
 
+// Pass the relocs recorded while scanning this object to the target.
+
+template<int size, bool big_endian>
+void
+Sized_relobj<size, big_endian>::do_scan_deferred_relocs(
+    const General_options& options,
+    Symbol_table* symtab,
+    Layout* layout,
+    const Deferred_relocs* deferred)
+{
+  Sized_target<size, big_endian>* target =
+    parameters->sized_target<size, big_endian>();
+
+  for (Deferred_relocs::Sections::const_iterator p =
+	 deferred->sections().begin();
+       p != deferred->sections().end();
+       ++p)
+    {
+      if (!p->symbols.empty())
+	target->scan_deferred_relocs(options, symtab, layout, this, *p);
+    }
+}
+
 // This is a strategy class we use when scanning for --emit-relocs.
 
 template<int sh_type>
@@ -1500,6 +1624,46 @@ Sized_relobj<64, true>::do_scan_relocs(const General_options& options,
 				       Read_relocs_data* rd);
 #endif
 
+#ifdef HAVE_TARGET_32_LITTLE
+template
+void
+Sized_relobj<32, false>::do_scan_deferred_relocs(
+    const General_options& options,
+    Symbol_table* symtab,
+    Layout* layout,
+    const Deferred_relocs* deferred);
+#endif
+
+#ifdef HAVE_TARGET_32_BIG
+template
+void
+Sized_relobj<32, true>::do_scan_deferred_relocs(
+    const General_options& options,
+    Symbol_table* symtab,
+    Layout* layout,
+    const Deferred_relocs* deferred);
+#endif
+
+#ifdef HAVE_TARGET_64_LITTLE
+template
+void
+Sized_relobj<64, false>::do_scan_deferred_relocs(
+    const General_options& options,
+    Symbol_table* symtab,
+    Layout* layout,
+    const Deferred_relocs* deferred);
+#endif
+
+#ifdef HAVE_TARGET_64_BIG
+template
+void
+Sized_relobj<64, true>::do_scan_deferred_relocs(
+    const General_options& options,
+    Symbol_table* symtab,
+    Layout* layout,
+    const Deferred_relocs* deferred);
+#endif
+
 #ifdef HAVE_TARGET_32_LITTLE
 template
 void
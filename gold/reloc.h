@@ -23,6 +23,7 @@
 #ifndef GOLD_RELOC_H
 #define GOLD_RELOC_H
 
+#include <list>
 #include <vector>
 #ifdef HAVE_BYTESWAP_H
 #include <byteswap.h>
@@ -35,6 +36,7 @@ namespace gold
 {
 
 class General_options;
+class Input_objects;
 class Object;
 class Relobj;
 class Read_relocs_data;
@@ -163,6 +165,9 @@ class Scan_relocs : public Task
   get_name() const;
 
  private:
+  bool
+  needs_symtab_lock() const;
+
   const General_options& options_;
   Symbol_table* symtab_;
   Layout* layout_;
@@ -172,6 +177,51 @@ class Scan_relocs : public Task
   Task_token* blocker_;
 };
 
+// When the target defers reloc scanning, this task runs after all the
+// Scan_relocs tasks.  It passes the relocs recorded by each object to
+// the target, one object at a time in input order.
+
+class Scan_deferred_relocs : public Task
+{
+ public:
+  // SCAN_BLOCKER is unblocked when all the Scan_relocs tasks have
+  // completed.  SYMTAB_LOCK is used to lock the symbol table.
+  // BLOCKER should be unblocked when the task completes.
+  Scan_deferred_relocs(const General_options& options,
+		       const Input_objects* input_objects,
+		       Symbol_table* symtab, Layout* layout,
+		       Task_token* scan_blocker, Task_token* symtab_lock,
+		       Task_token* blocker)
+    : options_(options), input_objects_(input_objects), symtab_(symtab),
+      layout_(layout), scan_blocker_(scan_blocker),
+      symtab_lock_(symtab_lock), blocker_(blocker)
+  { }
+
+  // The standard Task methods.
+
+  Task_token*
+  is_runnable();
+
+  void
+  locks(Task_locker*);
+
+  void
+  run(Workqueue*);
+
+  std::string
+  get_name() const
+  { return "Scan_deferred_relocs"; }
+
+ private:
+  const General_options& options_;
+  const Input_objects* input_objects_;
+  Symbol_table* symtab_;
+  Layout* layout_;
+  Task_token* scan_blocker_;
+  Task_token* symtab_lock_;
+  Task_token* blocker_;
+};
+
 // A class to perform all the relocations for an object file.
 
 class Relocate_task : public Task
@@ -309,6 +359,112 @@ class Relocatable_relocs
   Output_data* posd_;
 };
 
+// The relocs of one input reloc section recorded in a Deferred_relocs
+// object.
+
+struct Deferred_reloc_section
+{
+  Deferred_reloc_section(unsigned int a_data_shndx, unsigned int a_sh_type,
+			 Output_section* an_output_section)
+    : data_shndx(a_data_shndx), sh_type(a_sh_type),
+      output_section(an_output_section), relocs(), symbols(),
+      local_symbols()
+  { }
+
+  // The index of the section to which the relocs apply.
+  unsigned int data_shndx;
+  // The type of the reloc section, SHT_REL or SHT_RELA.
+  unsigned int sh_type;
+  // The output section.
+  Output_section* output_section;
+  // The recorded relocs, copied from the input file.
+  std::vector<unsigned char> relocs;
+  // For each recorded reloc, the global symbol it refers to, with
+  // forwarding resolved, or NULL if it refers to a local symbol.
+  std::vector<Symbol*> symbols;
+  // For each recorded reloc against a local symbol, the local symbol
+  // table entry, copied from the input file.
+  std::vector<unsigned char> local_symbols;
+};
+
+// When the target defers reloc scanning (see
+// Target::defer_reloc_scan), the relocs of each object are scanned
+// without locking the symbol table, so that the objects can be
+// scanned in parallel.  That scan does not change anything; it only
+// records here the relocs which may require the target to create a
+// GOT or PLT entry, a COPY reloc or a dynamic reloc.  Once all the
+// objects have been scanned, the Scan_deferred_relocs task passes the
+// recorded relocs to the target one object at a time in input order,
+// so those entries are created in the same order however the
+// scanning tasks were scheduled.
+
+class Deferred_relocs
+{
+ public:
+  // How a reloc should be recorded.  This is decided by the target.
+  enum Scan_kind
+  {
+    // The reloc never requires any work from the target.
+    SCAN_NONE,
+    // The work depends only on the symbol and the reloc type, so only
+    // the first such reloc in the object needs to be recorded.
+    SCAN_ONCE,
+    // The reloc must be recorded.
+    SCAN_EACH
+  };
+
+  typedef std::list<Deferred_reloc_section> Sections;
+
+  Deferred_relocs()
+    : sections_(), once_(), reloc_count_(0)
+  { }
+
+  // Start recording the relocs for an input reloc section.
+  void
+  start_section(unsigned int data_shndx, unsigned int sh_type,
+		Output_section* output_section);
+
+  // Record a reloc for the current section.  PRELOC points to the
+  // reloc, which is RELOC_SIZE bytes.  If GSYM is NULL the reloc is
+  // against the local symbol R_SYM, whose entry of SYM_SIZE bytes is
+  // at PLSYM.  R_TYPE is the reloc type.
+  void
+  add(Scan_kind kind, const unsigned char* preloc, int reloc_size,
+      unsigned int r_type, Symbol* gsym, unsigned int r_sym,
+      const unsigned char* plsym, int sym_size);
+
+  // Return the recorded sections.
+  const Sections&
+  sections() const
+  { return this->sections_; }
+
+  // Return the number of recorded relocs.
+  size_t
+  reloc_count() const
+  { return this->reloc_count_; }
+
+ private:
+  // The key used to find duplicate SCAN_ONCE relocs: the global
+  // symbol, or NULL and the local symbol index, and the reloc type.
+  typedef std::pair<const Symbol*, uint64_t> Once_key;
+
+  struct Once_key_hash
+  {
+    size_t
+    operator()(const Once_key& k) const
+    { return reinterpret_cast<uintptr_t>(k.first) ^ k.second; }
+  };
+
+  typedef Unordered_set<Once_key, Once_key_hash> Once_set;
+
+  // The recorded relocs.
+  Sections sections_;
+  // The SCAN_ONCE relocs which have been recorded.
+  Once_set once_;
+  // The number of recorded relocs.
+  size_t reloc_count_;
+};
+
 // Standard relocation routines which are used on many targets.  Here
 // SIZE and BIG_ENDIAN refer to the target, not the relocation type.
 
@@ -49,7 +49,7 @@ Symbol::override_version(const char* version)
       // override NAME/VERSION as well.  They are already the same
       // Symbol structure.  Setting the VERSION_ field to NULL ensures
       // that it will be output with the correct, empty, version.
-      this->version_ = version;
+      this->set_version(version);
     }
   else
     {
@@ -58,8 +58,8 @@ Symbol::override_version(const char* version)
       // overriding NAME.  If VERSION_ONE and VERSION_TWO are
       // different, then this can only happen when VERSION_ONE is NULL
       // and VERSION_TWO is not hidden.
-      gold_assert(this->version_ == version || this->version_ == NULL);
-      this->version_ = version;
+      gold_assert(this->version() == version || this->version() == NULL);
+      this->set_version(version);
     }
 }
 
@@ -821,7 +821,7 @@ Symbol::override_base_with_special(const Symbol* from)
       break;
     }
 
-  this->override_version(from->version_);
+  this->override_version(from->version());
   this->type_ = from->type_;
   this->binding_ = from->binding_;
   this->override_visibility(from->visibility_);
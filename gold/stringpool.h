@@ -254,6 +254,11 @@ class Stringpool_template
   void
   print_stats(const char*) const;
 
+  // Return the number of distinct strings in the pool.
+  size_t
+  string_count() const
+  { return this->string_set_.size(); }
+
  private:
   Stringpool_template(const Stringpool_template&);
   Stringpool_template& operator=(const Stringpool_template&);
@@ -25,6 +25,7 @@
 #include <cstring>
 #include <stdint.h>
 #include <algorithm>
+#include <new>
 #include <set>
 #include <string>
 #include <utility>
@@ -46,6 +47,8 @@ namespace gold
 
 // Class Symbol.
 
+size_t Symbol::extra_count;
+
 // Initialize fields in Symbol.  This initializes everything except u_
 // and source_.
 
@@ -55,11 +58,10 @@ Symbol::init_fields(const char* name, const char* version,
 		    elfcpp::STV visibility, unsigned char nonvis)
 {
   this->name_ = name;
-  this->version_ = version;
+  this->extra_ = NULL;
+  this->set_version(version);
   this->symtab_index_ = 0;
   this->dynsym_index_ = 0;
-  this->got_offsets_.init();
-  this->plt_offset_ = 0;
   this->type_ = type;
   this->binding_ = binding;
   this->visibility_ = visibility;
@@ -487,7 +489,9 @@ Symbol::set_output_section(Output_section* os)
 
 Symbol_table::Symbol_table(unsigned int count,
                            const Version_script_info& version_script)
-  : saw_undefined_(0), offset_(0), table_(count), namepool_(),
+  : saw_undefined_(0), offset_(0), table_(count), symbol_chunks_(),
+    symbol_chunk_next_(NULL), symbol_chunk_left_(0), symbol_bytes_(0),
+    namepool_(),
     forwarders_(), commons_(), tls_commons_(), small_commons_(),
     large_commons_(), forced_locals_(), warnings_(),
     version_script_(version_script), gc_(NULL), icf_(NULL)
@@ -497,6 +501,10 @@ Symbol_table::Symbol_table(unsigned int count,
 
 Symbol_table::~Symbol_table()
 {
+  for (std::vector<unsigned char*>::iterator p = this->symbol_chunks_.begin();
+       p != this->symbol_chunks_.end();
+       ++p)
+    delete[] *p;
 }
 
 // The hash function.  The key values are Stringpool keys.
@@ -807,6 +815,31 @@ Symbol_table::define_default_version(Sized_symbol<size>* sym,
     }
 }
 
+// Allocate a new symbol.  Symbols read from input objects live until
+// the link is complete, so rather than calling new for each one we
+// carve them out of large chunks.  This avoids the malloc overhead per
+// symbol, which matters when there are millions of them.
+
+template<int size>
+Sized_symbol<size>*
+Symbol_table::allocate_symbol()
+{
+  const size_t align = 8;
+  const size_t len = (sizeof(Sized_symbol<size>) + align - 1) & ~(align - 1);
+  if (this->symbol_chunk_left_ < len)
+    {
+      const size_t chunk_size = 64 * 1024;
+      this->symbol_chunk_next_ = new unsigned char[chunk_size];
+      this->symbol_chunks_.push_back(this->symbol_chunk_next_);
+      this->symbol_chunk_left_ = chunk_size;
+    }
+  void* p = this->symbol_chunk_next_;
+  this->symbol_chunk_next_ += len;
+  this->symbol_chunk_left_ -= len;
+  this->symbol_bytes_ += len;
+  return new(p) Sized_symbol<size>();
+}
+
 // Add one symbol from OBJECT to the symbol table.  NAME is symbol
 // name and VERSION is the version; both are canonicalized.  DEF is
 // whether this is the default version.  ST_SHNDX is the symbol's
@@ -947,7 +980,7 @@ Symbol_table::add_from_object(Object* object,
 	  Sized_target<size, big_endian>* target =
 	    parameters->sized_target<size, big_endian>();
 	  if (!target->has_make_symbol())
-	    ret = new Sized_symbol<size>();
+	    ret = this->allocate_symbol<size>();
 	  else
 	    {
 	      ret = target->make_symbol();
@@ -2936,6 +2969,8 @@ Symbol_table::print_stats() const
   fprintf(stderr, _("%s: symbol table entries: %zu\n"),
 	  program_name, this->table_.size());
 #endif
+  fprintf(stderr, _("%s: symbol memory: %zu bytes; with extra fields: %zu\n"),
+	  program_name, this->symbol_bytes_, Symbol::get_extra_count());
   this->namepool_.print_stats("symbol table stringpool");
 }
 
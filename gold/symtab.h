@@ -117,7 +117,7 @@ class Symbol
   // unversioned symbol.
   const char*
   version() const
-  { return this->version_; }
+  { return this->extra_ == NULL ? NULL : this->extra_->version; }
 
   // Return whether this version is the default for this symbol name
   // (eg, "foo@@V2" is a default version; "foo@V1" is not).  Only
@@ -125,7 +125,7 @@ class Symbol
   bool
   is_default() const
   {
-    gold_assert(this->version_ != NULL);
+    gold_assert(this->version() != NULL);
     return this->is_def_;
   }
 
@@ -354,13 +354,17 @@ class Symbol
   // For a TLS symbol, this GOT entry will hold its tp-relative offset.
   bool
   has_got_offset(unsigned int got_type) const
-  { return this->got_offsets_.get_offset(got_type) != -1U; }
+  {
+    return (this->extra_ != NULL
+	    && this->extra_->got_offsets.get_offset(got_type) != -1U);
+  }
 
   // Return the offset into the GOT section of this symbol.
   unsigned int
   got_offset(unsigned int got_type) const
   {
-    unsigned int got_offset = this->got_offsets_.get_offset(got_type);
+    gold_assert(this->extra_ != NULL);
+    unsigned int got_offset = this->extra_->got_offsets.get_offset(got_type);
     gold_assert(got_offset != -1U);
     return got_offset;
   }
@@ -368,7 +372,7 @@ class Symbol
   // Set the GOT offset of this symbol.
   void
   set_got_offset(unsigned int got_type, unsigned int got_offset)
-  { this->got_offsets_.set_offset(got_type, got_offset); }
+  { this->extra()->got_offsets.set_offset(got_type, got_offset); }
 
   // Return whether this symbol has an entry in the PLT section.
   bool
@@ -380,7 +384,7 @@ class Symbol
   plt_offset() const
   {
     gold_assert(this->has_plt_offset());
-    return this->plt_offset_;
+    return this->extra_->plt_offset;
   }
 
   // Set the PLT offset of this symbol.
@@ -388,7 +392,7 @@ class Symbol
   set_plt_offset(unsigned int plt_offset)
   {
     this->has_plt_offset_ = true;
-    this->plt_offset_ = plt_offset;
+    this->extra()->plt_offset = plt_offset;
   }
 
   // Return whether this dynamic symbol needs a special value in the
@@ -737,6 +741,12 @@ class Symbol
 	    && this->type() != elfcpp::STT_FUNC);
   }
 
+  // Return the number of symbols which have needed the rarely used
+  // fields, for statistics.
+  static size_t
+  get_extra_count()
+  { return Symbol::extra_count; }
+
  protected:
   // Instances of this class should always be created at a specific
   // size.
@@ -807,11 +817,58 @@ class Symbol
   Symbol(const Symbol&);
   Symbol& operator=(const Symbol&);
 
+  // Fields which most symbols never need.  They are kept out of line
+  // so that the common case of an unversioned symbol with no GOT or
+  // PLT entry stays small.
+  struct Extra
+  {
+    Extra()
+      : version(NULL), got_offsets(), plt_offset(0)
+    { }
+
+    // Symbol version (expected to point into a Stringpool).  This
+    // may be NULL.
+    const char* version;
+    // If this symbol has an entry in the GOT section, this holds the
+    // offset from the start of the GOT section.  A symbol may have
+    // more than one GOT offset (e.g., when mixing modules compiled
+    // with two different TLS models), but will usually have at most
+    // one.
+    Got_offset_list got_offsets;
+    // If this symbol has an entry in the PLT section (has_plt_offset_
+    // is true), then this is the offset from the start of the PLT
+    // section.
+    unsigned int plt_offset;
+  };
+
+  // Return the extra fields, allocating them if necessary.
+  Extra*
+  extra()
+  {
+    if (this->extra_ == NULL)
+      {
+	this->extra_ = new Extra();
+	++Symbol::extra_count;
+      }
+    return this->extra_;
+  }
+
+  // Set the symbol version.
+  void
+  set_version(const char* version)
+  {
+    if (version != NULL || this->extra_ != NULL)
+      this->extra()->version = version;
+  }
+
+  // The number of symbols which have allocated extra fields, for
+  // statistics.
+  static size_t extra_count;
+
   // Symbol name (expected to point into a Stringpool).
   const char* name_;
-  // Symbol version (expected to point into a Stringpool).  This may
-  // be NULL.
-  const char* version_;
+  // The rarely used fields, or NULL if none of them have been set.
+  Extra* extra_;
 
   union
   {
@@ -860,18 +917,6 @@ class Symbol
   // non-zero value during Layout::finalize.
   unsigned int dynsym_index_;
 
-  // If this symbol has an entry in the GOT section (has_got_offset_
-  // is true), this holds the offset from the start of the GOT section.
-  // A symbol may have more than one GOT offset (e.g., when mixing
-  // modules compiled with two different TLS models), but will usually
-  // have at most one.
-  Got_offset_list got_offsets_;
-
-  // If this symbol has an entry in the PLT section (has_plt_offset_
-  // is true), then this is the offset from the start of the PLT
-  // section.
-  unsigned int plt_offset_;
-
   // Symbol type (bits 0 to 3).
   elfcpp::STT type_ : 4;
   // Symbol binding (bits 4 to 7).
@@ -1411,6 +1456,17 @@ class Symbol_table
   void
   print_stats() const;
 
+  // Return the number of entries in the symbol table.
+  size_t
+  symbol_count() const
+  { return this->table_.size(); }
+
+  // Return the number of bytes used for symbols read from input
+  // objects.
+  size_t
+  symbol_bytes() const
+  { return this->symbol_bytes_; }
+
   // Return the version script information.
   const Version_script_info&
   version_script() const
@@ -1446,6 +1502,11 @@ class Symbol_table
   void
   make_forwarder(Symbol* from, Symbol* to);
 
+  // Allocate a new symbol for add_from_object.
+  template<int size>
+  Sized_symbol<size>*
+  allocate_symbol();
+
   // Add a symbol.
   template<int size, bool big_endian>
   Sized_symbol<size>*
@@ -1681,6 +1742,14 @@ class Symbol_table
   unsigned int dynamic_count_;
   // The symbol hash table.
   Symbol_table_type table_;
+  // Chunks of memory from which allocate_symbol allocates symbols.
+  std::vector<unsigned char*> symbol_chunks_;
+  // The next free byte in the last chunk.
+  unsigned char* symbol_chunk_next_;
+  // The number of bytes left in the last chunk.
+  size_t symbol_chunk_left_;
+  // The total number of bytes allocated for symbols.
+  size_t symbol_bytes_;
   // A pool of symbol names.  This is used for all global symbols.
   // Entries in the hash table point into this pool.
   Stringpool namepool_;
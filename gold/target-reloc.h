@@ -120,6 +120,126 @@ scan_relocs(
     }
 }
 
+// This function implements the first pass of deferred reloc scanning,
+// described at Target::defer_reloc_scan.  It filters the relocs the
+// same way as scan_relocs, and then uses the local_scan_kind and
+// global_scan_kind functions of Scan to decide which relocs must be
+// recorded in DEFERRED.  Those functions must not change anything, as
+// this is run without a lock on the symbol table.
+
+template<int size, bool big_endian, int sh_type, typename Scan>
+inline void
+record_deferred_relocs(
+    Symbol_table* symtab,
+    Sized_relobj<size, big_endian>* object,
+    unsigned int data_shndx,
+    const unsigned char* prelocs,
+    size_t reloc_count,
+    Output_section* output_section,
+    bool needs_special_offset_handling,
+    size_t local_count,
+    const unsigned char* plocal_syms,
+    Deferred_relocs* deferred)
+{
+  typedef typename Reloc_types<sh_type, size, big_endian>::Reloc Reltype;
+  const int reloc_size = Reloc_types<sh_type, size, big_endian>::reloc_size;
+  const int sym_size = elfcpp::Elf_sizes<size>::sym_size;
+  Scan scan;
+
+  deferred->start_section(data_shndx, sh_type, output_section);
+
+  for (size_t i = 0; i < reloc_count; ++i, prelocs += reloc_size)
+    {
+      Reltype reloc(prelocs);
+
+      if (needs_special_offset_handling
+	  && !output_section->is_input_address_mapped(object, data_shndx,
+						      reloc.get_r_offset()))
+	continue;
+
+      typename elfcpp::Elf_types<size>::Elf_WXword r_info = reloc.get_r_info();
+      unsigned int r_sym = elfcpp::elf_r_sym<size>(r_info);
+      unsigned int r_type = elfcpp::elf_r_type<size>(r_info);
+
+      if (r_sym < local_count)
+	{
+	  gold_assert(plocal_syms != NULL);
+	  const unsigned char* plsym = plocal_syms + r_sym * sym_size;
+	  typename elfcpp::Sym<size, big_endian> lsym(plsym);
+	  unsigned int shndx = lsym.get_st_shndx();
+	  bool is_ordinary;
+	  shndx = object->adjust_sym_shndx(r_sym, shndx, &is_ordinary);
+	  if (is_ordinary
+	      && shndx != elfcpp::SHN_UNDEF
+	      && !object->is_section_included(shndx))
+	    continue;
+
+	  deferred->add(scan.local_scan_kind(r_type), prelocs, reloc_size,
+			r_type, NULL, r_sym, plsym, sym_size);
+	}
+      else
+	{
+	  Symbol* gsym = object->global_symbol(r_sym);
+	  gold_assert(gsym != NULL);
+	  if (gsym->is_forwarder())
+	    gsym = symtab->resolve_forwards(gsym);
+
+	  deferred->add(scan.global_scan_kind(r_type, gsym), prelocs,
+			reloc_size, r_type, gsym, r_sym, NULL, 0);
+	}
+    }
+}
+
+// This function implements the second pass of deferred reloc
+// scanning.  It passes each reloc recorded in SECTION to the local
+// or global function of Scan, as scan_relocs would have done.
+
+template<int size, bool big_endian, typename Target_type, int sh_type,
+	 typename Scan>
+inline void
+scan_deferred_relocs(
+    const General_options& options,
+    Symbol_table* symtab,
+    Layout* layout,
+    Target_type* target,
+    Sized_relobj<size, big_endian>* object,
+    const Deferred_reloc_section& section)
+{
+  typedef typename Reloc_types<sh_type, size, big_endian>::Reloc Reltype;
+  const int reloc_size = Reloc_types<sh_type, size, big_endian>::reloc_size;
+  const int sym_size = elfcpp::Elf_sizes<size>::sym_size;
+  Scan scan;
+
+  const size_t reloc_count = section.symbols.size();
+  gold_assert(section.sh_type == sh_type
+	      && section.relocs.size() == reloc_count * reloc_size);
+
+  const unsigned char* prelocs = &section.relocs[0];
+  const unsigned char* plsym = (section.local_symbols.empty()
+				? NULL
+				: &section.local_symbols[0]);
+  for (size_t i = 0; i < reloc_count; ++i, prelocs += reloc_size)
+    {
+      Reltype reloc(prelocs);
+      unsigned int r_type = elfcpp::elf_r_type<size>(reloc.get_r_info());
+      Symbol* gsym = section.symbols[i];
+
+      if (gsym == NULL)
+	{
+	  gold_assert(plsym != NULL);
+	  typename elfcpp::Sym<size, big_endian> lsym(plsym);
+	  plsym += sym_size;
+	  scan.local(options, symtab, layout, target, object,
+		     section.data_shndx, section.output_section, reloc,
+		     r_type, lsym);
+	}
+      else
+	scan.global(options, symtab, layout, target, object,
+		    section.data_shndx, section.output_section, reloc,
+		    r_type, gsym);
+    }
+}
+
 // Behavior for relocations to discarded comdat sections.
 
 enum Comdat_behavior
@@ -445,7 +565,7 @@ scan_relocatable_relocs(
 		{
 		  strategy = scan.local_section_strategy(r_type, object);
 		  if (strategy != Relocatable_relocs::RELOC_DISCARD)
-                    object->output_section(shndx)->set_needs_symtab_index();
+		    object->set_output_section_needs_symtab_index(shndx);
 		}
 	    }
 	}
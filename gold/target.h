@@ -47,6 +47,7 @@ class Relobj;
 template<int size, bool big_endian>
 class Sized_relobj;
 class Relocatable_relocs;
+struct Deferred_reloc_section;
 template<int size, bool big_endian>
 class Relocate_info;
 class Reloc_symbol_changes;
@@ -248,6 +249,20 @@ class Target
 		      elfcpp::Elf_Xword flags)
   { return this->do_make_output_section(name, type, flags); }
 
+  // Return whether reloc scanning is done in two passes.  In the
+  // first pass, the relocs of each object are scanned without locking
+  // the symbol table, and scan_relocs only records the relocs which
+  // may need GOT or PLT entries, COPY relocs or dynamic relocs in a
+  // Deferred_relocs structure.  The second pass hands those relocs to
+  // scan_deferred_relocs, one object at a time in input order.  This
+  // only pays off when there are threads to scan objects in parallel.
+  bool
+  defer_reloc_scan() const
+  {
+    return (parameters->options().threads()
+	    && this->do_can_defer_reloc_scan());
+  }
+
   // Return true if target wants to perform relaxation.
   bool
   may_relax() const
@@ -398,6 +413,11 @@ class Target
   do_make_output_section(const char* name, elfcpp::Elf_Word type,
 			 elfcpp::Elf_Xword flags);
 
+  // Virtual function which may be overridden by the child class.
+  virtual bool
+  do_can_defer_reloc_scan() const
+  { return false; }
+
   // Virtual function which may be overriden by the child class.
   virtual bool
   do_may_relax() const
@@ -506,6 +526,18 @@ class Sized_target : public Target
 	      size_t local_symbol_count,
 	      const unsigned char* plocal_symbols) = 0;
 
+  // Scan relocs which scan_relocs recorded for OBJECT in a
+  // Deferred_relocs structure.  SECTION holds the relocs recorded for
+  // one input reloc section.  This is only called if the target
+  // returns true from do_can_defer_reloc_scan.
+  virtual void
+  scan_deferred_relocs(const General_options&,
+		       Symbol_table*,
+		       Layout*,
+		       Sized_relobj<size, big_endian>*,
+		       const Deferred_reloc_section&)
+  { gold_unreachable(); }
+
   // Relocate section data.  SH_TYPE is the type of the relocation
   // section, SHT_REL or SHT_RELA.  PRELOCS points to the relocation
   // information.  RELOC_COUNT is the number of relocs.
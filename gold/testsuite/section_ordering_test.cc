@@ -0,0 +1,44 @@
+// section_ordering_test.cc -- a test case for gold
+
+// Copyright 2010 Free Software Foundation, Inc.
+
+// This file is part of gold.
+
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+// MA 02110-1301, USA.
+
+// The goal of this program is to verify that --section-ordering-file
+// places the listed function sections first, in the listed order,
+// ahead of the sections which are not listed.
+
+int cold_func()
+{
+  return 0;
+}
+
+int hot_func_2()
+{
+  return 2;
+}
+
+int hot_func_1()
+{
+  return 1;
+}
+
+int main()
+{
+  return cold_func() + hot_func_1() + hot_func_2() - 3;
+}
@@ -0,0 +1,41 @@
+#!/bin/sh
+
+# section_ordering_test.sh -- test --section-ordering-file
+
+# Copyright 2010 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# The goal of this program is to verify that the functions named in
+# the section ordering file are laid out in the given order, and
+# ahead of the functions which are not named there.
+
+check()
+{
+    func_addr_1=`grep "$2" $1 | awk '{print $1}'`
+    func_addr_2=`grep "$3" $1 | awk '{print $1}'`
+    if [ $func_addr_1 \> $func_addr_2 ]
+    then
+        echo "Section ordering failed: $2 is not before $3"
+	exit 1
+    fi
+}
+
+check section_ordering_test.stdout "hot_func_1" "hot_func_2"
+check section_ordering_test.stdout "hot_func_2" " main$"
+check section_ordering_test.stdout " main$" "cold_func"
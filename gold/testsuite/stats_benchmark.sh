@@ -0,0 +1,185 @@
+#!/bin/sh
+
+# stats_benchmark.sh -- benchmark gold on synthesized link workloads
+
+# Copyright 2010 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# This script generates large link workloads, links each of them with
+# --stats=json, and writes one line of JSON per workload to the
+# results file.  If a baseline results file is given, the wall time
+# and peak RSS of each workload are compared against it and the
+# script fails if either grew by more than the allowed percentage.
+# This is not run by "make check"; use "make stats-benchmark".
+#
+# The workloads are:
+#   objects  many object files, one function per section
+#   archive  the same objects pulled in from one large archive
+#   debug    the same objects compiled with -g, which makes the
+#            link dominated by debug sections and merged strings
+#
+# The generated code calls no library functions, so the links do not
+# need a C library and work for any native configuration.
+
+usage()
+{
+    echo "usage: $0 [-n OBJECTS] [-f FUNCTIONS] [-b BASELINE] [-t PERCENT]" 1>&2
+    echo "          [-o RESULTS] LD CC AR" 1>&2
+    exit 1
+}
+
+objects=200
+functions=200
+baseline=
+threshold=10
+results=stats_benchmark.json
+
+while getopts n:f:b:t:o: opt; do
+    case $opt in
+    n) objects=$OPTARG ;;
+    f) functions=$OPTARG ;;
+    b) baseline=$OPTARG ;;
+    t) threshold=$OPTARG ;;
+    o) results=$OPTARG ;;
+    *) usage ;;
+    esac
+done
+shift `expr $OPTIND - 1`
+if [ $# -ne 3 ]; then
+    usage
+fi
+LD=$1
+CC=$2
+AR=$3
+
+dir=stats_benchmark.d
+rm -rf $dir
+mkdir $dir || exit 1
+
+# Generate the sources.  Each function calls a function in the next
+# file, so that every object and every archive member is needed, and
+# every function carries a string constant for the merge code.
+i=0
+while [ $i -lt $objects ]; do
+    next=`expr \( $i + 1 \) % $objects`
+    awk -v i=$i -v next_file=$next -v n=$functions 'BEGIN {
+	printf "extern int f_%d_0 (int);\n", next_file;
+	printf "static const char *s_%d = \"string %d\";\n", i, i;
+	for (j = 0; j < n; j++)
+	    printf "int f_%d_%d (int);\n", i, j;
+	for (j = 0; j < n; j++) {
+	    printf "const char *str_%d_%d (void) { return \"shared string %d\"; }\n", i, j, j;
+	    printf "int f_%d_%d (int x) {\n", i, j;
+	    if (j + 1 < n)
+		printf "  return x > 0 ? f_%d_%d (x - 1) + s_%d[0] : 0;\n", i, j + 1, i;
+	    else
+		printf "  return x > 0 ? f_%d_0 (x - 1) : 0;\n", next_file;
+	    printf "}\n";
+	}
+    }' > $dir/obj$i.c
+    i=`expr $i + 1`
+done
+cat > $dir/main.c <<MAIN_EOF
+extern int f_0_0 (int);
+int main (void) { return f_0_0 (1); }
+MAIN_EOF
+
+compile()
+{
+    flags=$1
+    suffix=$2
+    i=0
+    while [ $i -lt $objects ]; do
+	$CC $flags -ffunction-sections -fdata-sections -c \
+	    -o $dir/obj$i$suffix.o $dir/obj$i.c || exit 1
+	i=`expr $i + 1`
+    done
+    $CC $flags -c -o $dir/main$suffix.o $dir/main.c || exit 1
+}
+
+object_list()
+{
+    suffix=$1
+    i=0
+    while [ $i -lt $objects ]; do
+	echo $dir/obj$i$suffix.o
+	i=`expr $i + 1`
+    done
+}
+
+run_link()
+{
+    name=$1
+    shift
+    if ! $LD -e main -o $dir/$name.out --stats=json "$@" 2> $dir/$name.err; then
+	cat $dir/$name.err 1>&2
+	exit 1
+    fi
+    json=`grep '^{' $dir/$name.err`
+    echo "{\"workload\": \"$name\", \"objects\": $objects, \"functions\": $functions, \"stats\": $json}" >> $results
+}
+
+compile "-O0" ""
+compile "-O0 -g" "_g"
+
+rm -f $dir/lib.a
+$AR rc $dir/lib.a `object_list ""` || exit 1
+
+rm -f $results
+run_link objects $dir/main.o `object_list ""`
+run_link archive $dir/main.o $dir/lib.a
+run_link debug $dir/main_g.o `object_list _g`
+
+cat $results
+
+if [ -z "$baseline" ]; then
+    exit 0
+fi
+
+# Extract a numeric field from a line of the results.
+field()
+{
+    case $2 in
+    wall) echo "$1" | sed -n 's/.*"total": {[^}]*"wall": \([0-9.]*\).*/\1/p' ;;
+    peak_rss) echo "$1" | sed -n 's/.*"peak_rss": \([0-9]*\).*/\1/p' ;;
+    esac
+}
+
+status=0
+while read line; do
+    name=`echo "$line" | sed -n 's/.*"workload": "\([a-z]*\)".*/\1/p'`
+    base=`grep "\"workload\": \"$name\"" $baseline`
+    if [ -z "$base" ]; then
+	echo "$name: not in baseline"
+	continue
+    fi
+    for f in wall peak_rss; do
+	new=`field "$line" $f`
+	old=`field "$base" $f`
+	if awk -v new=$new -v old=$old -v t=$threshold \
+		'BEGIN { exit !(old > 0 && new > old * (1 + t / 100)) }'; then
+	    echo "$name: $f regressed from $old to $new"
+	    status=1
+	else
+	    echo "$name: $f $old -> $new"
+	fi
+    done
+done < $results
+
+exit $status
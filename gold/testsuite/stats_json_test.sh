@@ -0,0 +1,60 @@
+#!/bin/sh
+
+# stats_json_test.sh -- test --stats=json
+
+# Copyright 2010 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# The goal of this program is to verify that --stats=json prints a
+# single line holding all the expected fields, and that it escapes
+# the program name.
+
+check()
+{
+    if ! grep -q "$2" "$1"
+    then
+	echo "Did not find expected field $2 in $1:"
+	echo ""
+	cat "$1"
+	exit 1
+    fi
+}
+
+lines=`grep -c '^{' stats_json_test.stdout`
+if test "$lines" != "1"; then
+    echo "Expected one line of JSON in stats_json_test.stdout:"
+    cat stats_json_test.stdout
+    exit 1
+fi
+
+for field in phases initial middle final total peak_rss bytes_mapped \
+	     archive_members symbols relocations merged_strings \
+	     output_file_size; do
+    check stats_json_test.stdout "\"$field\": "
+done
+
+if ! grep -F -q '{"program": "./stats\"json\\ld", ' stats_json_escape_test.stdout
+then
+    echo "Program name not escaped in stats_json_escape_test.stdout:"
+    echo ""
+    cat stats_json_escape_test.stdout
+    exit 1
+fi
+
+exit 0
@@ -0,0 +1,36 @@
+#!/bin/sh
+
+# thread_reloc_scan_test.sh -- test that scanning relocs with threads
+# gives the same output as scanning them without threads.
+
+# Copyright 2010 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# When gold is built with thread support, --threads lets the target
+# scan the relocs of each object in parallel and create the GOT, PLT
+# and dynamic relocs afterward in input order.  The shared library
+# linked that way must be identical to the one linked without
+# --threads.
+
+if ! cmp -s thread_reloc_scan_test_1.so thread_reloc_scan_test_2.so; then
+    echo "thread_reloc_scan_test_1.so and thread_reloc_scan_test_2.so differ"
+    exit 1
+fi
+
+exit 0
@@ -0,0 +1,178 @@
+// timer.cc -- helper class for time accounting
+
+// Copyright 2010 Free Software Foundation, Inc.
+
+// This file is part of gold.
+
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+// MA 02110-1301, USA.
+
+#include "gold.h"
+
+#if defined(HAVE_GETRUSAGE) || defined(HAVE_GETTIMEOFDAY)
+#include <sys/time.h>
+#endif
+
+#ifdef HAVE_GETRUSAGE
+#include <sys/resource.h>
+#endif
+
+#include "libiberty.h"
+
+#include "timer.h"
+
+namespace gold
+{
+
+// Class Timer.
+
+Timer::Timer()
+{
+  this->start_time_.wall = 0;
+  this->start_time_.user = 0;
+  this->start_time_.sys = 0;
+  for (int i = 0; i < NUM_PASSES; ++i)
+    {
+      this->pass_times_[i] = this->start_time_;
+      this->pass_done_[i] = false;
+    }
+}
+
+// Start counting the time.
+
+void
+Timer::start()
+{
+  this->get_time(&this->start_time_);
+}
+
+// Record the current time in *NOW.
+
+void
+Timer::get_time(TimeStats* now)
+{
+#ifdef HAVE_GETRUSAGE
+  struct rusage ru;
+  getrusage(RUSAGE_SELF, &ru);
+  now->user = ru.ru_utime.tv_sec * 1000000L + ru.ru_utime.tv_usec;
+  now->sys = ru.ru_stime.tv_sec * 1000000L + ru.ru_stime.tv_usec;
+#else
+  now->user = get_run_time();
+  now->sys = 0;
+#endif
+
+#ifdef HAVE_GETTIMEOFDAY
+  // Count seconds from the first call, so that the value fits in a
+  // long on hosts where that is 32 bits.
+  static time_t base_sec = 0;
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  if (base_sec == 0)
+    base_sec = tv.tv_sec;
+  now->wall = (tv.tv_sec - base_sec) * 1000000L + tv.tv_usec;
+#else
+  now->wall = now->user + now->sys;
+#endif
+}
+
+// Return the time elapsed since the call to start.
+
+Timer::TimeStats
+Timer::get_elapsed_time() const
+{
+  TimeStats now;
+  this->get_time(&now);
+  TimeStats ret;
+  ret.wall = now.wall - this->start_time_.wall;
+  ret.user = now.user - this->start_time_.user;
+  ret.sys = now.sys - this->start_time_.sys;
+  return ret;
+}
+
+// Record that PASS has finished.
+
+void
+Timer::stamp(Pass pass)
+{
+  gold_assert(pass < NUM_PASSES);
+  this->get_time(&this->pass_times_[pass]);
+  this->pass_done_[pass] = true;
+}
+
+// Return the time spent in PASS: the time from the end of the
+// previous pass which ran, or from the start, to the end of PASS.
+
+Timer::TimeStats
+Timer::get_pass_time(Pass pass) const
+{
+  gold_assert(pass < NUM_PASSES);
+  TimeStats ret;
+  ret.wall = 0;
+  ret.user = 0;
+  ret.sys = 0;
+  if (!this->pass_done_[pass])
+    return ret;
+
+  const TimeStats* before = &this->start_time_;
+  for (int i = pass - 1; i >= 0; --i)
+    {
+      if (this->pass_done_[i])
+	{
+	  before = &this->pass_times_[i];
+	  break;
+	}
+    }
+
+  ret.wall = this->pass_times_[pass].wall - before->wall;
+  ret.user = this->pass_times_[pass].user - before->user;
+  ret.sys = this->pass_times_[pass].sys - before->sys;
+  return ret;
+}
+
+// Return the peak resident set size in bytes.
+
+unsigned long long
+Timer::get_peak_rss()
+{
+#ifdef HAVE_GETRUSAGE
+  struct rusage ru;
+  if (getrusage(RUSAGE_SELF, &ru) == 0)
+    {
+      // ru_maxrss is in kilobytes.
+      return static_cast<unsigned long long>(ru.ru_maxrss) * 1024;
+    }
+#endif
+  return 0;
+}
+
+// Return the name of PASS.
+
+const char*
+Timer::pass_name(Pass pass)
+{
+  switch (pass)
+    {
+    case INITIAL_PASS:
+      return "initial";
+    case MIDDLE_PASS:
+      return "middle";
+    case FINAL_PASS:
+      return "final";
+    default:
+      gold_unreachable();
+    }
+}
+
+} // End namespace gold.
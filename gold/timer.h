@@ -0,0 +1,101 @@
+// timer.h -- helper class for time accounting   -*- C++ -*-
+
+// Copyright 2010 Free Software Foundation, Inc.
+
+// This file is part of gold.
+
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+// MA 02110-1301, USA.
+
+#ifndef GOLD_TIMER_H
+#define GOLD_TIMER_H
+
+namespace gold
+{
+
+// A simple timer, used to report the time spent in each phase of the
+// link for --stats.  A link has three passes: the initial tasks,
+// which read the input files and resolve symbols; the middle tasks,
+// which lay out the output file and scan relocations; and the final
+// tasks, which relocate and write the output file.
+
+class Timer
+{
+ public:
+  // The passes which are timed.
+  enum Pass
+  {
+    INITIAL_PASS,
+    MIDDLE_PASS,
+    FINAL_PASS,
+    NUM_PASSES
+  };
+
+  // A time measurement, in microseconds.
+  struct TimeStats
+  {
+    long wall;
+    long user;
+    long sys;
+  };
+
+  Timer();
+
+  // Start counting the time.
+  void
+  start();
+
+  // Return the time elapsed since the call to start.
+  TimeStats
+  get_elapsed_time() const;
+
+  // Record that pass PASS has just finished.
+  void
+  stamp(Pass pass);
+
+  // Return the time spent in pass PASS.  This is zero if the pass
+  // did not run.
+  TimeStats
+  get_pass_time(Pass pass) const;
+
+  // Return the peak resident set size of the process in bytes, or 0
+  // if it is not known.
+  static unsigned long long
+  get_peak_rss();
+
+  // Return the name of pass PASS.
+  static const char*
+  pass_name(Pass pass);
+
+ private:
+  // This class cannot be copied.
+  Timer(const Timer&);
+  Timer& operator=(const Timer&);
+
+  // Return the current time.
+  static void
+  get_time(TimeStats*);
+
+  // The time when start was called.
+  TimeStats start_time_;
+  // The time when each pass finished.
+  TimeStats pass_times_[NUM_PASSES];
+  // Whether each pass has finished.
+  bool pass_done_[NUM_PASSES];
+};
+
+} // End namespace gold.
+
+#endif // !defined(GOLD_TIMER_H)
@@ -72,6 +72,11 @@ class Target_x86_64 : public Target_freebsd<64, false>
   void
   do_new_output_section(Output_section*) const;
 
+  // We can scan relocs in two passes.
+  bool
+  do_can_defer_reloc_scan() const
+  { return true; }
+
   // Scan the relocations to look for symbol adjustments.
   void
   gc_process_relocs(const General_options& options,
@@ -102,6 +107,15 @@ class Target_x86_64 : public Target_freebsd<64, false>
 	      size_t local_symbol_count,
 	      const unsigned char* plocal_symbols);
 
+  // Scan the relocations recorded by scan_relocs when deferring the
+  // scan.
+  void
+  scan_deferred_relocs(const General_options& options,
+		       Symbol_table* symtab,
+		       Layout* layout,
+		       Sized_relobj<64, false>* object,
+		       const Deferred_reloc_section& section);
+
   // Finalize the sections.
   void
   do_finalize_sections(Layout*);
@@ -206,6 +220,14 @@ class Target_x86_64 : public Target_freebsd<64, false>
 	   const elfcpp::Rela<64, false>& reloc, unsigned int r_type,
 	   Symbol* gsym);
 
+    // Return whether local or global would have anything to do for
+    // a reloc, for a deferred scan.
+    inline Deferred_relocs::Scan_kind
+    local_scan_kind(unsigned int r_type);
+
+    inline Deferred_relocs::Scan_kind
+    global_scan_kind(unsigned int r_type, const Symbol* gsym);
+
   private:
     static void
     unsupported_reloc_local(Sized_relobj<64, false>*, unsigned int r_type);
@@ -1611,6 +1633,127 @@ Target_x86_64::gc_process_relocs(const General_options& options,
     plocal_symbols);
  
 }
+// Return how to record a reloc against a local symbol for a deferred
+// scan.  This must agree with Scan::local: anything which is not
+// SCAN_NONE here may need work there.  Relocs which only create a GOT
+// entry or check for TLS support do not depend on where the reloc is,
+// so we only need to see one of them for each symbol.
+
+inline Deferred_relocs::Scan_kind
+Target_x86_64::Scan::local_scan_kind(unsigned int r_type)
+{
+  switch (r_type)
+    {
+    case elfcpp::R_X86_64_NONE:
+    case elfcpp::R_386_GNU_VTINHERIT:
+    case elfcpp::R_386_GNU_VTENTRY:
+    case elfcpp::R_X86_64_PC64:
+    case elfcpp::R_X86_64_PC32:
+    case elfcpp::R_X86_64_PC16:
+    case elfcpp::R_X86_64_PC8:
+    case elfcpp::R_X86_64_PLT32:
+    case elfcpp::R_X86_64_TLSDESC_CALL:
+    case elfcpp::R_X86_64_DTPOFF32:
+    case elfcpp::R_X86_64_DTPOFF64:
+      return Deferred_relocs::SCAN_NONE;
+
+    case elfcpp::R_X86_64_64:
+    case elfcpp::R_X86_64_32:
+    case elfcpp::R_X86_64_32S:
+    case elfcpp::R_X86_64_16:
+    case elfcpp::R_X86_64_8:
+      if (parameters->options().output_is_position_independent())
+	return Deferred_relocs::SCAN_EACH;
+      return Deferred_relocs::SCAN_NONE;
+
+    case elfcpp::R_X86_64_GOTPC32:
+    case elfcpp::R_X86_64_GOTOFF64:
+    case elfcpp::R_X86_64_GOTPC64:
+    case elfcpp::R_X86_64_PLTOFF64:
+    case elfcpp::R_X86_64_GOT64:
+    case elfcpp::R_X86_64_GOT32:
+    case elfcpp::R_X86_64_GOTPCREL64:
+    case elfcpp::R_X86_64_GOTPCREL:
+    case elfcpp::R_X86_64_GOTPLT64:
+    case elfcpp::R_X86_64_TLSGD:
+    case elfcpp::R_X86_64_GOTPC32_TLSDESC:
+    case elfcpp::R_X86_64_TLSLD:
+    case elfcpp::R_X86_64_GOTTPOFF:
+      return Deferred_relocs::SCAN_ONCE;
+
+    default:
+      return Deferred_relocs::SCAN_EACH;
+    }
+}
+
+// Return how to record a reloc against a global symbol for a deferred
+// scan.  This is called before any GOT or PLT entries or COPY relocs
+// are created.  Creating them only ever makes a symbol need fewer
+// dynamic relocs, so if a reloc needs nothing now it will need
+// nothing in Scan::global either.
+
+inline Deferred_relocs::Scan_kind
+Target_x86_64::Scan::global_scan_kind(unsigned int r_type,
+				      const Symbol* gsym)
+{
+  switch (r_type)
+    {
+    case elfcpp::R_X86_64_NONE:
+    case elfcpp::R_386_GNU_VTINHERIT:
+    case elfcpp::R_386_GNU_VTENTRY:
+    case elfcpp::R_X86_64_TLSDESC_CALL:
+    case elfcpp::R_X86_64_DTPOFF32:
+    case elfcpp::R_X86_64_DTPOFF64:
+      return Deferred_relocs::SCAN_NONE;
+
+    case elfcpp::R_X86_64_64:
+    case elfcpp::R_X86_64_32:
+    case elfcpp::R_X86_64_32S:
+    case elfcpp::R_X86_64_16:
+    case elfcpp::R_X86_64_8:
+      if (gsym->needs_plt_entry()
+	  || gsym->needs_dynamic_reloc(Symbol::ABSOLUTE_REF))
+	return Deferred_relocs::SCAN_EACH;
+      return Deferred_relocs::SCAN_NONE;
+
+    case elfcpp::R_X86_64_PC64:
+    case elfcpp::R_X86_64_PC32:
+    case elfcpp::R_X86_64_PC16:
+    case elfcpp::R_X86_64_PC8:
+      {
+	int flags = Symbol::NON_PIC_REF;
+	if (gsym->type() == elfcpp::STT_FUNC)
+	  flags |= Symbol::FUNCTION_CALL;
+	if (gsym->needs_plt_entry() || gsym->needs_dynamic_reloc(flags))
+	  return Deferred_relocs::SCAN_EACH;
+	return Deferred_relocs::SCAN_NONE;
+      }
+
+    case elfcpp::R_X86_64_PLT32:
+      if (gsym->final_value_is_known())
+	return Deferred_relocs::SCAN_NONE;
+      return Deferred_relocs::SCAN_ONCE;
+
+    case elfcpp::R_X86_64_GOT64:
+    case elfcpp::R_X86_64_GOT32:
+    case elfcpp::R_X86_64_GOTPCREL64:
+    case elfcpp::R_X86_64_GOTPCREL:
+    case elfcpp::R_X86_64_GOTPLT64:
+    case elfcpp::R_X86_64_GOTPC32:
+    case elfcpp::R_X86_64_GOTOFF64:
+    case elfcpp::R_X86_64_GOTPC64:
+    case elfcpp::R_X86_64_PLTOFF64:
+    case elfcpp::R_X86_64_TLSGD:
+    case elfcpp::R_X86_64_GOTPC32_TLSDESC:
+    case elfcpp::R_X86_64_TLSLD:
+    case elfcpp::R_X86_64_GOTTPOFF:
+      return Deferred_relocs::SCAN_ONCE;
+
+    default:
+      return Deferred_relocs::SCAN_EACH;
+    }
+}
+
 // Scan relocations for a section.
 
 void
@@ -1634,6 +1777,23 @@ Target_x86_64::scan_relocs(const General_options& options,
       return;
     }
 
+  if (this->defer_reloc_scan())
+    {
+      gold::record_deferred_relocs<64, false, elfcpp::SHT_RELA,
+				   Target_x86_64::Scan>(
+	symtab,
+	object,
+	data_shndx,
+	prelocs,
+	reloc_count,
+	output_section,
+	needs_special_offset_handling,
+	local_symbol_count,
+	plocal_symbols,
+	object->deferred_relocs());
+      return;
+    }
+
   gold::scan_relocs<64, false, Target_x86_64, elfcpp::SHT_RELA,
       Target_x86_64::Scan>(
     options,
@@ -1650,6 +1810,25 @@ Target_x86_64::scan_relocs(const General_options& options,
     plocal_symbols);
 }
 
+// Scan the relocations recorded by scan_relocs for a deferred scan.
+
+void
+Target_x86_64::scan_deferred_relocs(const General_options& options,
+				    Symbol_table* symtab,
+				    Layout* layout,
+				    Sized_relobj<64, false>* object,
+				    const Deferred_reloc_section& section)
+{
+  gold::scan_deferred_relocs<64, false, Target_x86_64, elfcpp::SHT_RELA,
+			     Target_x86_64::Scan>(
+    options,
+    symtab,
+    layout,
+    this,
+    object,
+    section);
+}
+
 // Finalize the sections.
 
 void
@@ -456,6 +456,10 @@ struct bfd_link_info
   /* How many spare .dynamic DT_NULL entries should be added?  */
   unsigned int spare_dynamic_tags;
 
+  /* Number of threads BFD may use to relocate input files, or 0 or 1
+     to do everything in the calling thread.  */
+  unsigned int threads;
+
   /* May be used to set DT_FLAGS for ELF. */
   bfd_vma flags;
 
@@ -24,6 +24,7 @@
 #
 fragment <<EOF
 #include "ldctor.h"
+#include "ldwrite.h"
 #include "elf32-spu.h"
 
 static void spu_place_special_section (asection *, asection *, const char *);
@@ -37,7 +38,7 @@ static struct spu_elf_params params =
   &spu_elf_load_ovl_mgr,
   &spu_elf_open_overlay_script,
   &spu_elf_relink,
-  0, ovly_normal, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, ovly_normal, 0, 0, 0, 0, 0, 0, 0, 0, 0,
   0, 0x3ffff,
   1, 0, 16, 0, 0, 2000
 };
@@ -105,6 +106,7 @@ spu_after_open (void)
       if ((params.auto_overlay & AUTO_OVERLAY) == 0)
 	params.auto_overlay = 0;
       params.emit_stub_syms |= link_info.emitrelocations;
+      params.stats = config.stats;
       spu_elf_setup (&link_info, &params);
 
       if (link_info.relocatable)
@@ -383,10 +385,35 @@ spu_elf_open_overlay_script (void)
   return script;
 }
 
+/* Redo the link using the overlay script written by --auto-overlay.
+   Input files are already open and symbols resolved, so normally we
+   just redo section placement and stub sizing in this process.  Links
+   with PHDRS or split output sections are instead relinked by running
+   the linker again with the script.  */
+
 static void
 spu_elf_relink (void)
 {
-  char **argv = xmalloc ((my_argc + 4) * sizeof (*argv));
+  char **argv;
+
+  if (lang_phdr_list == NULL
+      && config.split_by_reloc == (unsigned) -1
+      && config.split_by_file == (bfd_size_type) -1)
+    {
+      /* Same as --no-auto-overlay.  */
+      params.auto_overlay = 0;
+
+      /* Throw away the program headers from the first layout.  */
+      elf_tdata (link_info.output_bfd)->segment_map = NULL;
+      elf_tdata (link_info.output_bfd)->program_header_size
+	= (bfd_size_type) -1;
+
+      lang_relink (auto_overlay_file);
+      ldwrite_build_link_orders ();
+      return;
+    }
+
+  argv = xmalloc ((my_argc + 4) * sizeof (*argv));
 
   memcpy (argv, my_argv, my_argc * sizeof (*argv));
   argv[my_argc++] = "--no-auto-overlay";
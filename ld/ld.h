@@ -74,6 +74,10 @@
    discarded.  */
 #define DISCARD_SECTION_NAME "/DISCARD/"
 
+/* The largest count accepted by --thread-count, as for the --threads
+   option of the binutils.  */
+#define MAX_THREAD_COUNT 1024
+
 /* A file name list */
 typedef struct name_list {
   const char *name;
@@ -6385,6 +6385,165 @@ lang_process (void)
   lang_end ();
 }
 
+/* Remove the input section statements, and any padding between
+   them, from LIST and its sublists.  The input sections are left
+   unattached so that map_input_to_output_sections can place them
+   again.  */
+
+static void
+lang_unmap_input_sections (lang_statement_list_type *list)
+{
+  lang_statement_union_type **p = &list->head;
+  lang_statement_union_type *s;
+
+  while ((s = *p) != NULL)
+    {
+      switch (s->header.type)
+	{
+	case lang_input_section_enum:
+	  s->input_section.section->output_section = NULL;
+	  s->input_section.section->output_offset = 0;
+	  *p = s->header.next;
+	  continue;
+
+	case lang_padding_statement_enum:
+	  *p = s->header.next;
+	  continue;
+
+	case lang_wild_statement_enum:
+	  lang_unmap_input_sections (&s->wild_statement.children);
+	  break;
+
+	case lang_output_section_statement_enum:
+	  lang_unmap_input_sections (&s->output_section_statement.children);
+	  break;
+
+	case lang_group_statement_enum:
+	  lang_unmap_input_sections (&s->group_statement.children);
+	  break;
+
+	default:
+	  break;
+	}
+      p = &s->header.next;
+    }
+  list->tail = p;
+}
+
+/* Redo section placement and sizing with the extra linker script
+   SCRIPT, which is treated as if it had been given with -T before
+   any other script.  Input files stay open and symbols stay resolved;
+   only the mapping of input sections to output sections is thrown
+   away.  This is for emulations that write a script late in the link
+   and want the link redone with it, such as SPU --auto-relink.  If
+   the final link has already started, the caller must rebuild the
+   link orders.  */
+
+void
+lang_relink (const char *script)
+{
+  lang_statement_union_type **stmt_tail;
+  lang_statement_union_type **os_tail = lang_output_section_statement.tail;
+  lang_statement_union_type *abs_stmt = lang_output_section_statement.head;
+  lang_output_section_statement_type *os;
+
+  /* Forget where input sections went.  */
+  lang_unmap_input_sections (&statement_list);
+  stmt_tail = statement_list.tail;
+  /* Put back output sections removed by strip_excluded_output_sections,
+     since they may get input sections this time.  Those still empty
+     are removed again.  */
+  for (os = &lang_output_section_statement.head->output_section_statement;
+       os != NULL;
+       os = os->next)
+    {
+      asection *sec = os->bfd_section;
+
+      if (sec == NULL || bfd_is_abs_section (sec))
+	continue;
+
+      if (bfd_section_removed_from_list (link_info.output_bfd, sec))
+	{
+	  asection *prev = output_prev_sec_find (os);
+
+	  if (prev != NULL)
+	    bfd_section_list_insert_after (link_info.output_bfd, prev, sec);
+	  else
+	    bfd_section_list_prepend (link_info.output_bfd, sec);
+	  link_info.output_bfd->section_count++;
+	  sec->flags &= ~SEC_EXCLUDE;
+	  os->ignored = FALSE;
+	}
+      sec->map_head.s = NULL;
+      sec->map_tail.s = NULL;
+      sec->linker_has_input = 0;
+      sec->size = 0;
+      sec->rawsize = 0;
+    }
+  stripped_excluded_sections = FALSE;
+
+  /* Read the script.  */
+  push_stat_ptr (&statement_list);
+  ldfile_open_command_file (script);
+  parser_input = input_script;
+  yyparse ();
+  pop_stat_ptr ();
+
+  /* Move the new statements to the front of the statement list, just
+     after the abs section statement, and likewise for the list of
+     output section statements.  process_insert_statements expects
+     them there.  */
+  if (*stmt_tail != NULL && stmt_tail != &abs_stmt->header.next)
+    {
+      lang_statement_union_type *first = *stmt_tail;
+
+      *statement_list.tail = abs_stmt->header.next;
+      abs_stmt->header.next = first;
+      *stmt_tail = NULL;
+      statement_list.tail = stmt_tail;
+    }
+  if (*os_tail != NULL)
+    {
+      lang_output_section_statement_type *abs_os, *first_os, *last_os;
+
+      abs_os = &abs_stmt->output_section_statement;
+      first_os = &(*os_tail)->output_section_statement;
+      last_os = ((lang_output_section_statement_type *)
+		 ((char *) lang_output_section_statement.tail
+		  - offsetof (lang_output_section_statement_type, next)));
+      if (first_os->prev != abs_os)
+	{
+	  *os_tail = NULL;
+	  lang_output_section_statement.tail = os_tail;
+	  last_os->next = abs_os->next;
+	  abs_os->next->prev = last_os;
+	  abs_os->next = first_os;
+	  first_os->prev = abs_os;
+	}
+    }
+
+  /* The rest follows lang_process, skipping the steps that only need
+     doing once, like garbage collection, common allocation and
+     section merging.  */
+  update_wild_statements (statement_list.head);
+  map_input_to_output_sections (statement_list.head, NULL, NULL);
+  process_insert_statements ();
+  lang_place_orphans ();
+
+  ldemul_before_allocation ();
+  lang_record_phdrs ();
+  if (link_info.relro && ! link_info.relocatable)
+    lang_find_relro_sections ();
+  lang_size_sections (NULL, !command_line.relax);
+  ldemul_after_allocation ();
+  lang_set_startof ();
+  lang_do_assignments ();
+  ldemul_finish ();
+  if (command_line.check_section_addresses)
+    lang_check_section_addresses ();
+  lang_end ();
+}
+
 /* EXPORTED TO YACC */
 
 void
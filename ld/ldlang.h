@@ -490,6 +490,8 @@ extern void lang_relax_sections
   (bfd_boolean);
 extern void lang_process
   (void);
+extern void lang_relink
+  (const char *);
 extern void lang_section_start
   (const char *, union etree_union *, const segment_type *);
 extern void lang_add_entry
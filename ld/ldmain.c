@@ -550,6 +550,27 @@ main (int argc, char **argv)
       fprintf (stderr, _("%s: data size %ld\n"), program_name,
 	       (long) (lim - (char *) &environ));
 #endif
+      {
+	struct bfd_cache_stats cstats;
+
+	bfd_cache_get_stats (&cstats);
+	fprintf (stderr, _("%s: file cache: %d open at most, %lu hits, "
+			   "%lu misses, %lu evictions\n"),
+		 program_name, cstats.max_open, cstats.hits, cstats.misses,
+		 cstats.evictions);
+	fprintf (stderr, _("%s: file cache: %lu files mapped, "
+			   "%lu mapped reads\n"),
+		 program_name, cstats.mapped_files, cstats.mapped_reads);
+      }
+      {
+	struct bfd_format_stats fstats;
+
+	bfd_format_get_stats (&fstats);
+	fprintf (stderr, _("%s: format checks: %lu searches, %lu targets "
+			   "probed, %lu skipped, %lu cache hits\n"),
+		 program_name, fstats.searches, fstats.probes, fstats.skipped,
+		 fstats.cache_hits);
+      }
     }
 
   /* Prevent remove_output from doing anything, after a successful link.  */
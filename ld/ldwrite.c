@@ -552,6 +552,16 @@ split_sections (bfd *abfd, struct bfd_link_info *info)
   sanity_check (abfd);
 }
 
+/* Build the link orders for all output sections.  This is normally
+   done by ldwrite, but an emulation that redoes the layout after the
+   final link has started (see lang_relink) needs to do it again.  */
+
+void
+ldwrite_build_link_orders (void)
+{
+  lang_for_each_statement (build_link_order);
+}
+
 /* Call BFD to write out the linked file.  */
 
 void
@@ -560,7 +570,7 @@ ldwrite (void)
   /* Reset error indicator, which can typically something like invalid
      format from opening up the .o files.  */
   bfd_set_error (bfd_error_no_error);
-  lang_for_each_statement (build_link_order);
+  ldwrite_build_link_orders ();
 
   if (config.split_by_reloc != (unsigned) -1
       || config.split_by_file != (bfd_size_type) -1)
@@ -19,3 +19,4 @@
    MA 02110-1301, USA.  */
 
 extern void ldwrite (void);
+extern void ldwrite_build_link_orders (void);
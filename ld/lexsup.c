@@ -166,7 +166,10 @@ enum option_values
   OPTION_WARN_SHARED_TEXTREL,
   OPTION_WARN_ALTERNATE_EM,
   OPTION_REDUCE_MEMORY_OVERHEADS,
-  OPTION_DEFAULT_SCRIPT
+  OPTION_DEFAULT_SCRIPT,
+  OPTION_THREADS,
+  OPTION_NO_THREADS,
+  OPTION_THREAD_COUNT
 };
 
 /* The long options.  This structure is used for both the option
@@ -466,6 +469,15 @@ static const struct ld_option ld_options[] =
      OPTION_REDUCE_MEMORY_OVERHEADS},
     '\0', NULL, N_("Reduce memory overheads, possibly taking much longer"),
     TWO_DASHES },
+  { {"threads", no_argument, NULL, OPTION_THREADS},
+    '\0', NULL, N_("Relocate input files on one thread per processor"),
+    TWO_DASHES },
+  { {"no-threads", no_argument, NULL, OPTION_NO_THREADS},
+    '\0', NULL, N_("Relocate input files on one thread (default)"),
+    TWO_DASHES },
+  { {"thread-count", required_argument, NULL, OPTION_THREAD_COUNT},
+    '\0', N_("COUNT"), N_("Relocate input files on COUNT threads"),
+    TWO_DASHES },
   { {"relax", no_argument, NULL, OPTION_RELAX},
     '\0', NULL, N_("Relax branches on certain targets"), TWO_DASHES },
   { {"retain-symbols-file", required_argument, NULL,
@@ -1469,6 +1481,41 @@ parse_args (unsigned argc, char **argv)
 	    config.hash_table_size = 1021;
 	  break;
 
+	case OPTION_THREADS:
+	  if (link_info.threads <= 1)
+	    {
+	      link_info.threads = 2;
+#ifdef _SC_NPROCESSORS_ONLN
+	      {
+		long ncpu = sysconf (_SC_NPROCESSORS_ONLN);
+
+		if (ncpu > MAX_THREAD_COUNT)
+		  link_info.threads = MAX_THREAD_COUNT;
+		else if (ncpu > 0)
+		  link_info.threads = ncpu;
+	      }
+#endif
+	    }
+	  break;
+
+	case OPTION_NO_THREADS:
+	  link_info.threads = 0;
+	  break;
+
+	case OPTION_THREAD_COUNT:
+	  {
+	    char *end;
+	    unsigned long count = strtoul (optarg, &end, 0);
+
+	    if (*optarg == '\0' || *end != '\0' || count == 0)
+	      einfo (_("%P%F: invalid number `%s'\n"), optarg);
+	    if (*optarg == '-' || count > MAX_THREAD_COUNT)
+	      einfo (_("%P%F: thread count `%s' is out of range (1 to %d)\n"),
+		     optarg, MAX_THREAD_COUNT);
+	    link_info.threads = count;
+	  }
+	  break;
+
         case OPTION_HASH_SIZE:
 	  {
 	    bfd_size_type new_size;
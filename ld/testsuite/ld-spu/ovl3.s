@@ -0,0 +1,95 @@
+ .text
+ .p2align 2
+ .globl _start
+_start:
+ brsl lr,f0
+ brsl lr,f3
+ stop
+
+ .section .text.f0,"ax",@progbits
+ .p2align 2
+ .global f0
+ .type f0,@function
+f0:
+ stqd lr,16(sp)
+ stqd sp,-32(sp)
+ ai sp,sp,-32
+ brsl lr,f1
+ .space 1024
+ lqd lr,48(sp)
+ ai sp,sp,32
+ bi lr
+ .size f0,.-f0
+
+ .section .text.f1,"ax",@progbits
+ .p2align 2
+ .global f1
+ .type f1,@function
+f1:
+ stqd lr,16(sp)
+ stqd sp,-32(sp)
+ ai sp,sp,-32
+ brsl lr,f2
+ .space 1024
+ lqd lr,48(sp)
+ ai sp,sp,32
+ bi lr
+ .size f1,.-f1
+
+ .section .text.f2,"ax",@progbits
+ .p2align 2
+ .global f2
+ .type f2,@function
+f2:
+ stqd lr,16(sp)
+ stqd sp,-32(sp)
+ ai sp,sp,-32
+ .space 1024
+ lqd lr,48(sp)
+ ai sp,sp,32
+ bi lr
+ .size f2,.-f2
+
+ .section .text.f3,"ax",@progbits
+ .p2align 2
+ .global f3
+ .type f3,@function
+f3:
+ stqd lr,16(sp)
+ stqd sp,-32(sp)
+ ai sp,sp,-32
+ brsl lr,f4
+ .space 1024
+ lqd lr,48(sp)
+ ai sp,sp,32
+ bi lr
+ .size f3,.-f3
+
+ .section .text.f4,"ax",@progbits
+ .p2align 2
+ .global f4
+ .type f4,@function
+f4:
+ stqd lr,16(sp)
+ stqd sp,-32(sp)
+ ai sp,sp,-32
+ brsl lr,f5
+ .space 1024
+ lqd lr,48(sp)
+ ai sp,sp,32
+ bi lr
+ .size f4,.-f4
+
+ .section .text.f5,"ax",@progbits
+ .p2align 2
+ .global f5
+ .type f5,@function
+f5:
+ stqd lr,16(sp)
+ stqd sp,-32(sp)
+ ai sp,sp,-32
+ .space 1024
+ lqd lr,48(sp)
+ ai sp,sp,32
+ bi lr
+ .size f5,.-f5
@@ -0,0 +1,24 @@
+ .text
+ .p2align 2
+ .globl _start
+_start:
+ brsl lr,f2
+ brsl lr,f3
+ ila 3,lfoo
+ ila 4,gfoo
+ lqr 5,d3
+ br _start
+
+ .section .text.foo,"axG",@progbits,foo,comdat
+ .p2align 2
+lfoo:
+ .long 0,1,2,3
+ .global gfoo
+gfoo:
+ .long 5
+
+ .data
+ .p2align 4
+ .global d1
+d1:
+ .long f2, f3, d3
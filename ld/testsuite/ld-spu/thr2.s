@@ -0,0 +1,29 @@
+ .text
+ .p2align 2
+ .global f2
+ .type f2,@function
+f2:
+ ila 4,gfoo
+ brsl lr,f3
+ ilhu 5,d1@h
+ iohl 5,d1@l
+ bi lr
+ .size f2,.-f2
+
+ .section .text.foo,"axG",@progbits,foo,comdat
+ .p2align 2
+lfoo:
+ .long 0,1,2,3
+ .global gfoo
+gfoo:
+ .long 5
+
+ .data
+ .p2align 4
+d2:
+ .long gfoo, f2
+
+# This copy of the foo group is discarded.  The reference to
+# lfoo is made to point at the kept copy in thr1.o.
+ .section .debug_info,"",@progbits
+ .long lfoo, f2
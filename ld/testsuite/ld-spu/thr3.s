@@ -0,0 +1,16 @@
+ .text
+ .p2align 2
+ .global f3
+ .type f3,@function
+f3:
+ lqr 3,d3
+ ila 4,d1
+ brsl lr,f2
+ bi lr
+ .size f3,.-f3
+
+ .data
+ .p2align 4
+ .global d3
+d3:
+ .long f3, d1, _start, 0